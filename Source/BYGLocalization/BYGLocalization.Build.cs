@@ -23,5 +23,11 @@ public class BYGLocalization : ModuleRules
 				"Engine"
 			}
 			);
+
+		// Keeps the list of localization files up to date in the editor
+		if (Target.bBuildEditor)
+		{
+			PrivateDependencyModuleNames.Add("DirectoryWatcher");
+		}
 	}
 }
@@ -0,0 +1,361 @@
+// Copyright 2017-2021 Brace Yourself Games. All Rights Reserved.
+
+#include "BYGCsvReader.h"
+#include "BYGLocalizationCoreMinimal.h"
+
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+
+// SSE2 is part of x64 so is always available there. AVX2 is only used if the whole module is already being compiled
+// for it, as Unreal doesn't build with per-function target attributes
+#if PLATFORM_CPU_X86_FAMILY && PLATFORM_ENABLE_VECTORINTRINSICS
+	#include <emmintrin.h>
+	#define BYG_CSV_SSE2 1
+	#if defined( __AVX2__ )
+		#include <immintrin.h>
+		#define BYG_CSV_AVX2 1
+	#endif
+#elif PLATFORM_CPU_ARM_FAMILY && PLATFORM_ENABLE_VECTORINTRINSICS_NEON
+	#include <arm_neon.h>
+	#define BYG_CSV_NEON 1
+#endif
+
+#ifndef BYG_CSV_SSE2
+	#define BYG_CSV_SSE2 0
+#endif
+#ifndef BYG_CSV_AVX2
+	#define BYG_CSV_AVX2 0
+#endif
+#ifndef BYG_CSV_NEON
+	#define BYG_CSV_NEON 0
+#endif
+
+static const UTF8CHAR UTF8BOM[] = { 0xEF, 0xBB, 0xBF };
+
+FString FBYGCsvRow::GetString( int32 Column ) const
+{
+	const FUtf8StringView Cell = ( *this )[ Column ];
+	if ( Cell.IsEmpty() )
+		return FString();
+
+	FUTF8ToTCHAR Converted( Cell.GetData(), Cell.Len() );
+	return FString( Converted.Length(), Converted.Get() );
+}
+
+FBYGCsvReader::FBYGCsvReader()
+	: bUseVectorScan( HasVectorScan() )
+{
+	RowBuffer.Reserve( 1024 );
+	CellEnds.Reserve( 8 );
+	Cells.Reserve( 8 );
+}
+
+int64 FBYGCsvReader::FindSpecialCharScalar( const UTF8CHAR* Data, int64 Num, bool bInQuotes )
+{
+	if ( bInQuotes )
+	{
+		for ( int64 i = 0; i < Num; ++i )
+		{
+			if ( Data[ i ] == '"' )
+				return i;
+		}
+	}
+	else
+	{
+		for ( int64 i = 0; i < Num; ++i )
+		{
+			const UTF8CHAR Char = Data[ i ];
+			if ( Char == ',' || Char == '\n' || Char == '\r' )
+				return i;
+		}
+	}
+	return Num;
+}
+
+bool FBYGCsvReader::HasVectorScan()
+{
+	return BYG_CSV_SSE2 || BYG_CSV_NEON;
+}
+
+const TCHAR* FBYGCsvReader::GetVectorScanName()
+{
+#if BYG_CSV_AVX2
+	return TEXT( "AVX2" );
+#elif BYG_CSV_SSE2
+	return TEXT( "SSE2" );
+#elif BYG_CSV_NEON
+	return TEXT( "NEON" );
+#else
+	return TEXT( "Scalar" );
+#endif
+}
+
+// Each block is compared against every character we're looking for, and the first match found from the bitmask
+int64 FBYGCsvReader::FindSpecialCharVector( const UTF8CHAR* Data, int64 Num, bool bInQuotes )
+{
+	int64 i = 0;
+
+#if BYG_CSV_AVX2
+	{
+		const __m256i Quote = _mm256_set1_epi8( '"' );
+		const __m256i Comma = _mm256_set1_epi8( ',' );
+		const __m256i CR = _mm256_set1_epi8( '\r' );
+		const __m256i LF = _mm256_set1_epi8( '\n' );
+		for ( ; i + 32 <= Num; i += 32 )
+		{
+			const __m256i Block = _mm256_loadu_si256( (const __m256i*)( Data + i ) );
+			const __m256i Match = bInQuotes
+				? _mm256_cmpeq_epi8( Block, Quote )
+				: _mm256_or_si256( _mm256_or_si256( _mm256_cmpeq_epi8( Block, Comma ), _mm256_cmpeq_epi8( Block, CR ) ), _mm256_cmpeq_epi8( Block, LF ) );
+			const uint32 Mask = (uint32)_mm256_movemask_epi8( Match );
+			if ( Mask != 0 )
+				return i + FMath::CountTrailingZeros( Mask );
+		}
+	}
+#endif
+
+#if BYG_CSV_SSE2
+	{
+		const __m128i Quote = _mm_set1_epi8( '"' );
+		const __m128i Comma = _mm_set1_epi8( ',' );
+		const __m128i CR = _mm_set1_epi8( '\r' );
+		const __m128i LF = _mm_set1_epi8( '\n' );
+		for ( ; i + 16 <= Num; i += 16 )
+		{
+			const __m128i Block = _mm_loadu_si128( (const __m128i*)( Data + i ) );
+			const __m128i Match = bInQuotes
+				? _mm_cmpeq_epi8( Block, Quote )
+				: _mm_or_si128( _mm_or_si128( _mm_cmpeq_epi8( Block, Comma ), _mm_cmpeq_epi8( Block, CR ) ), _mm_cmpeq_epi8( Block, LF ) );
+			const uint32 Mask = (uint32)_mm_movemask_epi8( Match );
+			if ( Mask != 0 )
+				return i + FMath::CountTrailingZeros( Mask );
+		}
+	}
+#endif
+
+#if BYG_CSV_NEON
+	{
+		const uint8x16_t Quote = vdupq_n_u8( '"' );
+		const uint8x16_t Comma = vdupq_n_u8( ',' );
+		const uint8x16_t CR = vdupq_n_u8( '\r' );
+		const uint8x16_t LF = vdupq_n_u8( '\n' );
+		for ( ; i + 16 <= Num; i += 16 )
+		{
+			const uint8x16_t Block = vld1q_u8( (const uint8*)( Data + i ) );
+			const uint8x16_t Match = bInQuotes
+				? vceqq_u8( Block, Quote )
+				: vorrq_u8( vorrq_u8( vceqq_u8( Block, Comma ), vceqq_u8( Block, CR ) ), vceqq_u8( Block, LF ) );
+			// NEON has no movemask, narrowing gives 4 bits per byte instead
+			const uint64 Mask = vget_lane_u64( vreinterpret_u64_u8( vshrn_n_u16( vreinterpretq_u16_u8( Match ), 4 ) ), 0 );
+			if ( Mask != 0 )
+				return i + ( FMath::CountTrailingZeros64( Mask ) >> 2 );
+		}
+	}
+#endif
+
+	return i + FindSpecialCharScalar( Data + i, Num - i, bInQuotes );
+}
+
+bool FBYGCsvReader::ReadFile( const FString& Filename, FRowCallback Callback )
+{
+	QUICK_SCOPE_CYCLE_COUNTER( STAT_BYGLocalization_CsvReadFile );
+
+	TUniquePtr<FArchive> Reader( IFileManager::Get().CreateFileReader( *Filename, FILEREAD_Silent ) );
+	if ( !Reader )
+		return false;
+
+	TArray<UTF8CHAR> Chunk;
+	Chunk.SetNumUninitialized( ChunkSize );
+
+	int64 Remaining = Reader->TotalSize();
+	bool bFirstChunk = true;
+	while ( Remaining > 0 && !bStopped )
+	{
+		const int64 ToRead = FMath::Min<int64>( Remaining, ChunkSize );
+		Reader->Serialize( Chunk.GetData(), ToRead );
+		if ( Reader->IsError() )
+			return false;
+		Remaining -= ToRead;
+
+		if ( bFirstChunk && ToRead >= 2
+			&& ( ( Chunk[ 0 ] == 0xFF && Chunk[ 1 ] == 0xFE ) || ( Chunk[ 0 ] == 0xFE && Chunk[ 1 ] == 0xFF ) ) )
+		{
+			// UTF-16, let the engine deal with byte order and convert it once
+			Reader.Reset();
+			FString Contents;
+			if ( !FFileHelper::LoadFileToString( Contents, *Filename ) )
+				return false;
+			FTCHARToUTF8 Converted( *Contents, Contents.Len() );
+			Parse( (const UTF8CHAR*)Converted.Get(), Converted.Length(), Callback );
+			Finish( Callback );
+			return true;
+		}
+		bFirstChunk = false;
+
+		Parse( Chunk.GetData(), ToRead, Callback );
+	}
+
+	Finish( Callback );
+	return true;
+}
+
+void FBYGCsvReader::Parse( const UTF8CHAR* Data, int64 Num, FRowCallback Callback )
+{
+	// The BOM could in theory be split across chunks
+	while ( !bCheckedBOM && Num > 0 )
+	{
+		if ( *Data == UTF8BOM[ NumBOMBytesMatched ] )
+		{
+			++Data;
+			--Num;
+			bCheckedBOM = ++NumBOMBytesMatched == UE_ARRAY_COUNT( UTF8BOM );
+		}
+		else
+		{
+			bCheckedBOM = true;
+			ParseInternal( UTF8BOM, NumBOMBytesMatched, Callback );
+		}
+	}
+
+	ParseInternal( Data, Num, Callback );
+}
+
+void FBYGCsvReader::ParseInternal( const UTF8CHAR* Data, int64 Num, FRowCallback Callback )
+{
+	const UTF8CHAR* At = Data;
+	const UTF8CHAR* End = Data + Num;
+
+	while ( At < End && !bStopped )
+	{
+		switch ( State )
+		{
+		case EState::AfterCR:
+			State = EState::CellStart;
+			if ( *At == '\n' )
+			{
+				++At;
+			}
+			break;
+
+		case EState::QuoteInQuoted:
+			if ( *At == '"' )
+			{
+				Append( At, 1 );
+				++At;
+				State = EState::Quoted;
+				break;
+			}
+			// That was the closing quote. Like FCsvParser, anything between it and the next delimiter is kept
+			State = EState::Unquoted;
+			break;
+
+		case EState::Quoted:
+		{
+			const int64 Run = FindSpecialChar( At, End - At, true );
+			Append( At, Run );
+			At += Run;
+			if ( At < End )
+			{
+				++At;
+				State = EState::QuoteInQuoted;
+			}
+			break;
+		}
+
+		case EState::CellStart:
+			if ( *At == '"' )
+			{
+				++At;
+				bRowHasContent = true;
+				State = EState::Quoted;
+				break;
+			}
+			State = EState::Unquoted;
+			[[fallthrough]];
+
+		case EState::Unquoted:
+		{
+			const int64 Run = FindSpecialChar( At, End - At, false );
+			if ( Run > 0 )
+			{
+				Append( At, Run );
+				bRowHasContent = true;
+				At += Run;
+			}
+			if ( At == End )
+				break;
+
+			const UTF8CHAR Delimiter = *At++;
+			if ( Delimiter == ',' )
+			{
+				EndCell();
+				State = EState::CellStart;
+			}
+			else
+			{
+				EndRow( Callback );
+				State = Delimiter == '\r' ? EState::AfterCR : EState::CellStart;
+			}
+			break;
+		}
+		}
+	}
+}
+
+void FBYGCsvReader::Finish( FRowCallback Callback )
+{
+	if ( !bCheckedBOM )
+	{
+		bCheckedBOM = true;
+		ParseInternal( UTF8BOM, NumBOMBytesMatched, Callback );
+	}
+
+	if ( State == EState::Quoted )
+	{
+		bRunawayQuote = true;
+	}
+	if ( !bStopped && State != EState::AfterCR )
+	{
+		EndRow( Callback );
+	}
+	State = EState::CellStart;
+}
+
+void FBYGCsvReader::Append( const UTF8CHAR* Data, int64 Num )
+{
+	if ( Num > 0 && IsKept( CellEnds.Num() ) )
+	{
+		RowBuffer.Append( Data, Num );
+	}
+}
+
+void FBYGCsvReader::EndCell()
+{
+	CellEnds.Add( RowBuffer.Num() );
+}
+
+void FBYGCsvReader::EndRow( FRowCallback Callback )
+{
+	// Blank lines don't count as rows
+	if ( CellEnds.Num() > 0 || bRowHasContent )
+	{
+		EndCell();
+
+		Cells.Reset();
+		int32 CellStart = 0;
+		for ( const int32 CellEnd : CellEnds )
+		{
+			Cells.Add( FUtf8StringView( RowBuffer.GetData() + CellStart, CellEnd - CellStart ) );
+			CellStart = CellEnd;
+		}
+
+		FBYGCsvRow Row;
+		Row.Index = RowIndex++;
+		Row.Cells = Cells;
+		bStopped = !Callback( Row );
+	}
+
+	RowBuffer.Reset();
+	CellEnds.Reset();
+	bRowHasContent = false;
+}
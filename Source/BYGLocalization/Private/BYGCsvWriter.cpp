@@ -0,0 +1,97 @@
+// Copyright 2017-2021 Brace Yourself Games. All Rights Reserved.
+
+#include "BYGCsvWriter.h"
+
+void FBYGCsvWriter::AddCell( FStringView Text, bool bAllowQuotes )
+{
+	if ( bRowStarted )
+	{
+		Output.Add( ',' );
+	}
+	bRowStarted = true;
+
+	const TCHAR* Data = Text.GetData();
+	const int32 Len = Text.Len();
+
+	int32 NumQuotes = 0;
+	bool bNeedsQuotes = false;
+	bool bAscii = true;
+	for ( int32 i = 0; i < Len; ++i )
+	{
+		const TCHAR Char = Data[ i ];
+		NumQuotes += Char == '"' ? 1 : 0;
+		bNeedsQuotes |= Char == ',' || Char == '\r' || Char == '\n';
+		bAscii &= (uint32)Char < 0x80;
+	}
+
+	const bool bQuoted = bAllowQuotes && Len > 0 && ( bForceQuoted || bNeedsQuotes || NumQuotes > 0 );
+	if ( bQuoted )
+	{
+		Output.Add( '"' );
+	}
+
+	if ( bAscii )
+	{
+		const int32 Start = Output.AddUninitialized( Len + NumQuotes );
+		uint8* Out = Output.GetData() + Start;
+		for ( int32 i = 0; i < Len; ++i )
+		{
+			*Out++ = (uint8)Data[ i ];
+			if ( Data[ i ] == '"' )
+			{
+				*Out++ = '"';
+			}
+		}
+	}
+	else
+	{
+		// Split at quotes, which are never part of a surrogate pair, so each run converts the same as the whole would
+		int32 RunStart = 0;
+		for ( int32 i = 0; i < Len; ++i )
+		{
+			if ( Data[ i ] == '"' )
+			{
+				AddUTF8( Data + RunStart, i - RunStart );
+				Output.Add( '"' );
+				Output.Add( '"' );
+				RunStart = i + 1;
+			}
+		}
+		AddUTF8( Data + RunStart, Len - RunStart );
+	}
+
+	if ( bQuoted )
+	{
+		Output.Add( '"' );
+	}
+}
+
+void FBYGCsvWriter::EndRow()
+{
+	AddRaw( LINE_TERMINATOR );
+	bRowStarted = false;
+}
+
+void FBYGCsvWriter::AddRaw( FStringView Text )
+{
+	AddUTF8( Text.GetData(), Text.Len() );
+}
+
+void FBYGCsvWriter::Flush( FArchive& Ar )
+{
+	if ( Output.Num() > 0 )
+	{
+		Ar.Serialize( Output.GetData(), Output.Num() );
+		Output.Reset();
+	}
+}
+
+void FBYGCsvWriter::AddUTF8( const TCHAR* Data, int32 Len )
+{
+	if ( Len <= 0 )
+		return;
+
+	const int32 NumBytes = FPlatformString::ConvertedLength<UTF8CHAR>( Data, Len );
+	const int32 Start = Output.AddUninitialized( NumBytes );
+	FPlatformString::Convert( (UTF8CHAR*)( Output.GetData() + Start ), NumBytes, Data, Len );
+}
@@ -0,0 +1,80 @@
+// Copyright 2017-2021 Brace Yourself Games. All Rights Reserved.
+
+#include "BYGKeyIndex.h"
+#include "BYGLocalization.h"
+#include "BYGLocalizationCoreMinimal.h"
+#include "BYGLocalizationHash.h"
+
+void FBYGKeyIndex::Reset()
+{
+	SlotHashes.Reset();
+	SlotIndices.Reset();
+	SlotMask = 0;
+	NumKeys = 0;
+	EntryHashes.Reset();
+}
+
+void FBYGKeyIndex::Build( TArrayView<const FBYGLocalizationEntry> Entries, TArray<int32>* OutDuplicates )
+{
+	QUICK_SCOPE_CYCLE_COUNTER( STAT_BYGLocalization_BuildKeyIndex );
+
+	Reset();
+
+	// Kept at most half full so probe sequences stay short
+	const uint32 NumSlots = FMath::RoundUpToPowerOfTwo( FMath::Max( 16, Entries.Num() * 2 ) );
+	SlotHashes.SetNumUninitialized( NumSlots );
+	SlotIndices.Init( INDEX_NONE, NumSlots );
+	SlotMask = NumSlots - 1;
+
+	EntryHashes.SetNumUninitialized( Entries.Num() );
+	for ( int32 EntryIndex = 0; EntryIndex < Entries.Num(); ++EntryIndex )
+	{
+		const FString& Key = Entries[ EntryIndex ].Key;
+		const uint64 Hash = FBYGLocalizationHash::HashKey( Key );
+		EntryHashes[ EntryIndex ] = Hash;
+
+		uint32 Slot = (uint32)Hash & SlotMask;
+		while ( true )
+		{
+			const int32 ExistingIndex = SlotIndices[ Slot ];
+			if ( ExistingIndex == INDEX_NONE )
+			{
+				SlotHashes[ Slot ] = Hash;
+				SlotIndices[ Slot ] = EntryIndex;
+				++NumKeys;
+				break;
+			}
+			if ( SlotHashes[ Slot ] == Hash && Entries[ ExistingIndex ].Key.Equals( Key, ESearchCase::IgnoreCase ) )
+			{
+				if ( OutDuplicates )
+				{
+					OutDuplicates->Add( EntryIndex );
+				}
+				break;
+			}
+			Slot = ( Slot + 1 ) & SlotMask;
+		}
+	}
+}
+
+TOptional<int32> FBYGKeyIndex::Find( FStringView Key, TArrayView<const FBYGLocalizationEntry> Entries ) const
+{
+	return FindByHash( FBYGLocalizationHash::HashKey( Key ), Key, Entries );
+}
+
+TOptional<int32> FBYGKeyIndex::FindByHash( uint64 KeyHash, FStringView Key, TArrayView<const FBYGLocalizationEntry> Entries ) const
+{
+	if ( NumKeys == 0 )
+		return TOptional<int32>();
+
+	uint32 Slot = (uint32)KeyHash & SlotMask;
+	while ( true )
+	{
+		const int32 Index = SlotIndices[ Slot ];
+		if ( Index == INDEX_NONE )
+			return TOptional<int32>();
+		if ( SlotHashes[ Slot ] == KeyHash && Entries.IsValidIndex( Index ) && Key.Equals( Entries[ Index ].Key, ESearchCase::IgnoreCase ) )
+			return Index;
+		Slot = ( Slot + 1 ) & SlotMask;
+	}
+}
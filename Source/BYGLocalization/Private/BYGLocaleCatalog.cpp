@@ -0,0 +1,372 @@
+// Copyright 2017-2021 Brace Yourself Games. All Rights Reserved.
+
+#include "BYGLocaleCatalog.h"
+#include "BYGLocalizationCoreMinimal.h"
+#include "BYGLocalizationSettings.h"
+
+#include "Async/ParallelFor.h"
+#include "HAL/PlatformFilemanager.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeExit.h"
+#include "Misc/ScopeLock.h"
+
+#if WITH_EDITOR
+#include "DirectoryWatcherModule.h"
+#include "IDirectoryWatcher.h"
+#endif
+
+namespace BYGLocaleCatalog
+{
+	static FString GetFullPath( const FString& Path )
+	{
+		FString FullPath = FPaths::ConvertRelativePathToFull( Path );
+		FPaths::NormalizeFilename( FullPath );
+		FPaths::RemoveDuplicateSlashes( FullPath );
+		return FullPath;
+	}
+}
+
+FBYGLocaleCatalog::FBYGLocaleCatalog( const UBYGLocalization& InOwner )
+	: Owner( InOwner )
+{
+}
+
+FBYGLocaleCatalog::~FBYGLocaleCatalog()
+{
+#if WITH_EDITOR
+	UnwatchDirectories();
+#endif
+}
+
+TArray<FBYGLocaleInfo> FBYGLocaleCatalog::GetAll() const
+{
+	FScopeLock ScopeLock( &Lock );
+	EnsureScanned();
+	return Locales;
+}
+
+TArray<FBYGLocaleInfo> FBYGLocaleCatalog::GetForLocale( const FString& LocaleCode ) const
+{
+	FScopeLock ScopeLock( &Lock );
+	EnsureScanned();
+
+	TArray<FBYGLocaleInfo> Found;
+	if ( const TArray<int32>* Indices = ByLocale.Find( LocaleCode ) )
+	{
+		Found.Reserve( Indices->Num() );
+		for ( const int32 Index : *Indices )
+		{
+			Found.Add( Locales[ Index ] );
+		}
+	}
+	return Found;
+}
+
+bool FBYGLocaleCatalog::Find( const FString& LocaleCode, const FString& Category, FBYGLocaleInfo& OutInfo ) const
+{
+	FScopeLock ScopeLock( &Lock );
+	EnsureScanned();
+
+	const int32* Index = ByLocaleAndCategory.Find( TPair<FString, FString>( LocaleCode, Category ) );
+	if ( !Index )
+		return false;
+
+	OutInfo = Locales[ *Index ];
+	return true;
+}
+
+void FBYGLocaleCatalog::Invalidate()
+{
+	FScopeLock ScopeLock( &Lock );
+	Clear();
+
+#if WITH_EDITOR
+	// Directories may have changed, they're watched again after the next scan
+	if ( IsInGameThread() )
+	{
+		UnwatchDirectories();
+	}
+#endif
+}
+
+void FBYGLocaleCatalog::AddFile( const FString& FileWithPath )
+{
+	FScopeLock ScopeLock( &Lock );
+	// Not scanned yet means it will be found when it is
+	if ( bScanned && IsLocalizationFile( FileWithPath ) && IsInSearchDirectories( FileWithPath ) )
+	{
+		AddFileInternal( FileWithPath );
+	}
+}
+
+void FBYGLocaleCatalog::EnsureScanned() const
+{
+	if ( !bScanned )
+	{
+		QUICK_SCOPE_CYCLE_COUNTER( STAT_BYGLocalization_ScanLocaleCatalog );
+
+		const UBYGLocalizationSettings* Settings = UBYGLocalizationSettings::Get();
+		const TArray<FString> Directories = GetSearchDirectories();
+
+		TArray<TArray<FString>> FoundPerDirectory;
+		FoundPerDirectory.SetNum( Directories.Num() );
+		ParallelFor( Directories.Num(), [&Directories, &FoundPerDirectory, Settings]( int32 Index )
+		{
+			TArray<FString>& Found = FoundPerDirectory[ Index ];
+			auto Visitor = [&Found]( const TCHAR* InFilenameOrDirectory, const bool bIsDir ) -> bool
+			{
+				// Find all .txt/.csv files in a dir
+				if ( !bIsDir && IsLocalizationFile( InFilenameOrDirectory ) )
+				{
+					Found.Add( InFilenameOrDirectory );
+				}
+				// return true to continue searching
+				return true;
+			};
+
+			IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+			if ( Settings->bIncludeSubdirectories )
+			{
+				PlatformFile.IterateDirectoryRecursively( *Directories[ Index ], Visitor );
+			}
+			else
+			{
+				PlatformFile.IterateDirectory( *Directories[ Index ], Visitor );
+			}
+		}, Directories.Num() < 2 ? EParallelForFlags::ForceSingleThread : EParallelForFlags::Unbalanced );
+
+		// Added in directory order so lookups find the same file as before when two directories have the same locale
+		for ( const TArray<FString>& Found : FoundPerDirectory )
+		{
+			for ( const FString& File : Found )
+			{
+				AddFileInternal( File );
+			}
+		}
+
+		bScanned = true;
+		UE_LOG( LogBYGLocalization, Verbose, TEXT( "Found %d localization files in %d directories" ), Locales.Num(), Directories.Num() );
+	}
+
+#if WITH_EDITOR
+	// The directory watcher can only be used from the game thread
+	if ( !bWatchAttempted && IsInGameThread() )
+	{
+		bWatchAttempted = true;
+		WatchDirectories( GetSearchDirectories() );
+	}
+#endif
+}
+
+void FBYGLocaleCatalog::Clear() const
+{
+	bScanned = false;
+	Locales.Empty();
+	ByFullPath.Empty();
+	ByLocaleAndCategory.Empty();
+	ByLocale.Empty();
+}
+
+void FBYGLocaleCatalog::RebuildIndex() const
+{
+	ByFullPath.Reset();
+	ByLocaleAndCategory.Reset();
+	ByLocale.Reset();
+
+	for ( int32 Index = 0; Index < Locales.Num(); ++Index )
+	{
+		const FBYGLocaleInfo& Info = Locales[ Index ];
+		ByFullPath.Add( BYGLocaleCatalog::GetFullPath( FPaths::Combine( FPaths::ProjectContentDir(), Info.FilePath ) ), Index );
+		if ( !ByLocaleAndCategory.Contains( TPair<FString, FString>( Info.LocaleCode, Info.Category ) ) )
+		{
+			ByLocaleAndCategory.Add( TPair<FString, FString>( Info.LocaleCode, Info.Category ), Index );
+		}
+		ByLocale.FindOrAdd( Info.LocaleCode ).Add( Index );
+	}
+}
+
+bool FBYGLocaleCatalog::AddFileInternal( const FString& FileWithPath ) const
+{
+	const FString FullPath = BYGLocaleCatalog::GetFullPath( FileWithPath );
+	if ( ByFullPath.Contains( FullPath ) )
+		return false;
+
+	FString RelativePath = FullPath;
+	FPaths::MakePathRelativeTo( RelativePath, *BYGLocaleCatalog::GetFullPath( FPaths::ProjectContentDir() ) );
+
+	const int32 Index = Locales.Add( MakeLocaleInfo( RelativePath ) );
+	const FBYGLocaleInfo& Info = Locales[ Index ];
+	ByFullPath.Add( FullPath, Index );
+	if ( !ByLocaleAndCategory.Contains( TPair<FString, FString>( Info.LocaleCode, Info.Category ) ) )
+	{
+		ByLocaleAndCategory.Add( TPair<FString, FString>( Info.LocaleCode, Info.Category ), Index );
+	}
+	ByLocale.FindOrAdd( Info.LocaleCode ).Add( Index );
+	return true;
+}
+
+FBYGLocaleInfo FBYGLocaleCatalog::MakeLocaleInfo( const FString& RelativePath ) const
+{
+	FString Category;
+	FString LocaleCode;
+	Owner.SplitCategoryAndCulture( Owner.RemovePrefixSuffix( RelativePath ), Category, LocaleCode );
+
+	const FText* LocalizedName = LocalizedNames.Find( LocaleCode );
+	if ( !LocalizedName )
+	{
+		LocalizedName = &LocalizedNames.Add( LocaleCode, UBYGLocalization::GetLocalizedLocaleName( LocaleCode ) );
+	}
+
+	return FBYGLocaleInfo {
+		LocaleCode,
+		*LocalizedName,
+		Category,
+		RelativePath
+	};
+}
+
+TArray<FString> FBYGLocaleCatalog::GetSearchDirectories()
+{
+	const UBYGLocalizationSettings* Settings = UBYGLocalizationSettings::Get();
+
+	TArray<FDirectoryPath> Paths = { Settings->PrimaryLocalizationDirectory };
+	for ( const FBYGPath& BYGPath : Settings->AdditionalLocalizationDirectories )
+	{
+		Paths.Add( BYGPath.GetDirectoryPath() );
+	}
+
+	TArray<FString> Directories;
+	for ( const FDirectoryPath& Path : Paths )
+	{
+		// Directory Path will probably be /Game/Something
+		FString LocalizationDirPath = Path.Path.Replace( TEXT( "/Game" ), *FPaths::ProjectContentDir() );
+		FPaths::RemoveDuplicateSlashes( LocalizationDirPath );
+		Directories.AddUnique( LocalizationDirPath );
+	}
+	return Directories;
+}
+
+bool FBYGLocaleCatalog::IsInSearchDirectories( const FString& Filename )
+{
+	const UBYGLocalizationSettings* Settings = UBYGLocalizationSettings::Get();
+	const FString FullPath = BYGLocaleCatalog::GetFullPath( Filename );
+	const FString FileDirectory = FPaths::GetPath( FullPath );
+
+	for ( const FString& Directory : GetSearchDirectories() )
+	{
+		const FString FullDirectory = BYGLocaleCatalog::GetFullPath( Directory );
+		if ( Settings->bIncludeSubdirectories
+			? FPaths::IsUnderDirectory( FullPath, FullDirectory )
+			: FPaths::IsSamePath( FileDirectory, FullDirectory ) )
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+bool FBYGLocaleCatalog::IsLocalizationFile( const FString& Filename )
+{
+	const UBYGLocalizationSettings* Settings = UBYGLocalizationSettings::Get();
+	const FString BaseName = FPaths::GetBaseFilename( Filename );
+	return Settings->GetIsValidExtension( FPaths::GetExtension( Filename ) )
+		&& ( Settings->FilenamePrefix.IsEmpty() || BaseName.StartsWith( Settings->FilenamePrefix ) )
+		&& ( Settings->FilenameSuffix.IsEmpty() || BaseName.EndsWith( Settings->FilenameSuffix ) );
+}
+
+#if WITH_EDITOR
+void FBYGLocaleCatalog::WatchDirectories( const TArray<FString>& Directories ) const
+{
+	FDirectoryWatcherModule& DirectoryWatcherModule = FModuleManager::LoadModuleChecked<FDirectoryWatcherModule>( TEXT( "DirectoryWatcher" ) );
+	IDirectoryWatcher* DirectoryWatcher = DirectoryWatcherModule.Get();
+	if ( !DirectoryWatcher )
+		return;
+
+	const UBYGLocalizationSettings* Settings = UBYGLocalizationSettings::Get();
+	const uint32 Flags = Settings->bIncludeSubdirectories ? 0 : IDirectoryWatcher::WatchOptions::IgnoreChangesInSubtree;
+
+	for ( const FString& Directory : Directories )
+	{
+		const FString FullPath = BYGLocaleCatalog::GetFullPath( Directory );
+		if ( !FPlatformFileManager::Get().GetPlatformFile().DirectoryExists( *FullPath ) )
+			continue;
+
+		FDelegateHandle Handle;
+		if ( DirectoryWatcher->RegisterDirectoryChangedCallback_Handle( FullPath,
+			IDirectoryWatcher::FDirectoryChanged::CreateRaw( this, &FBYGLocaleCatalog::OnDirectoryChanged ), Handle, Flags ) )
+		{
+			WatchedDirectories.Emplace( FullPath, Handle );
+		}
+	}
+}
+
+void FBYGLocaleCatalog::UnwatchDirectories() const
+{
+	// Can be gone already during shutdown
+	if ( FDirectoryWatcherModule* DirectoryWatcherModule = FModuleManager::GetModulePtr<FDirectoryWatcherModule>( TEXT( "DirectoryWatcher" ) ) )
+	{
+		if ( IDirectoryWatcher* DirectoryWatcher = DirectoryWatcherModule->Get() )
+		{
+			for ( const TPair<FString, FDelegateHandle>& Watched : WatchedDirectories )
+			{
+				DirectoryWatcher->UnregisterDirectoryChangedCallback_Handle( Watched.Key, Watched.Value );
+			}
+		}
+	}
+	WatchedDirectories.Empty();
+	bWatchAttempted = false;
+}
+
+void FBYGLocaleCatalog::OnDirectoryChanged( const TArray<FFileChangeData>& Changes ) const
+{
+	// Broadcast once the lock is released, so listeners can look files up
+	TArray<FBYGLocaleInfo> Modified;
+	ON_SCOPE_EXIT
+	{
+		for ( const FBYGLocaleInfo& Info : Modified )
+		{
+			Owner.OnLocalizationFileModified.Broadcast( Info );
+		}
+	};
+
+	FScopeLock ScopeLock( &Lock );
+	if ( !bScanned )
+		return;
+
+	for ( const FFileChangeData& Change : Changes )
+	{
+		switch ( Change.Action )
+		{
+		case FFileChangeData::FCA_Added:
+		case FFileChangeData::FCA_Modified:
+			// Renames can show up as modifications, files already known are only added once
+			if ( IsLocalizationFile( Change.Filename ) )
+			{
+				AddFileInternal( Change.Filename );
+				const int32* Index = ByFullPath.Find( BYGLocaleCatalog::GetFullPath( Change.Filename ) );
+				if ( Index && !Modified.ContainsByPredicate( [&]( const FBYGLocaleInfo& Info ) { return Info.FilePath == Locales[ *Index ].FilePath; } ) )
+				{
+					Modified.Add( Locales[ *Index ] );
+				}
+			}
+			break;
+
+		case FFileChangeData::FCA_Removed:
+			if ( const int32* Index = ByFullPath.Find( BYGLocaleCatalog::GetFullPath( Change.Filename ) ) )
+			{
+				Locales.RemoveAt( *Index );
+				RebuildIndex();
+			}
+			break;
+
+		case FFileChangeData::FCA_RescanRequired:
+			// The watcher lost track, so scan from scratch on the next lookup
+			Clear();
+			return;
+
+		default:
+			break;
+		}
+	}
+}
+#endif
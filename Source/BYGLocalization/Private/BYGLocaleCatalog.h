@@ -0,0 +1,69 @@
+// Copyright 2017-2021 Brace Yourself Games. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BYGLocalization.h"
+#include "HAL/CriticalSection.h"
+
+struct FFileChangeData;
+
+// Every localization file in the localization directories, indexed by locale code and category. The directories are
+// only walked on the first lookup and after Invalidate. In the editor the directory watcher keeps it up to date as
+// files are added or removed, so lookups never have to scan.
+class FBYGLocaleCatalog
+{
+public:
+	FBYGLocaleCatalog( const UBYGLocalization& InOwner );
+	~FBYGLocaleCatalog();
+
+	// In the order they were found, primary directory first
+	TArray<FBYGLocaleInfo> GetAll() const;
+	TArray<FBYGLocaleInfo> GetForLocale( const FString& LocaleCode ) const;
+	bool Find( const FString& LocaleCode, const FString& Category, FBYGLocaleInfo& OutInfo ) const;
+
+	// Throws everything away, the next lookup scans again. For when the settings that decide which files match change
+	void Invalidate();
+
+	// For files the plugin writes itself, so they can be found before the directory watcher gets around to them.
+	// Ignored unless it's in one of the localization directories and named like a localization file
+	void AddFile( const FString& FileWithPath );
+
+protected:
+	// Must be called with Lock held
+	void EnsureScanned() const;
+	void Clear() const;
+	void RebuildIndex() const;
+	bool AddFileInternal( const FString& FileWithPath ) const;
+	FBYGLocaleInfo MakeLocaleInfo( const FString& RelativePath ) const;
+
+	static TArray<FString> GetSearchDirectories();
+	static bool IsLocalizationFile( const FString& Filename );
+	static bool IsInSearchDirectories( const FString& Filename );
+
+#if WITH_EDITOR
+	void WatchDirectories( const TArray<FString>& Directories ) const;
+	void UnwatchDirectories() const;
+	void OnDirectoryChanged( const TArray<FFileChangeData>& Changes ) const;
+#endif
+
+	const UBYGLocalization& Owner;
+
+	// Lookups can come from the stats window and translation updates on other threads
+	mutable FCriticalSection Lock;
+	mutable bool bScanned = false;
+	mutable TArray<FBYGLocaleInfo> Locales;
+	// Native language names, GetCulture is too slow to call for every file
+	mutable TMap<FString, FText> LocalizedNames;
+
+	// Indices into Locales. Full paths are used so paths from the directory watcher match the ones from scanning
+	mutable TMap<FString, int32> ByFullPath;
+	mutable TMap<TPair<FString, FString>, int32> ByLocaleAndCategory;
+	mutable TMap<FString, TArray<int32>> ByLocale;
+
+#if WITH_EDITOR
+	mutable TArray<TPair<FString, FDelegateHandle>> WatchedDirectories;
+	// Set even if no directory could be watched, e.g. none exist yet, so lookups don't keep trying. Cleared by Invalidate
+	mutable bool bWatchAttempted = false;
+#endif
+};
@@ -1,88 +1,59 @@
 // Copyright 2017-2021 Brace Yourself Games. All Rights Reserved.
 
 #include "BYGLocalization.h"
+#include "BYGCsvReader.h"
+#include "BYGCsvWriter.h"
+#include "BYGLocaleCatalog.h"
+#include "BYGLocalizationBlob.h"
 #include "BYGLocalizationCoreMinimal.h"
 #include "BYGLocalizationSettings.h"
+#include "BYGStatusScanner.h"
+#include "BYGTranslationManifest.h"
+#include "BYGTranslationMerge.h"
+#include "BYGUpdateLog.h"
 
 #include "Engine/EngineTypes.h"
+#include "HAL/FileManager.h"
 #include "HAL/PlatformFilemanager.h"
-#include "Internationalization/Regex.h"
 #include "Misc/FileHelper.h"
 #include "Misc/Paths.h"
-#include "Serialization/Csv/CsvParser.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Algo/Count.h"
 
 FBYGLocaleData::FBYGLocaleData( const TArray<FBYGLocalizationEntry>& NewEntries )
+	: EntriesInOrder( NewEntries )
 {
-	QUICK_SCOPE_CYCLE_COUNTER( STAT_BYGLocalization_SetEntriesInOrder );
-
-	EntriesInOrder = NewEntries;
-	KeyToIndex.Empty();
-
-	// Update key to index stuff
-	for ( int32 i = 0; i < EntriesInOrder.Num(); ++i )
-	{
-		// NO DUPLICATE KEYS
-		if ( KeyToIndex.Contains( EntriesInOrder[ i ].Key ) )
-		{
-			UE_LOG( LogBYGLocalization, Warning, TEXT( "Duplicate key found! Line: %d, Key '%s'" ), i, *EntriesInOrder[ i ].Key );
-		}
-		else
-		{
-			KeyToIndex.Add( EntriesInOrder[ i ].Key, i );
-		}
-	}
+	BuildKeyIndex();
 }
 
-TArray<FString> UBYGLocalization::GetAllLocalizationFiles() const
+FBYGLocaleData::FBYGLocaleData( TArray<FBYGLocalizationEntry>&& NewEntries )
+	: EntriesInOrder( MoveTemp( NewEntries ) )
 {
-	const UBYGLocalizationSettings* Settings = UBYGLocalizationSettings::Get();
+	BuildKeyIndex();
+}
 
-	TArray<FString> Files;
+void FBYGLocaleData::BuildKeyIndex()
+{
+	QUICK_SCOPE_CYCLE_COUNTER( STAT_BYGLocalization_SetEntriesInOrder );
 
-	TArray<FDirectoryPath> Paths = { Settings->PrimaryLocalizationDirectory };
-	for ( const FBYGPath& BYGPath : Settings->AdditionalLocalizationDirectories )
+	// Update key to index stuff
+	// NO DUPLICATE KEYS
+	TArray<int32> Duplicates;
+	KeyIndex.Build( EntriesInOrder, &Duplicates );
+	for ( const int32 i : Duplicates )
 	{
-		Paths.Add( BYGPath.GetDirectoryPath() );
+		BYG_UPDATE_LOG( Warning, TEXT( "Duplicate key found! Line: %d, Key '%s'" ), i, *EntriesInOrder[ i ].Key );
 	}
-	
-// 	TArray<FString> Cultures = Settings->LanguageCodesInUse;
-// 	Cultures.AddUnique(Settings->PrimaryLanguageCode);
-// 	FDirectoryPath NewPath;
-// 	for (const FString& Culture : Cultures)
-// 	{
-// 		NewPath.Path = Settings->PrimaryLocalizationDirectory.Path + "/" + Culture;
-// 		Paths.Add(NewPath);
-// 	}
+	bHasDuplicateKeys = Duplicates.Num() > 0;
+}
 
-	for ( const FDirectoryPath& Path : Paths )
-	{
-		IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
-		FString LocalizationDirPath = Path.Path.Replace( TEXT( "/Game" ), *FPaths::ProjectContentDir() );
-		// Directory Path will probably be /Game/Something
-		FPaths::RemoveDuplicateSlashes( LocalizationDirPath );
-		bool bFound = false;
-		PlatformFile.IterateDirectoryRecursively( *LocalizationDirPath, [&bFound, &PlatformFile, &Files, &Settings]( const TCHAR* InFilenameOrDirectory, const bool bIsDir ) -> bool
-		{
-			// Find all .txt/.csv files in a dir
-			if ( !bIsDir )
-			{
-				const FString BaseName = FPaths::GetBaseFilename( InFilenameOrDirectory );
-				if ( Settings->GetIsValidExtension( FPaths::GetExtension( InFilenameOrDirectory ) )
-					&& ( Settings->FilenamePrefix.IsEmpty() || BaseName.StartsWith( Settings->FilenamePrefix ) )
-					&& ( Settings->FilenameSuffix.IsEmpty() || BaseName.EndsWith( Settings->FilenameSuffix ) ) )
-				{
-					FString NewPath = InFilenameOrDirectory;
-					FPaths::RemoveDuplicateSlashes( NewPath );
-					FPaths::MakePathRelativeTo( NewPath, *FPaths::ProjectContentDir() );
-					Files.Add( NewPath );
-				}
-			}
-			// return true to continue searching
-			return true;
-		} );
-	}
+UBYGLocalization::UBYGLocalization()
+	: Catalog( MakeUnique<FBYGLocaleCatalog>( *this ) )
+{
+}
 
-	return Files;
+UBYGLocalization::~UBYGLocalization()
+{
 }
 
 FString UBYGLocalization::GetFilenameFromLanguageCode(const FString& LanguageCode, const FString& Category) const
@@ -110,396 +81,532 @@ FString UBYGLocalization::GetFileWithPathFromLanguageCode(const FString& Languag
 	return FullPath;
 }
 
-bool UBYGLocalization::UpdateTranslations()
+// One primary localization file that translations are updated from
+struct FBYGTranslationUpdatePrimary
 {
-	QUICK_SCOPE_CYCLE_COUNTER( STAT_BYGLocalization_UpdateTranslations );
+	FString Category;
+	FString FullPath;
+	FBYGLocaleData Data;
+	bool bLoaded = false;
+	FBYGUpdateLog Log;
+
+	FBYGManifestFile State;
+	bool bHasState = false;
+	// Contents or modification time differ from what the manifest recorded
+	bool bStateChanged = true;
+	// At least one translation needs merging, otherwise the primary isn't loaded
+	bool bNeeded = false;
+};
 
-	const TArray<FBYGLocaleInfo> Localizations = GetAvailableLocalizations();
-	const UBYGLocalizationSettings* Settings = UBYGLocalizationSettings::Get();
-	const FString MainLanguageCode = Settings->PrimaryLanguageCode;
-	const TArray<FString> LanguageCodesInUse = Settings->LanguageCodesInUse;
+// One (category, language) file to bring in line with its primary
+struct FBYGTranslationUpdateJob
+{
+	int32 PrimaryIndex = INDEX_NONE;
+	FString FullPath;
+	// Debug files get generated translations rather than copies of the primary
+	bool bIsDebug = false;
+	// The file doesn't exist yet and is created before being updated
+	bool bCreate = false;
+	// Only used in log messages
+	FString CultureName;
+
+	// Loaded before merging, and freed as soon as the merged file is written
+	FBYGLocaleData LocalData;
+	bool bLoaded = false;
+	FBYGManifestFile Before;
+	bool bExisted = false;
+
+	bool bSucceeded = false;
+	// Merged but couldn't be written, the file still has its old contents
+	bool bWriteFailed = false;
+	FBYGUpdateLog Log;
+
+	// Neither this file nor its primary changed since the last merge
+	bool bSkipped = false;
+	// The merge changed the contents of the file
+	bool bRewritten = false;
+	FBYGManifestFile State;
+	bool bHasState = false;
+};
+
+struct FBYGTranslationUpdatePlan
+{
+	TArray<FBYGTranslationUpdatePrimary> Primaries;
+	// In the same order files were updated before this was parallel, so logs read the same
+	TArray<FBYGTranslationUpdateJob> Jobs;
+	FString ManifestFilename;
+	// Primary and Comment text shared by every file in the update, see FBYGTranslationMerge::PoolPrimary
+	FBYGStringPool StringPool;
+};
+
+// Runs Body for every index using at most MaxConcurrency tasks, including the calling thread.
+// Indices that haven't started yet are skipped once cancelled.
+static void ParallelForCapped( int32 Num, int32 MaxConcurrency, const std::atomic<bool>& bCancelled, TFunctionRef<void( int32 )> Body )
+{
+	if ( Num <= 0 )
+		return;
 
-	TArray<FBYGLocaleInfo> MainLocalizations;
-	for (const FBYGLocaleInfo& Localization : Localizations)
+	std::atomic<int32> NextIndex { 0 };
+	auto Worker = [&NextIndex, &bCancelled, &Body, Num]()
 	{
-		if (Localization.LocaleCode == MainLanguageCode)
+		while ( !bCancelled )
 		{
-			MainLocalizations.Add(Localization);
+			const int32 Index = NextIndex++;
+			if ( Index >= Num )
+				break;
+			Body( Index );
 		}
+	};
+
+	const int32 NumWorkers = FMath::Clamp( MaxConcurrency, 1, Num );
+	TArray<UE::Tasks::FTask> Tasks;
+	for ( int32 i = 1; i < NumWorkers; ++i )
+	{
+		Tasks.Add( UE::Tasks::Launch( UE_SOURCE_LOCATION, Worker ) );
 	}
+	Worker();
+	UE::Tasks::Wait( Tasks );
+}
 
-	for (FBYGLocaleInfo MainLocalization : MainLocalizations)
+float FBYGTranslationUpdate::GetProgress() const
+{
+	return NumFiles > 0 ? (float)NumFilesCompleted / NumFiles : 1.0f;
+}
+
+bool FBYGTranslationUpdate::IsComplete() const
+{
+	return !Task.IsValid() || Task.IsCompleted();
+}
+
+bool FBYGTranslationUpdate::Wait() const
+{
+	if ( Task.IsValid() )
 	{
-		FBYGLocaleData PrimaryData;
-		FString FullFilename = FPaths::ProjectContentDir() + MainLocalization.FilePath;
+		Task.Wait();
+	}
+	return bSucceeded;
+}
 
-		const bool bSucceeded = GetLocalizationDataFromFile( FullFilename, PrimaryData );
+bool UBYGLocalization::UpdateTranslations()
+{
+	TSharedRef<FBYGTranslationUpdatePlan> Plan = MakeShared<FBYGTranslationUpdatePlan>();
+	PrepareTranslationUpdate( *Plan );
 
-		if ( !bSucceeded )
-		{
-			continue;
-		}
+	FBYGTranslationUpdate Update;
+	Update.NumFiles = Plan->Jobs.Num();
+	RunTranslationUpdate( *Plan, Update );
+	return Update.bSucceeded;
+}
 
-		const TArray<FBYGLocalizationEntry>* PrimaryEntriesInOrder = PrimaryData.GetEntriesInOrder();
-		const TMap<FString, int32>* PrimaryKeyToIndex = PrimaryData.GetKeyToIndex();
-		//if ( !ensure( PrimaryEntriesInOrder->Num() > 0 ) )
-		//	return false;
+TSharedRef<FBYGTranslationUpdate> UBYGLocalization::UpdateTranslationsAsync()
+{
+	// Finding files touches FInternationalization, so only the file updates themselves happen off this thread
+	TSharedRef<FBYGTranslationUpdatePlan> Plan = MakeShared<FBYGTranslationUpdatePlan>();
+	PrepareTranslationUpdate( *Plan );
 
-		for (const FString LanguageCode : LanguageCodesInUse)
-		{
-			//Select Language
-			if (LanguageCode != MainLanguageCode)
-			{
-				bool FoundFile = false;
-				//Search for Localization file of that language
-				for (const FBYGLocaleInfo& Localization : Localizations)
-				{
-					//UE_LOG(LogTemp, Warning, TEXT("Entry: %s / %s / %s / %s"), *Localization.LocaleCode, *Localization.LocalizedName.ToString(), *Localization.Category.ToString(), *Localization.FilePath);
+	TSharedRef<FBYGTranslationUpdate> Update = MakeShared<FBYGTranslationUpdate>();
+	Update->NumFiles = Plan->Jobs.Num();
+	Update->Task = UE::Tasks::Launch( UE_SOURCE_LOCATION, [this, Plan, Update]()
+	{
+		RunTranslationUpdate( *Plan, *Update );
+	} );
+	return Update;
+}
 
-					if (Localization.Category == MainLocalization.Category && Localization.LocaleCode == LanguageCode)
-					{
-						const FString FullPath = FPaths::Combine(FPaths::ProjectContentDir(), Localization.FilePath);
-						UpdateTranslationFile(FullPath, PrimaryEntriesInOrder, PrimaryKeyToIndex);
-						FoundFile = true;
-						break;
-					}
-				}
-				
-				//Translation file not found. Create a new one.
-				if (!FoundFile)
-				{
+void UBYGLocalization::PrepareTranslationUpdate( FBYGTranslationUpdatePlan& Plan ) const
+{
+	const UBYGLocalizationSettings* Settings = UBYGLocalizationSettings::Get();
+	const FString MainLanguageCode = Settings->PrimaryLanguageCode;
+	const TArray<FString> LanguageCodesInUse = Settings->LanguageCodesInUse;
+	const FString LocalizationDirPath = Settings->PrimaryLocalizationDirectory.Path.Replace( TEXT( "/Game" ), *FPaths::ProjectContentDir() );
+	Plan.ManifestFilename = FBYGTranslationManifest::GetManifestFilename();
 
-					FString LocalizationDirPath = Settings->PrimaryLocalizationDirectory.Path.Replace(TEXT("/Game"), *FPaths::ProjectContentDir());
-					FString FullPath = FString::Printf(TEXT("%s/%s/%s"),
-						*LocalizationDirPath,
-						*LanguageCode,
-						*GetFilenameFromLanguageCode(LanguageCode, MainLocalization.Category));
+	// Earlier versions kept the manifest in Content, where it would be packaged
+	const FString OldManifestFilename = FPaths::Combine( LocalizationDirPath, TEXT( "BYGTranslationManifest.bin" ) );
+	if ( IFileManager::Get().FileExists( *OldManifestFilename ) )
+	{
+		UE_LOG( LogBYGLocalization, Log, TEXT( "Deleting old translation manifest '%s'" ), *OldManifestFilename );
+		IFileManager::Get().Delete( *OldManifestFilename );
+	}
 
-					FPaths::RemoveDuplicateSlashes(FullPath);
-					FString ExportedStrings = "Key,SourceString,Comment,Primary,Status\r\n";
+	auto FindExistingFile = [this]( const FString& Category, const FString& LocaleCode, FString& OutFullPath )
+	{
+		FBYGLocaleInfo Localization;
+		if ( !Catalog->Find( LocaleCode, Category, Localization ) )
+			return false;
+		OutFullPath = FPaths::Combine( FPaths::ProjectContentDir(), Localization.FilePath );
+		return true;
+	};
 
-					UE_LOG(LogBYGLocalization, Verbose, TEXT("Create full path: %s"), *FullPath);
-					if (FFileHelper::SaveStringToFile(ExportedStrings, *FullPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
-					{
-						UpdateTranslationFile(FullPath, PrimaryEntriesInOrder, PrimaryKeyToIndex);
-					}
-				}
-			}
-		}
+	for ( const FBYGLocaleInfo& MainLocalization : Catalog->GetForLocale( MainLanguageCode ) )
+	{
+		const int32 PrimaryIndex = Plan.Primaries.AddDefaulted();
+		Plan.Primaries[ PrimaryIndex ].Category = MainLocalization.Category;
+		Plan.Primaries[ PrimaryIndex ].FullPath = FPaths::ProjectContentDir() + MainLocalization.FilePath;
 
+		for ( const FString& LanguageCode : LanguageCodesInUse )
 		{
-			bool FoundDebugFile = false;
-			//Update Debug Files
-			for (const FBYGLocaleInfo& Localization : Localizations)
-			{
-				//UE_LOG(LogTemp, Warning, TEXT("Entry: %s / %s / %s / %s"), *Localization.LocaleCode, *Localization.LocalizedName.ToString(), *Localization.Category.ToString(), *Localization.FilePath);
-
-				if (Localization.Category == MainLocalization.Category && Localization.LocaleCode == "Debug")
-				{
-					const FString FullPath = FPaths::Combine(FPaths::ProjectContentDir(), Localization.FilePath);
-					UpdateDebugFile(FullPath, PrimaryEntriesInOrder, PrimaryKeyToIndex);
-					FoundDebugFile = true;
-					break;
-				}
-			}
+			if ( LanguageCode == MainLanguageCode )
+				continue;
 
-			//Translation file not found. Create a new one.
-			if (!FoundDebugFile)
+			FBYGTranslationUpdateJob& Job = Plan.Jobs.AddDefaulted_GetRef();
+			Job.PrimaryIndex = PrimaryIndex;
+			if ( !FindExistingFile( MainLocalization.Category, LanguageCode, Job.FullPath ) )
 			{
-				FString LocalizationDirPath = Settings->PrimaryLocalizationDirectory.Path.Replace(TEXT("/Game"), *FPaths::ProjectContentDir());
-
-				FString FullPath = FString::Printf(TEXT("%s/Debug/%s"),
+				// Translation file not found. Create a new one.
+				Job.FullPath = FString::Printf( TEXT( "%s/%s/%s" ),
 					*LocalizationDirPath,
-					*GetFilenameFromLanguageCode("Debug", MainLocalization.Category));
-
-				FPaths::RemoveDuplicateSlashes(FullPath);
-				FString ExportedStrings = "Key,SourceString,Comment,Primary,Status\r\n";
-
-				UE_LOG(LogBYGLocalization, Verbose, TEXT("Create debug full path: %s"), *FullPath);
-
-				if (FFileHelper::SaveStringToFile(ExportedStrings, *FullPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
-					UpdateDebugFile(FullPath, PrimaryEntriesInOrder, PrimaryKeyToIndex);
+					*LanguageCode,
+					*GetFilenameFromLanguageCode( LanguageCode, MainLocalization.Category ) );
+				FPaths::RemoveDuplicateSlashes( Job.FullPath );
+				Job.bCreate = true;
 			}
 		}
 
-// 		// Source file is Primary
-// 		for ( const FBYGLocaleInfo& Localization : Localizations)
-// 		{
-// 			//UE_LOG(LogTemp, Warning, TEXT("Entry: %s / %s / %s / %s"), *Localization.LocaleCode, *Localization.LocalizedName.ToString(), *Localization.Category.ToString(), *Localization.FilePath);
-// 
-// 			if (Localization.Category.EqualToCaseIgnored(MainLocalization.Category) && Localization.LocaleCode != MainLocalization.LocaleCode)
-// 			{
-// 				const FString FullPath = FPaths::Combine(FPaths::ProjectContentDir(), Localization.FilePath);
-// 				if (Localization.LocaleCode == "Debug")
-// 				{
-// 					UpdateDebugFile(FullPath, PrimaryEntriesInOrder, PrimaryKeyToIndex);
-// 				}
-// 				else
-// 				{
-// 					UpdateTranslationFile(FullPath, PrimaryEntriesInOrder, PrimaryKeyToIndex);
-// 				}
-// 			}
-// 		}
+		// The virtual Debug locale is made from the primary when it's switched to, so it has no files. Ones written before
+		// it existed are left alone, they're only read again if bUseVirtualDebugLocale is turned off
+		if ( Settings->bUseVirtualDebugLocale )
+		{
+			FString OrphanedDebugPath;
+			if ( FindExistingFile( MainLocalization.Category, TEXT( "Debug" ), OrphanedDebugPath ) )
+			{
+				UE_LOG( LogBYGLocalization, Warning, TEXT( "'%s' is not used by the virtual Debug locale and can be deleted" ), *OrphanedDebugPath );
+			}
+			continue;
+		}
 
+		FBYGTranslationUpdateJob& DebugJob = Plan.Jobs.AddDefaulted_GetRef();
+		DebugJob.PrimaryIndex = PrimaryIndex;
+		DebugJob.bIsDebug = true;
+		if ( !FindExistingFile( MainLocalization.Category, TEXT( "Debug" ), DebugJob.FullPath ) )
+		{
+			DebugJob.FullPath = FString::Printf( TEXT( "%s/Debug/%s" ),
+				*LocalizationDirPath,
+				*GetFilenameFromLanguageCode( "Debug", MainLocalization.Category ) );
+			FPaths::RemoveDuplicateSlashes( DebugJob.FullPath );
+			DebugJob.bCreate = true;
+		}
 	}
-	return true;
 }
 
-bool UBYGLocalization::UpdateTranslationFile( const FString& Path,
-	const TArray<FBYGLocalizationEntry>* PrimaryEntriesInOrder,
-	const TMap<FString, int32>* PrimaryKeyToIndex )
+void UBYGLocalization::RunTranslationUpdate( FBYGTranslationUpdatePlan& Plan, FBYGTranslationUpdate& Update )
 {
-	QUICK_SCOPE_CYCLE_COUNTER( STAT_BYGLocalization_UpdateTranslationFile );
+	QUICK_SCOPE_CYCLE_COUNTER( STAT_BYGLocalization_UpdateTranslations );
 
-	// Source file is Primary
 	const UBYGLocalizationSettings* Settings = UBYGLocalizationSettings::Get();
-	const FString CultureName = RemovePrefixSuffix( Path );
+	const int32 MaxConcurrency = Settings->MaxTranslationUpdateThreads > 0
+		? Settings->MaxTranslationUpdateThreads
+		: FTaskGraphInterface::Get().GetNumWorkerThreads() + 1;
 
-	if ( CultureName == Settings->PrimaryLanguageCode )
-		return false;
-
-	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	// Without a manifest every file is merged, and the manifest is written for next time
+	FBYGTranslationManifest Manifest;
+	const bool bIncremental = Settings->bIncrementalTranslationUpdate && Manifest.Load( Plan.ManifestFilename );
 
-
-	const FFileStatData StatData = PlatformFile.GetStatData( *Path );
-	if ( StatData.bIsValid && StatData.bIsReadOnly )
+	// Primaries are only read to hash them if their size or modification time changed
+	ParallelForCapped( Plan.Primaries.Num(), MaxConcurrency, Update.bCancelRequested, [&Plan, &Manifest]( int32 Index )
 	{
-		UE_LOG( LogBYGLocalization, Warning, TEXT( "Cannot write to read-only file" ) );
-		return false;
-	}
-
-	FBYGLocaleData LocalData;
-	const bool bSucceeded = GetLocalizationDataFromFile( Path, LocalData );
-	if ( !bSucceeded )
-		return false;
-	const TArray<FBYGLocalizationEntry>* LocalEntriesInOrder = LocalData.GetEntriesInOrder();
-	const TMap<FString, int32>* LocalKeyToIndex = LocalData.GetKeyToIndex();
-	// Find any keys that are missing
-	if ( LocalEntriesInOrder->Num() == 0 )
+		FBYGTranslationUpdatePrimary& Primary = Plan.Primaries[ Index ];
+		const FBYGManifestFile* Known = Manifest.Find( Primary.FullPath );
+		Primary.bHasState = FBYGTranslationManifest::GetFileState( Primary.FullPath, Primary.State, Known );
+		Primary.bStateChanged = !Primary.bHasState
+			|| !Known
+			|| Known->Size != Primary.State.Size
+			|| Known->ModificationTicks != Primary.State.ModificationTicks;
+	} );
+
+	for ( FBYGTranslationUpdateJob& Job : Plan.Jobs )
 	{
-		UE_LOG( LogBYGLocalization, Warning, TEXT( "No Entries found when loading %s" ), *Path );
+		FBYGTranslationUpdatePrimary& Primary = Plan.Primaries[ Job.PrimaryIndex ];
+		const FBYGManifestFile* Known = Manifest.Find( Job.FullPath );
+		Job.bSkipped = bIncremental
+			&& !Job.bCreate
+			&& Primary.bHasState
+			&& Known
+			&& Known->PrimaryHash == Primary.State.Hash
+			&& Manifest.IsUnchanged( Job.FullPath );
+		if ( !Job.bSkipped )
+		{
+			Primary.bNeeded = true;
+		}
 	}
 
-	// Will reorder to match
-	TArray<FBYGLocalizationEntry> NewEntriesInOrder;
-
-	for ( const FBYGLocalizationEntry& PrimaryEntry : *PrimaryEntriesInOrder )
+	// Every translation depends on its primary, so load those first
+	ParallelForCapped( Plan.Primaries.Num(), MaxConcurrency, Update.bCancelRequested, [this, &Plan]( int32 Index )
+	{
+		FBYGTranslationUpdatePrimary& Primary = Plan.Primaries[ Index ];
+		if ( !Primary.bNeeded )
+			return;
+		FBYGScopedUpdateLog ScopedLog( Primary.Log );
+		Primary.bLoaded = GetLocalizationDataFromFile( Primary.FullPath, Primary.Data );
+	} );
+
+	// Only one thread can add to the pool, after this it's only searched
+	for ( FBYGTranslationUpdatePrimary& Primary : Plan.Primaries )
 	{
-		FBYGLocalizationEntry OldLocalizedEntry;
-		if ( LocalKeyToIndex->Contains( PrimaryEntry.Key )
-			&& (*LocalKeyToIndex)[ PrimaryEntry.Key ] >= 0
-			&& (*LocalKeyToIndex)[ PrimaryEntry.Key ] < LocalEntriesInOrder->Num() )
+		if ( Primary.bLoaded )
 		{
-			OldLocalizedEntry = (*LocalEntriesInOrder)[ (*LocalKeyToIndex)[ PrimaryEntry.Key ] ];
+			FBYGTranslationMerge::PoolPrimary( Primary.Data, Plan.StringPool );
 		}
+	}
 
-		FBYGLocalizationEntry NewLocalizedEntry;
-		NewLocalizedEntry.Key = PrimaryEntry.Key;
-		NewLocalizedEntry.Primary = PrimaryEntry.Translation;
+	// Each category's translations are read, merged with their primary and written before the worker moves on to the
+	// next category, so only the categories in flight have their translations in memory. Reads and writes within a
+	// category share the thread cap with the other categories
+	const int32 NumPrimariesLoaded = Algo::CountIf( Plan.Primaries, []( const FBYGTranslationUpdatePrimary& Primary ) { return Primary.bLoaded; } );
+	const int32 MaxCategoryConcurrency = FMath::Max( 1, MaxConcurrency / FMath::Max( 1, NumPrimariesLoaded ) );
+	const FBYGTranslationMergePolicy TranslationPolicy( &Plan.StringPool );
+	const FBYGPseudoLocalizationMergePolicy DebugPolicy( FBYGPseudoLocalizer::GetOptionsFromSettings(), &Plan.StringPool );
+	ParallelForCapped( Plan.Primaries.Num(), MaxConcurrency, Update.bCancelRequested, [this, &Plan, &Manifest, &Update, &TranslationPolicy, &DebugPolicy, MaxCategoryConcurrency]( int32 PrimaryIndex )
+	{
+		FBYGTranslationUpdatePrimary& Primary = Plan.Primaries[ PrimaryIndex ];
 
-		if ( OldLocalizedEntry.Translation.IsEmpty() && !PrimaryEntry.Translation.IsEmpty() )
+		TArray<int32> JobIndices;
+		for ( int32 JobIndex = 0; JobIndex < Plan.Jobs.Num(); ++JobIndex )
 		{
-			UE_LOG( LogBYGLocalization, Warning, TEXT( "%s missing key '%s', adding." ), *CultureName, *PrimaryEntry.Key );
-			// We want to show Primary until they replace the new key with a correct translation, so for now just write in the Primary to the translation field
-			NewLocalizedEntry.Translation = PrimaryEntry.Translation;
-			if ( NewLocalizedEntry.Key == "_LocMeta_Author" )
-			{
-				// Don't copy across author "Brace Yourself Games" for updated translations
-				NewLocalizedEntry.Translation = "Unknown";
-			}
-			NewLocalizedEntry.Status = EBYGLocEntryStatus::New;
-		}
-		// The display text in the master Primary is not the same as the Primary in the localization, something was modified
-		else if ( OldLocalizedEntry.Primary != PrimaryEntry.Translation )
-		{
-			NewLocalizedEntry = OldLocalizedEntry;
-			NewLocalizedEntry.Primary = PrimaryEntry.Translation;
-			const FName A = *OldLocalizedEntry.Primary;
-			const FName B = *PrimaryEntry.Translation;
-			UE_LOG( LogBYGLocalization, Warning, TEXT( "A:'%s' -> B:'%s'" ), *A.ToString(), *B.ToString() );
-				
-			const FString OldPrimary = OldLocalizedEntry.Primary;
-			if ( !OldPrimary.IsEmpty() )
+			if ( Plan.Jobs[ JobIndex ].PrimaryIndex == PrimaryIndex )
 			{
-				UE_LOG( LogBYGLocalization, Warning, TEXT( "Lang %s: Modified key '%s'. Was '%s', now is '%s'" ), *CultureName, *PrimaryEntry.Key, *OldPrimary, *PrimaryEntry.Translation );
-				NewLocalizedEntry.Status = EBYGLocEntryStatus::Modified;
-				NewLocalizedEntry.OldPrimary = OldPrimary;
+				JobIndices.Add( JobIndex );
 			}
 		}
-		else
+
+		ParallelForCapped( JobIndices.Num(), MaxCategoryConcurrency, Update.bCancelRequested, [this, &Plan, &Manifest, &Update, &Primary, &JobIndices]( int32 Index )
 		{
-			NewLocalizedEntry = OldLocalizedEntry;
-		}
+			FBYGTranslationUpdateJob& Job = Plan.Jobs[ JobIndices[ Index ] ];
+			if ( !Job.bSkipped && Primary.bLoaded )
+			{
+				FBYGScopedUpdateLog ScopedLog( Job.Log );
 
-		NewLocalizedEntry.Comment = PrimaryEntry.Comment;
-		NewEntriesInOrder.Add( NewLocalizedEntry );
+				Job.bExisted = !Job.bCreate && FBYGTranslationManifest::GetFileState( Job.FullPath, Job.Before, Manifest.Find( Job.FullPath ) );
 
-	}
+				bool bFileExists = true;
+				if ( Job.bCreate )
+				{
+					BYG_UPDATE_LOG( Verbose, TEXT( "Create full path: %s" ), *Job.FullPath );
+					const FString ExportedStrings = "Key,SourceString,Comment,Primary,Status\r\n";
+					bFileExists = FFileHelper::SaveStringToFile( ExportedStrings, *Job.FullPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM );
+					if ( bFileExists )
+					{
+						Catalog->AddFile( Job.FullPath );
+					}
+				}
 
-	for ( const FBYGLocalizationEntry& Entry : *LocalEntriesInOrder )
-	{
-		if ( !PrimaryKeyToIndex->Contains( Entry.Key ) )
+				if ( bFileExists )
+				{
+					Job.CultureName = RemovePrefixSuffix( Job.FullPath );
+					Job.bLoaded = LoadTranslationFile( Job.FullPath, Job.bIsDebug, Job.LocalData );
+					if ( Job.bLoaded )
+					{
+						FBYGTranslationMerge::PoolTarget( Job.LocalData, Plan.StringPool );
+					}
+				}
+			}
+
+			if ( !Job.bLoaded )
+			{
+				Update.NumFilesCompleted++;
+			}
+		} );
+
+		TArray<FBYGMergeTarget> Targets;
+		TArray<int32> LoadedJobIndices;
+		for ( const int32 JobIndex : JobIndices )
 		{
-			// TODO
-			UE_LOG( LogBYGLocalization, Warning, TEXT( "%s has unused key '%s', marking deprecated." ), *CultureName, *Entry.Key );
-			FBYGLocalizationEntry NewEntry = Entry;
-			NewEntry.Status = EBYGLocEntryStatus::Deprecated;
-			NewEntriesInOrder.Add( NewEntry );
+			FBYGTranslationUpdateJob& Job = Plan.Jobs[ JobIndex ];
+			if ( !Job.bLoaded )
+				continue;
+
+			FBYGMergeTarget& Target = Targets.AddDefaulted_GetRef();
+			Target.Data = &Job.LocalData;
+			Target.Policy = Job.bIsDebug ? (const FBYGMergePolicy*)&DebugPolicy : &TranslationPolicy;
+			Target.CultureName = Job.CultureName;
+			Target.Log = &Job.Log;
+			LoadedJobIndices.Add( JobIndex );
 		}
-	}
 
-	// Output the file
-	WriteCSV( NewEntriesInOrder, Path );
+		if ( Targets.Num() > 0 && !Update.bCancelRequested )
+		{
+			FBYGTranslationMerge::Merge( Primary.Data, Targets );
+		}
 
-	return true;
-}
+		ParallelForCapped( Targets.Num(), MaxCategoryConcurrency, Update.bCancelRequested, [this, &Plan, &Update, &Primary, &Targets, &LoadedJobIndices]( int32 TargetIndex )
+		{
+			FBYGTranslationUpdateJob& Job = Plan.Jobs[ LoadedJobIndices[ TargetIndex ] ];
+			FBYGScopedUpdateLog ScopedLog( Job.Log );
 
-bool UBYGLocalization::UpdateDebugFile(const FString& Path, const TArray<FBYGLocalizationEntry>* PrimaryEntriesInOrder, const TMap<FString, int32>* PrimaryKeyToIndex)
-{
-	QUICK_SCOPE_CYCLE_COUNTER(STAT_BYGLocalization_UpdateTranslationFile);
+			// Output the file
+			TArray<FBYGLocalizationEntry>& MergedEntries = Targets[ TargetIndex ].Entries;
+			Job.bSucceeded = WriteCSV( MergedEntries, Job.FullPath, nullptr, &Plan.StringPool );
+			Job.bWriteFailed = !Job.bSucceeded;
 
-	// Source file is Primary
-	const UBYGLocalizationSettings* Settings = UBYGLocalizationSettings::Get();
-	const FString CultureName = RemovePrefixSuffix(Path);
+			// Everything read and merged for this file goes at once
+			MergedEntries.Empty();
+			Job.LocalData = FBYGLocaleData();
 
-	if (CultureName == Settings->PrimaryLanguageCode || !CultureName.Contains("Debug"))
-		return false;
+			// A file that failed to write is left out of the manifest, so it's merged again next time rather than
+			// recorded as up to date with its old contents
+			if ( !Job.bSucceeded )
+			{
+				BYG_UPDATE_LOG( Error, TEXT( "Failed to write merged translation '%s'" ), *Job.FullPath );
+			}
+			else if ( Primary.bHasState )
+			{
+				Job.bHasState = FBYGTranslationManifest::GetFileState( Job.FullPath, Job.State );
+				Job.State.PrimaryHash = Primary.State.Hash;
+				Job.bRewritten = !Job.bExisted || !Job.bHasState || Job.State.Hash != Job.Before.Hash;
+			}
 
-	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+			Update.NumFilesCompleted++;
+		} );
 
+		// Files cancelled part way through are dropped here too, nothing reads this category again
+		for ( const int32 JobIndex : LoadedJobIndices )
+		{
+			Plan.Jobs[ JobIndex ].LocalData = FBYGLocaleData();
+		}
+		Primary.Data = FBYGLocaleData();
+	} );
 
-	const FFileStatData StatData = PlatformFile.GetStatData(*Path);
-	if (StatData.bIsValid && StatData.bIsReadOnly)
+	// Print everything in a stable order regardless of which thread finished first
+	int32 NextJob = 0;
+	for ( int32 PrimaryIndex = 0; PrimaryIndex < Plan.Primaries.Num(); ++PrimaryIndex )
 	{
-		UE_LOG(LogBYGLocalization, Warning, TEXT("Cannot write to read-only file"));
-		return false;
+		Plan.Primaries[ PrimaryIndex ].Log.Flush();
+		for ( ; NextJob < Plan.Jobs.Num() && Plan.Jobs[ NextJob ].PrimaryIndex == PrimaryIndex; ++NextJob )
+		{
+			Plan.Jobs[ NextJob ].Log.Flush();
+		}
 	}
 
-	FBYGLocaleData LocalData;
-	const bool bSucceeded = GetLocalizationDataFromFile(Path, LocalData);
-	if (!bSucceeded)
-		return false;
-	const TArray<FBYGLocalizationEntry>* LocalEntriesInOrder = LocalData.GetEntriesInOrder();
-	const TMap<FString, int32>* LocalKeyToIndex = LocalData.GetKeyToIndex();
-	// Find any keys that are missing
-	if (LocalEntriesInOrder->Num() == 0)
+	bool bManifestChanged = false;
+	int32 NumWriteFailures = 0;
+	for ( const FBYGTranslationUpdatePrimary& Primary : Plan.Primaries )
 	{
-		UE_LOG(LogBYGLocalization, Warning, TEXT("No Entries found when loading %s"), *Path);
+		if ( Primary.bHasState && Primary.bStateChanged )
+		{
+			Manifest.Set( Primary.FullPath, Primary.State );
+			bManifestChanged = true;
+		}
 	}
-
-	// Will reorder to match
-	TArray<FBYGLocalizationEntry> NewEntriesInOrder;
-
-	for (const FBYGLocalizationEntry& PrimaryEntry : *PrimaryEntriesInOrder)
+	for ( const FBYGTranslationUpdateJob& Job : Plan.Jobs )
 	{
-		FBYGLocalizationEntry OldLocalizedEntry;
-		if (LocalKeyToIndex->Contains(PrimaryEntry.Key)
-			&& (*LocalKeyToIndex)[PrimaryEntry.Key] >= 0
-			&& (*LocalKeyToIndex)[PrimaryEntry.Key] < LocalEntriesInOrder->Num())
+		if ( Job.bSkipped )
 		{
-			OldLocalizedEntry = (*LocalEntriesInOrder)[(*LocalKeyToIndex)[PrimaryEntry.Key]];
+			Update.NumFilesSkipped++;
 		}
-
-		FBYGLocalizationEntry NewLocalizedEntry;
-		NewLocalizedEntry.Key = PrimaryEntry.Key;
-		NewLocalizedEntry.Primary = PrimaryEntry.Translation;
-
-		if (OldLocalizedEntry.Translation.IsEmpty() && !PrimaryEntry.Translation.IsEmpty())
+		else if ( Job.bSucceeded )
 		{
-			UE_LOG(LogBYGLocalization, Warning, TEXT("%s missing key '%s', adding."), *CultureName, *PrimaryEntry.Key);
-			// We want to show Primary until they replace the new key with a correct translation, so for now just write in the Primary to the translation field
-			
-			GenerateDebugTranslation(PrimaryEntry.Translation, NewLocalizedEntry.Translation);
-			NewLocalizedEntry.Status = EBYGLocEntryStatus::New;
+			Update.NumFilesMerged++;
+			Update.NumFilesRewritten += Job.bRewritten ? 1 : 0;
 		}
-		// The display text in the master Primary is not the same as the Primary in the localization, something was modified
-		else if (OldLocalizedEntry.Primary != PrimaryEntry.Translation)
+		NumWriteFailures += Job.bWriteFailed ? 1 : 0;
+		if ( Job.bHasState )
 		{
-			NewLocalizedEntry = OldLocalizedEntry;
-			NewLocalizedEntry.Primary = PrimaryEntry.Translation;
-			const FString OldPrimary = OldLocalizedEntry.Primary;
-			if (!OldPrimary.IsEmpty())
-			{
-				UE_LOG(LogBYGLocalization, Warning, TEXT("Lang %s: Modified key '%s'. Was '%s', now is '%s'"), *CultureName, *PrimaryEntry.Key, *OldPrimary, *PrimaryEntry.Translation);
-				NewLocalizedEntry.Status = EBYGLocEntryStatus::Modified;
-				NewLocalizedEntry.OldPrimary = OldPrimary;
-				
-				GenerateDebugTranslation(PrimaryEntry.Translation, NewLocalizedEntry.Translation);
-			}
+			Manifest.Set( Job.FullPath, Job.State );
+			bManifestChanged = true;
 		}
-		else
-		{
-			NewLocalizedEntry = OldLocalizedEntry;
+	}
+	if ( bManifestChanged )
+	{
+		Manifest.Save( Plan.ManifestFilename );
+	}
 
-			if (!NewLocalizedEntry.Translation.StartsWith("["))
-			{
-				GenerateDebugTranslation(OldLocalizedEntry.Translation, NewLocalizedEntry.Translation);
-			}
-		}
+	// A rewritten file can have the same size and timestamp as before, within the file system's resolution
+	FBYGStatusScanner::ClearCache();
 
-		NewEntriesInOrder.Add(NewLocalizedEntry);
+	UE_LOG( LogBYGLocalization, Log, TEXT( "Updated translations: %d skipped, %d merged, %d rewritten" ), Update.NumFilesSkipped, Update.NumFilesMerged, Update.NumFilesRewritten );
+	if ( NumWriteFailures > 0 )
+	{
+		UE_LOG( LogBYGLocalization, Error, TEXT( "Failed to write %d translation files" ), NumWriteFailures );
+	}
 
+	// Returns false when no primary translations found, or a merged file couldn't be written
+	Update.bSucceeded = !Update.bCancelRequested && Plan.Primaries.Num() > 0 && NumWriteFailures == 0;
+	if ( Update.bCancelRequested )
+	{
+		UE_LOG( LogBYGLocalization, Log, TEXT( "Translation update cancelled after %d of %d files" ), Update.NumFilesCompleted.load(), Update.NumFiles );
 	}
+}
+
+bool UBYGLocalization::CompileLocalizations( bool bForce ) const
+{
+	QUICK_SCOPE_CYCLE_COUNTER( STAT_BYGLocalization_CompileLocalizations );
+
+	bool bSuccess = true;
+	int32 NumCompiled = 0;
 
-	for (const FBYGLocalizationEntry& Entry : *LocalEntriesInOrder)
+	for ( const FBYGLocaleInfo& Localization : GetAvailableLocalizations() )
 	{
-		if (!PrimaryKeyToIndex->Contains(Entry.Key))
+		const FString SourceFilename = FPaths::Combine( FPaths::ProjectContentDir(), Localization.FilePath );
+		const FString BlobFilename = FBYGLocalizationBlob::GetBlobFilename( SourceFilename );
+
+		FBYGLocalizationBlob ExistingBlob;
+		if ( !bForce && ExistingBlob.LoadFromFile( BlobFilename, SourceFilename ) )
+			continue;
+
+		if ( FBYGLocalizationBlob::Compile( SourceFilename, BlobFilename ) )
+		{
+			NumCompiled++;
+		}
+		else
 		{
-			// TODO
-			UE_LOG(LogBYGLocalization, Warning, TEXT("%s has unused key '%s', marking deprecated."), *CultureName, *Entry.Key);
-			FBYGLocalizationEntry NewEntry = Entry;
-			NewEntry.Status = EBYGLocEntryStatus::Deprecated;
-			NewEntriesInOrder.Add(NewEntry);
+			bSuccess = false;
 		}
 	}
 
-	// Output the file
-	WriteCSV(NewEntriesInOrder, Path);
-
-	return true;
+	UE_LOG( LogBYGLocalization, Log, TEXT( "Compiled %d localization files" ), NumCompiled );
+	return bSuccess;
 }
 
-void UBYGLocalization::GenerateDebugTranslation(const FString& PrimaryEntry, FString &DebugTranslation)
+bool UBYGLocalization::LoadTranslationFile( const FString& Path, bool bIsDebug, FBYGLocaleData& LocalData ) const
 {
-	DebugTranslation = PrimaryEntry;
+	QUICK_SCOPE_CYCLE_COUNTER( STAT_BYGLocalization_LoadTranslationFile );
+
+	// Source file is Primary
+	const UBYGLocalizationSettings* Settings = UBYGLocalizationSettings::Get();
+	const FString CultureName = RemovePrefixSuffix( Path );
 
-	const int32 Length = PrimaryEntry.Len();
-	const int32 VowelsToAdd = FMath::CeilToInt((float)Length * 1.5f) - Length;
+	if ( CultureName == Settings->PrimaryLanguageCode || ( bIsDebug && !CultureName.Contains( "Debug" ) ) )
+		return false;
 
-	if ((PrimaryEntry.Contains("<") && PrimaryEntry.Contains(">")) || PrimaryEntry.Contains("|") || PrimaryEntry.Contains("{") || PrimaryEntry.Contains("}")
-		|| PrimaryEntry.Contains("[") || PrimaryEntry.Contains("]"))
-	{
-		DebugTranslation = "[" + PrimaryEntry + "]";
-		return;
-	}
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
 
 
-	int32 TotalVowels = 0;
-	//Total vowels
-	for (int32 i = 0; i < Length; i++)
+	const FFileStatData StatData = PlatformFile.GetStatData( *Path );
+	if ( StatData.bIsValid && StatData.bIsReadOnly )
 	{
-		FString Char = PrimaryEntry.Mid(i, 1);
-		if (Char.Contains("A") || Char.Contains("E") || Char.Contains("I") || Char.Contains("O") || Char.Contains("U"))
-		{
-			TotalVowels++;
-		}
+		BYG_UPDATE_LOG( Warning, TEXT( "Cannot write to read-only file" ) );
+		return false;
 	}
 
-	int32 ExtraVowelsPerPosition = FMath::CeilToInt((float)VowelsToAdd / TotalVowels);
-
-	for (int32 i = Length - 1; i >= 0; i--)
+	const bool bSucceeded = GetLocalizationDataFromFile( Path, LocalData );
+	if ( !bSucceeded )
+		return false;
+	// Find any keys that are missing
+	if ( LocalData.GetEntriesInOrder()->Num() == 0 )
 	{
-		FString Char = PrimaryEntry.Mid(i, 1).ToLower();
-		if (Char.Contains("A") || Char.Contains("E") || Char.Contains("I") || Char.Contains("O") || Char.Contains("U"))
-		{
-			for (int32 j = 0; j < ExtraVowelsPerPosition; j++)
-			{
-				DebugTranslation.InsertAt(i + 1, Char);
-			}
-		}
+		BYG_UPDATE_LOG( Warning, TEXT( "No Entries found when loading %s" ), *Path );
 	}
 
-	DebugTranslation = "[" + DebugTranslation + "]";
+	return true;
+}
+
+bool UBYGLocalization::UpdateTranslationFile( const FString& Path, const FBYGLocaleData& PrimaryData )
+{
+	QUICK_SCOPE_CYCLE_COUNTER( STAT_BYGLocalization_UpdateTranslationFile );
+
+	FBYGLocaleData LocalData;
+	if ( !LoadTranslationFile( Path, false, LocalData ) )
+		return false;
+
+	const FBYGTranslationMergePolicy Policy;
+	FBYGMergeTarget Target;
+	Target.Data = &LocalData;
+	Target.Policy = &Policy;
+	Target.CultureName = RemovePrefixSuffix( Path );
+	FBYGTranslationMerge::Merge( PrimaryData, MakeArrayView( &Target, 1 ) );
+
+	// Output the file
+	return WriteCSV( Target.Entries, Path );
 }
 
 // Load CSV file into our data structure for ease of use
@@ -511,118 +618,109 @@ bool UBYGLocalization::GetLocalizationDataFromFile( const FString& Filename, FBY
 
 	TArray<FBYGLocalizationEntry> NewEntries;
 
-	FString CSVString;
-	if ( FFileHelper::LoadFileToString( CSVString, *Filename ) )
-	{
-		const FCsvParser Parser( CSVString );
-		const FCsvParser::FRows& Rows = Parser.GetRows();
+	const int32 KeyColumn = 0;
+	const int32 TranslationColumn = 1;
+	int32 CommentColumn = INDEX_NONE;
+	int32 PrimaryColumn = INDEX_NONE;
+	int32 StatusColumn = INDEX_NONE;
+	bool bValidHeader = true;
 
-		// Validate the header here. Unreal does it for us but we want nicer error-messages
-		bool bValidHeader = true;
-		if ( Rows.Num() > 0 )
+	FBYGCsvReader Reader;
+	const bool bSucceeded = Reader.ReadFile( Filename, [&]( const FBYGCsvRow& Row )
+	{
+		if ( Row.Index == 0 )
 		{
+			// Validate the header here. Unreal does it for us but we want nicer error-messages
 			//Key,SourceString,Comment,Primary,Status
-			if ( !Rows[ 0 ].IsValidIndex( 0 ) || FString( Rows[ 0 ][ 0 ] ) != TEXT( "Key" ) )
+			// Names ignore case, as they always have: FString's == and != are case-insensitive
+			if ( !Row.Cells.IsValidIndex( 0 ) || !Row.GetString( 0 ).Equals( TEXT( "Key" ), ESearchCase::IgnoreCase ) )
 			{
-				UE_LOG( LogBYGLocalization, Error, TEXT( "Column 0 in header must be 'Key'" ) );
+				BYG_UPDATE_LOG( Error, TEXT( "Column 0 in header must be 'Key'" ) );
 				bValidHeader = false;
 			}
-			if ( !Rows[ 0 ].IsValidIndex( 1 ) || FString( Rows[ 0 ][ 1 ] ) != TEXT( "SourceString" ) )
+			if ( !Row.Cells.IsValidIndex( 1 ) || !Row.GetString( 1 ).Equals( TEXT( "SourceString" ), ESearchCase::IgnoreCase ) )
 			{
-				UE_LOG( LogBYGLocalization, Error, TEXT( "Column 1 in header must be 'SourceString'" ) );
+				BYG_UPDATE_LOG( Error, TEXT( "Column 1 in header must be 'SourceString'" ) );
 				bValidHeader = false;
 			}
-		}
-		if ( !bValidHeader )
-			return false;
-
-		int32 CommentColumn = INDEX_NONE;
-		int32 PrimaryColumn = INDEX_NONE;
-		int32 StatusColumn = INDEX_NONE;
-		for(int32 i = 0; i < Rows[0].Num(); i++)
-		{
-			if(FString(Rows[0][i]) == TEXT( "Comment" ))
-			{
-				CommentColumn = i;
-				continue;
-			}
-			else if(FString(Rows[0][i]) == TEXT( "Primary" ))
-			{
-				PrimaryColumn = i;
-				continue;
-			}
-			else if(FString(Rows[0][i]) == TEXT( "Status" ))
-			{
-				StatusColumn = i;
-				continue;
-			}
-		}
-		
-		// Note that we skip the header
-		for ( int32 i = 1; i < Rows.Num(); ++i )
-		{
-			const TArray<const TCHAR*>& Row = Rows[ i ];
-			if ( Row.Num() < 2 || FString( Row[ 0 ] ) == "" )
-			{
-				// Add dummy/empty
-			// TODO why?
-				NewEntries.Add( FBYGLocalizationEntry() );
-				continue;
-			}
-
-			// Key,Translation,Comment,Primary,Status
-
-			// Not everything has a comment
-			const FString Comment = ( CommentColumn != INDEX_NONE && Row.Num() >= CommentColumn ? FString( Row[ CommentColumn ] ) : "" ); //.ReplaceEscapedCharWithChar();
-
-			const FString Key = FString( Row[ 0 ] ); //.ReplaceEscapedCharWithChar();
-			const FString Translation = FString( Row[ 1 ] ).ReplaceEscapedCharWithChar();
 
-#if 0
-			const FRegexPattern RunawayKeyPattern( TEXT( "\n[A-Za-z0-9]+_[A-Za-z0-9_]+," ) );
-			FRegexMatcher RunawayMatcher( RunawayKeyPattern, Translation );
-			if ( RunawayMatcher.FindNext() )
+			uint64 ColumnMask = ( 1ull << KeyColumn ) | ( 1ull << TranslationColumn );
+			for ( int32 i = 0; i < Row.Num(); i++ )
 			{
-				UE_LOG( LogBYGLocalization, Warning, TEXT( "Row %d: Possible runaway quotation mark '%s'" ), i, *Key );
-			}
-#endif
-
-			FBYGLocalizationEntry Entry( Key, Translation, Comment );
-			if ( Row.Num() >= PrimaryColumn )
-			{
-				Entry.Primary = FString( Row[ PrimaryColumn ] ); //.ReplaceEscapedCharWithChar();
-
-
-				const FString Status = ( StatusColumn != INDEX_NONE && Row.Num() >= StatusColumn ? FString( Row[ StatusColumn ] ) : "" );;
-
-				if ( Status.StartsWith( Settings->DeprecatedStatus ) )
+				const FString Column = Row.GetString( i );
+				if ( Column.Equals( TEXT( "Comment" ), ESearchCase::IgnoreCase ) )
 				{
-					Entry.Status = EBYGLocEntryStatus::Deprecated;
+					CommentColumn = i;
 				}
-				else if ( Status.StartsWith( Settings->ModifiedStatusLeft ) )
+				else if ( Column.Equals( TEXT( "Primary" ), ESearchCase::IgnoreCase ) )
 				{
-					Entry.Status = EBYGLocEntryStatus::Modified;
-					Entry.OldPrimary = Status.RightChop( Settings->ModifiedStatusLeft.Len() ).LeftChop( Settings->ModifiedStatusRight.Len() );
+					PrimaryColumn = i;
 				}
-				else if ( Status.StartsWith( Settings->NewStatus ) )
+				else if ( Column.Equals( TEXT( "Status" ), ESearchCase::IgnoreCase ) )
 				{
-					Entry.Status = EBYGLocEntryStatus::New;
+					StatusColumn = i;
 				}
 				else
 				{
-					Entry.Status = EBYGLocEntryStatus::None;
+					continue;
 				}
+				ColumnMask |= i < 64 ? ( 1ull << i ) : 0;
 			}
-			NewEntries.Add( Entry );
+			// Anything else in the file is never copied out
+			Reader.SetColumnMask( ColumnMask );
+			return bValidHeader;
 		}
-	}
-	else
+
+		if ( Row.Num() < 2 || Row[ KeyColumn ].IsEmpty() )
+		{
+			// Add dummy/empty
+			// TODO why?
+			NewEntries.Add( FBYGLocalizationEntry() );
+			return true;
+		}
+
+		// Key,Translation,Comment,Primary,Status
+		FBYGLocalizationEntry& Entry = NewEntries.AddDefaulted_GetRef();
+		Entry.Key = Row.GetString( KeyColumn );
+		Entry.Translation = Row.GetString( TranslationColumn ).ReplaceEscapedCharWithChar();
+		// Not everything has a comment
+		Entry.Comment = Row.GetString( CommentColumn );
+		Entry.Primary = Row.GetString( PrimaryColumn );
+
+		const FString Status = Row.GetString( StatusColumn );
+		if ( Status.StartsWith( Settings->DeprecatedStatus ) )
+		{
+			Entry.Status = EBYGLocEntryStatus::Deprecated;
+		}
+		else if ( Status.StartsWith( Settings->ModifiedStatusLeft ) )
+		{
+			Entry.Status = EBYGLocEntryStatus::Modified;
+			Entry.OldPrimary = Status.RightChop( Settings->ModifiedStatusLeft.Len() ).LeftChop( Settings->ModifiedStatusRight.Len() );
+		}
+		else if ( Status.StartsWith( Settings->NewStatus ) )
+		{
+			Entry.Status = EBYGLocEntryStatus::New;
+		}
+		else
+		{
+			Entry.Status = EBYGLocEntryStatus::None;
+		}
+		return true;
+	} );
+
+	if ( !bSucceeded )
 	{
-		UE_LOG( LogBYGLocalization, Error, TEXT( "Failed to load file '%s'" ), *Filename );
+		BYG_UPDATE_LOG( Error, TEXT( "Failed to load file '%s'" ), *Filename );
 		return false;
 	}
+	if ( !bValidHeader )
+		return false;
+	if ( Reader.HasRunawayQuote() )
+	{
+		BYG_UPDATE_LOG( Warning, TEXT( "'%s' ends inside a quoted value, check for a missing closing quotation mark" ), *Filename );
+	}
 
-	Data = FBYGLocaleData( NewEntries );
+	Data = FBYGLocaleData( MoveTemp( NewEntries ) );
 
 	return true;
 }
@@ -631,48 +729,8 @@ bool UBYGLocalization::GetLocalizationStats( const FString& Filename, BYGLocStat
 {
 	QUICK_SCOPE_CYCLE_COUNTER( STAT_BYGLocalization_GetLocalizationStats );
 
-	FString CSVData;
-	if ( FFileHelper::LoadFileToString( CSVData, *Filename ) )
-	{
-		StatusCounts.Empty();
-
-		StatusCounts.Add( EBYGLocEntryStatus::None, 0 );
-		StatusCounts.Add( EBYGLocEntryStatus::New, 0 );
-		StatusCounts.Add( EBYGLocEntryStatus::Modified, 0 );
-		StatusCounts.Add( EBYGLocEntryStatus::Deprecated, 0 );
-
-		const FCsvParser Parser( CSVData );
-		const FCsvParser::FRows& Rows = Parser.GetRows();
-
-		const UBYGLocalizationSettings* Settings = UBYGLocalizationSettings::Get();
-
-		// Note that we skip the header
-		for ( int32 i = 1; i < Rows.Num(); ++i )
-		{
-			const TArray<const TCHAR*>& Row = Rows[ i ];
-			if ( Row.Num() >= 5 )
-			{
-				const FString Status( Row[ 4 ] );
-				if ( Status.StartsWith( Settings->DeprecatedStatus ) )
-				{
-					StatusCounts[ EBYGLocEntryStatus::Deprecated ] += 1;
-				}
-				else if ( Status.StartsWith( Settings->ModifiedStatusLeft ) )
-				{
-					StatusCounts[ EBYGLocEntryStatus::Modified ] += 1;
-				}
-				else if ( Status.StartsWith( Settings->NewStatus ) )
-				{
-					StatusCounts[ EBYGLocEntryStatus::New ] += 1;
-				}
-				else
-				{
-					StatusCounts[ EBYGLocEntryStatus::None ] += 1;
-				}
-			}
-		}
-	}
-	else
+	const FBYGStatusScanner Scanner;
+	if ( !Scanner.GetStats( Filename, StatusCounts ) )
 	{
 		UE_LOG( LogBYGLocalization, Error, TEXT( "Failed to load file '%s'" ), *Filename );
 		return false;
@@ -717,97 +775,175 @@ FString UBYGLocalization::ReplaceCharWithEscapedChar( const FString& Str )
 }
 
 
+// Backups are kept out of the content directory so they're never staged or found as localization files
+static FString GetBackupFilename( const FString& Filename )
+{
+	FString RelativePath = FPaths::ConvertRelativePathToFull( Filename );
+	if ( !FPaths::MakePathRelativeTo( RelativePath, *FPaths::ConvertRelativePathToFull( FPaths::ProjectDir() ) ) || RelativePath.StartsWith( TEXT( ".." ) ) )
+	{
+		RelativePath = FPaths::GetCleanFilename( Filename );
+	}
+	return FPaths::ProjectSavedDir() / TEXT( "BYGLocalization" ) / TEXT( "Backup" ) / RelativePath + TEXT( ".bak" );
+}
+
 // This is kind of unweidly with all the parameters but it makes testing way easier and it's an internal function
 // so what the hell.
-bool UBYGLocalization::WriteCSV( const TArray<FBYGLocalizationEntry>& Entries, const FString& Filename )
+bool UBYGLocalization::WriteCSV( const TArray<FBYGLocalizationEntry>& Entries, const FString& Filename, bool* bOutChanged, const FBYGStringPool* StringPool )
 {
 	QUICK_SCOPE_CYCLE_COUNTER( STAT_BYGLocalization_WriteCSV );
 
-	uint32 WriteFlags = 0;
-	WriteFlags |= FILEWRITE_EvenIfReadOnly;
-	FArchive* CSVFileWriter = IFileManager::Get().CreateFileWriter( *Filename, WriteFlags );
-	if ( !CSVFileWriter )
+	if ( bOutChanged )
 	{
-		UE_LOG( LogBYGLocalization, Error, TEXT( "Unable to open csv file \"%s\"." ), *Filename );
-		return false;
+		*bOutChanged = false;
 	}
 
 	const UBYGLocalizationSettings* Settings = UBYGLocalizationSettings::Get();
 
-	CSVFileWriter->Logf( TEXT( "Key,SourceString,Comment,Primary,Status" ) );
-
 	const bool bQuote = Settings->QuotingPolicy == EBYGQuotingPolicy::ForceQuoted;
 
+	// Enough for rows that are all ASCII with nothing to escape, which is nearly all of them
+	int64 EstimatedSize = 64;
+	for ( const FBYGLocalizationEntry& Entry : Entries )
+	{
+		EstimatedSize += Entry.Key.Len() + Entry.Translation.Len() + Entry.GetComment( StringPool ).Len() + Entry.GetPrimary( StringPool ).Len() + 8;
+	}
+
+	// Built in memory first so an unchanged file is never touched
+	FBYGCsvWriter Writer( bQuote );
+	Writer.Reserve( (int32)FMath::Min<int64>( EstimatedSize, MAX_int32 ) );
+	Writer.AddRaw( TEXT( "Key,SourceString,Comment,Primary,Status" ) );
+	Writer.EndRow();
+
+	// Reused for every modified row
+	FString ModifiedStatus;
+
 	for ( const FBYGLocalizationEntry& Entry : Entries )
 	{
 		if ( Entry.Status == EBYGLocEntryStatus::Deprecated && !Settings->bPreserveDeprecatedLines )
 			continue;
 
-		// RFC 4180 specifies that double quotes are escaped as ""
-		const FString ExportedKey = ReplaceCharWithEscapedChar( Entry.Key );
-		const FString ExportedTranslation = ReplaceCharWithEscapedChar( Entry.Translation );
-		const FString Comment = ReplaceCharWithEscapedChar( Entry.Comment );
-		const FString ExportedComment = Comment.IsEmpty() ? "" : Comment;
-		const FString ExportedPrimary = ReplaceCharWithEscapedChar( Entry.Primary );
-
-		FString ExportedStatus = "";
+		FStringView Status;
 		if ( Entry.Status == EBYGLocEntryStatus::Deprecated )
 		{
-			ExportedStatus = Settings->DeprecatedStatus;
+			Status = Settings->DeprecatedStatus;
 		}
 		else if ( Entry.Status == EBYGLocEntryStatus::Modified )
 		{
-			ExportedStatus = FString::Printf( TEXT( "%s%s%s" ), *Settings->ModifiedStatusLeft, *Entry.OldPrimary, *Settings->ModifiedStatusRight );
+			ModifiedStatus.Reset();
+			ModifiedStatus += Settings->ModifiedStatusLeft;
+			ModifiedStatus += Entry.OldPrimary;
+			ModifiedStatus += Settings->ModifiedStatusRight;
+			Status = ModifiedStatus;
 		}
 		else if ( Entry.Status == EBYGLocEntryStatus::New )
 		{
-			ExportedStatus = Settings->NewStatus;
+			Status = Settings->NewStatus;
 		}
-		ExportedStatus = ReplaceCharWithEscapedChar( ExportedStatus );
 
-// 		CSVFileWriter->Logf( TEXT( "%s,%s,%s,%s,%s" ),
-// 			*ExportedKey,
-// 			*LazyWrap( ExportedTranslation, bQuote),
-// 			*LazyWrap( ExportedComment, bQuote ),
-// 			*LazyWrap( ExportedPrimary, bQuote ),
-// 			*LazyWrap( ExportedStatus, bQuote ) );
+		// RFC 4180 specifies that double quotes are escaped as ""
+		Writer.AddCell( Entry.Key, false );
+		Writer.AddCell( Entry.Translation );
+		Writer.AddCell( Entry.GetComment( StringPool ) );
+		Writer.AddCell( Entry.GetPrimary( StringPool ) );
+		Writer.AddCell( Status );
+		Writer.EndRow();
+	}
+	const TArray<uint8>& Output = Writer.GetOutput();
 
-		FString CSVEntry = FString::Printf(TEXT("%s,%s,%s,%s,%s"),
-			*ExportedKey,
-			*LazyWrap(ExportedTranslation, bQuote),
-			*LazyWrap(ExportedComment, bQuote),
-			*LazyWrap(ExportedPrimary, bQuote),
-			*LazyWrap(ExportedStatus, bQuote));
+	IFileManager& FileManager = IFileManager::Get();
 
-		FTCHARToUTF8 UTF8String(*(MoveTemp(CSVEntry) + LINE_TERMINATOR));
-		CSVFileWriter->Serialize((UTF8CHAR*)UTF8String.Get(), UTF8String.Length());
+	const int64 ExistingSize = FileManager.FileSize( *Filename );
+	if ( ExistingSize == Output.Num() )
+	{
+		TArray<uint8> Existing;
+		if ( FFileHelper::LoadFileToArray( Existing, *Filename, FILEREAD_Silent )
+			&& Existing.Num() == Output.Num()
+			&& FMemory::Memcmp( Existing.GetData(), Output.GetData(), Output.Num() ) == 0 )
+		{
+			BYG_UPDATE_LOG( Verbose, TEXT( "\"%s\" is unchanged, not writing" ), *Filename );
+			return true;
+		}
 	}
 
-	CSVFileWriter->Close();
+	// Written next to the original then swapped in, so a crash never leaves a half-written translation
+	const FString TempFilename = Filename + TEXT( ".tmp" );
+	if ( !FFileHelper::SaveArrayToFile( Output, *TempFilename, &FileManager, FILEWRITE_EvenIfReadOnly ) )
+	{
+		BYG_UPDATE_LOG( Error, TEXT( "Unable to open csv file \"%s\"." ), *TempFilename );
+		FileManager.Delete( *TempFilename, false, true, true );
+		return false;
+	}
+
+	// Copied rather than renamed, so the original stays in place until the new file replaces it
+	const bool bHadOriginal = ExistingSize >= 0;
+	if ( bHadOriginal && Settings->bCreateBackup )
+	{
+		const FString BackupFilename = GetBackupFilename( Filename );
+		if ( FileManager.Copy( *BackupFilename, *Filename, true, true ) != COPY_OK )
+		{
+			BYG_UPDATE_LOG( Error, TEXT( "Unable to back up \"%s\" to \"%s\"." ), *Filename, *BackupFilename );
+			FileManager.Delete( *TempFilename, false, true, true );
+			return false;
+		}
+	}
+
+	if ( !FileManager.Move( *Filename, *TempFilename, true, true, false, true ) )
+	{
+		// Only remove the new text if the original is still there
+		if ( FileManager.FileExists( *Filename ) )
+		{
+			BYG_UPDATE_LOG( Error, TEXT( "Unable to move \"%s\" to \"%s\"." ), *TempFilename, *Filename );
+			FileManager.Delete( *TempFilename, false, true, true );
+		}
+		else
+		{
+			BYG_UPDATE_LOG( Error, TEXT( "Unable to move \"%s\" to \"%s\", the new file was left at \"%s\"." ), *TempFilename, *Filename, *TempFilename );
+		}
+		return false;
+	}
 
-	return !CSVFileWriter->IsError();
+	if ( bOutChanged )
+	{
+		*bOutChanged = true;
+	}
+	return true;
 }
 
 TArray<FBYGLocaleInfo> UBYGLocalization::GetAvailableLocalizations(TOptional<FString> LocaleFilter, TOptional<FString> CategoryFilter) const
 {
 	UE_LOG(LogBYGLocalization, VeryVerbose, TEXT("GetAvailableLocalizations"));
-	TArray<FBYGLocaleInfo> Localizations;
+	if ( LocaleFilter.IsSet() && CategoryFilter.IsSet() )
+	{
+		FBYGLocaleInfo Found;
+		if ( Catalog->Find( LocaleFilter.GetValue(), CategoryFilter.GetValue(), Found ) )
+			return { Found };
+		return {};
+	}
 
-	const TArray<FString> Files = GetAllLocalizationFiles();
-	for ( const FString& FileWithPath : Files )
+	TArray<FBYGLocaleInfo> Localizations = LocaleFilter.IsSet() ? Catalog->GetForLocale( LocaleFilter.GetValue() ) : Catalog->GetAll();
+	if ( CategoryFilter.IsSet() )
 	{
-		FBYGLocaleInfo Basic = GetCultureFromFilename( FileWithPath );
-		if ((LocaleFilter.IsSet() && Basic.LocaleCode != LocaleFilter.GetValue()) || (CategoryFilter.IsSet() && Basic.Category != CategoryFilter.GetValue()))
-		{
-			continue;
-		}
-		//const FString FullPath = FPaths::Combine( FPaths::ProjectContentDir(), FileWithPath );
-		Localizations.Add( Basic );
+		Localizations.RemoveAll( [&CategoryFilter]( const FBYGLocaleInfo& Info ) { return Info.Category != CategoryFilter.GetValue(); } );
 	}
 
 	return Localizations;
 }
 
+bool UBYGLocalization::FindLocalization( const FString& LocaleCode, const FString& Category, FBYGLocaleInfo& OutInfo ) const
+{
+	return Catalog->Find( LocaleCode, Category, OutInfo );
+}
+
+void UBYGLocalization::InvalidateLocalizationCatalog()
+{
+	Catalog->Invalidate();
+}
+
+void UBYGLocalization::AddLocalizationFile( const FString& FileWithPath )
+{
+	Catalog->AddFile( FileWithPath );
+}
+
 
 
 bool UBYGLocalization::GetLocaleFromPreferences( FBYGLocaleInfo& FoundLocale ) const
@@ -886,20 +1022,9 @@ FBYGLocaleInfo UBYGLocalization::GetCultureFromFilename( const FString& FileWith
 
 	SplitCategoryAndCulture(CategoryAndLocaleCode, Category, LocaleCode);
 
-	FText LocalizedName;
-	const FCulturePtr FoundCulture = FInternationalization::Get().GetCulture( LocaleCode );
-	if ( FoundCulture.IsValid() && LocaleCode != "debug")
-	{
-		LocalizedName = FText::FromString( FoundCulture->GetNativeLanguage() );
-	}
-	else
-	{
-		// Couldn't find localized name, just show raw filename
-		LocalizedName = FText::FromString( LocaleCode );
-	}
 	FBYGLocaleInfo Info {
 		LocaleCode,
-		LocalizedName,
+		GetLocalizedLocaleName( LocaleCode ),
 		Category,
 		FileWithPath
 	};
@@ -907,6 +1032,18 @@ FBYGLocaleInfo UBYGLocalization::GetCultureFromFilename( const FString& FileWith
 	return Info;
 }
 
+FText UBYGLocalization::GetLocalizedLocaleName( const FString& LocaleCode )
+{
+	const FCulturePtr FoundCulture = FInternationalization::Get().GetCulture( LocaleCode );
+	if ( FoundCulture.IsValid() && LocaleCode != "debug")
+	{
+		return FText::FromString( FoundCulture->GetNativeLanguage() );
+	}
+
+	// Couldn't find localized name, just show raw filename
+	return FText::FromString( LocaleCode );
+}
+
 
 bool UBYGLocalization::GetAuthorForLocale( const FString& Filename, FText& Author ) const
 {
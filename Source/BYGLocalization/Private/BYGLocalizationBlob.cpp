@@ -0,0 +1,346 @@
+// Copyright 2017-2021 Brace Yourself Games. All Rights Reserved.
+
+#include "BYGLocalizationBlob.h"
+#include "BYGLocalizationCoreMinimal.h"
+#include "BYGLocalizationHash.h"
+
+#include "Async/MappedFileHandle.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFilemanager.h"
+#include "HAL/PlatformProperties.h"
+#include "Internationalization/StringTableCore.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/Csv/CsvParser.h"
+
+static const TCHAR* BlobColumnNames[ (int32)EBYGLocBlobField::Count ] =
+{
+	TEXT( "Key" ),
+	TEXT( "SourceString" ),
+	TEXT( "Comment" ),
+	TEXT( "Primary" ),
+	TEXT( "Status" ),
+};
+
+FBYGLocalizationBlob::FBYGLocalizationBlob()
+{
+}
+
+FBYGLocalizationBlob::~FBYGLocalizationBlob()
+{
+	Reset();
+}
+
+void FBYGLocalizationBlob::Reset()
+{
+	Header = nullptr;
+	Entries = nullptr;
+	HashSlots = nullptr;
+	StringPool = nullptr;
+
+	// Region must be released before the handle that owns it
+	MappedRegion.Reset();
+	MappedHandle.Reset();
+	Data.Empty();
+}
+
+FString FBYGLocalizationBlob::GetBlobFilename( const FString& SourceFilename )
+{
+	return FPaths::ChangeExtension( SourceFilename, TEXT( "bygloc" ) );
+}
+
+bool FBYGLocalizationBlob::Compile( const FString& SourceFilename, const FString& BlobFilename )
+{
+	QUICK_SCOPE_CYCLE_COUNTER( STAT_BYGLocalization_CompileBlob );
+
+	// Taken before reading, so a save while compiling leaves a blob that looks out of date rather than one that doesn't
+	const FFileStatData SourceStat = IFileManager::Get().GetStatData( *SourceFilename );
+
+	TArray<uint8> SourceBytes;
+	if ( !SourceStat.bIsValid || !FFileHelper::LoadFileToArray( SourceBytes, *SourceFilename ) )
+	{
+		UE_LOG( LogBYGLocalization, Error, TEXT( "Failed to load file '%s'" ), *SourceFilename );
+		return false;
+	}
+
+	FString CSVString;
+	FFileHelper::BufferToString( CSVString, SourceBytes.GetData(), SourceBytes.Num() );
+
+	const FCsvParser Parser( CSVString );
+	const FCsvParser::FRows& Rows = Parser.GetRows();
+
+	// Match columns by name the same way FStringTable::ImportStrings does
+	int32 Columns[ (int32)EBYGLocBlobField::Count ];
+	for ( int32 Field = 0; Field < (int32)EBYGLocBlobField::Count; ++Field )
+	{
+		Columns[ Field ] = INDEX_NONE;
+	}
+	if ( Rows.Num() > 0 )
+	{
+		for ( int32 Cell = 0; Cell < Rows[ 0 ].Num(); ++Cell )
+		{
+			for ( int32 Field = 0; Field < (int32)EBYGLocBlobField::Count; ++Field )
+			{
+				if ( Columns[ Field ] == INDEX_NONE && FCString::Stricmp( Rows[ 0 ][ Cell ], BlobColumnNames[ Field ] ) == 0 )
+				{
+					Columns[ Field ] = Cell;
+					break;
+				}
+			}
+		}
+	}
+	if ( Columns[ (int32)EBYGLocBlobField::Key ] == INDEX_NONE || Columns[ (int32)EBYGLocBlobField::SourceString ] == INDEX_NONE )
+	{
+		UE_LOG( LogBYGLocalization, Error, TEXT( "'%s' is missing a 'Key' or 'SourceString' column, cannot compile" ), *SourceFilename );
+		return false;
+	}
+
+	TArray<FEntry> NewEntries;
+	NewEntries.Reserve( Rows.Num() );
+	TArray<TCHAR> NewStringPool;
+	NewStringPool.Reserve( CSVString.Len() );
+
+	// Note that we skip the header
+	for ( int32 i = 1; i < Rows.Num(); ++i )
+	{
+		const TArray<const TCHAR*>& Row = Rows[ i ];
+		if ( !Row.IsValidIndex( Columns[ (int32)EBYGLocBlobField::Key ] ) || !Row.IsValidIndex( Columns[ (int32)EBYGLocBlobField::SourceString ] ) )
+			continue;
+
+		if ( *Row[ Columns[ (int32)EBYGLocBlobField::Key ] ] == TEXT( '\0' ) )
+			continue;
+
+		FEntry Entry;
+		for ( int32 Field = 0; Field < (int32)EBYGLocBlobField::Count; ++Field )
+		{
+			FString Value = Row.IsValidIndex( Columns[ Field ] ) ? Row[ Columns[ Field ] ] : TEXT( "" );
+			Value.ReplaceEscapedCharWithCharInline();
+
+			Entry.Fields[ Field ].Offset = NewStringPool.Num();
+			Entry.Fields[ Field ].Length = Value.Len();
+			NewStringPool.Append( *Value, Value.Len() );
+		}
+		NewEntries.Add( Entry );
+	}
+
+	TArray<FHashSlot> NewHashSlots;
+	NewHashSlots.Reserve( NewEntries.Num() );
+	for ( int32 i = 0; i < NewEntries.Num(); ++i )
+	{
+		const FPoolString& Key = NewEntries[ i ].Fields[ (int32)EBYGLocBlobField::Key ];
+		const uint64 KeyHash = FBYGLocalizationHash::HashTextKey( FStringView( NewStringPool.GetData() + Key.Offset, Key.Length ) );
+		NewHashSlots.Add( { KeyHash, i, 0 } );
+	}
+	NewHashSlots.Sort( []( const FHashSlot& A, const FHashSlot& B )
+	{
+		return A.KeyHash < B.KeyHash || ( A.KeyHash == B.KeyHash && A.EntryIndex < B.EntryIndex );
+	} );
+
+	FHeader NewHeader;
+	NewHeader.Magic = Magic;
+	NewHeader.Version = Version;
+	NewHeader.SourceTimestamp = SourceStat.ModificationTime.GetTicks();
+	NewHeader.SourceSize = SourceStat.FileSize;
+	NewHeader.NumEntries = NewEntries.Num();
+	NewHeader.StringPoolLength = NewStringPool.Num();
+	NewHeader.CharSize = sizeof( TCHAR );
+	NewHeader.Reserved = 0;
+
+	TArray<uint8> Output;
+	Output.Reserve( sizeof( FHeader ) + NewEntries.Num() * ( sizeof( FEntry ) + sizeof( FHashSlot ) ) + NewStringPool.Num() * sizeof( TCHAR ) );
+	Output.Append( reinterpret_cast<const uint8*>( &NewHeader ), sizeof( FHeader ) );
+	Output.Append( reinterpret_cast<const uint8*>( NewEntries.GetData() ), NewEntries.Num() * sizeof( FEntry ) );
+	Output.Append( reinterpret_cast<const uint8*>( NewHashSlots.GetData() ), NewHashSlots.Num() * sizeof( FHashSlot ) );
+	Output.Append( reinterpret_cast<const uint8*>( NewStringPool.GetData() ), NewStringPool.Num() * sizeof( TCHAR ) );
+
+	if ( !FFileHelper::SaveArrayToFile( Output, *BlobFilename ) )
+	{
+		UE_LOG( LogBYGLocalization, Error, TEXT( "Failed to write compiled localization '%s'" ), *BlobFilename );
+		return false;
+	}
+
+	UE_LOG( LogBYGLocalization, Verbose, TEXT( "Compiled '%s' to '%s' (%d entries)" ), *SourceFilename, *BlobFilename, NewEntries.Num() );
+	return true;
+}
+
+bool FBYGLocalizationBlob::LoadFromFile( const FString& BlobFilename, const FString& SourceFilename )
+{
+	QUICK_SCOPE_CYCLE_COUNTER( STAT_BYGLocalization_LoadBlob );
+
+	Reset();
+	if ( !FFileHelper::LoadFileToArray( Data, *BlobFilename, FILEREAD_Silent ) )
+	{
+		return false;
+	}
+
+	return SetDataIfUpToDate( Data.GetData(), Data.Num(), BlobFilename, SourceFilename );
+}
+
+bool FBYGLocalizationBlob::MapFile( const FString& BlobFilename, const FString& SourceFilename )
+{
+	QUICK_SCOPE_CYCLE_COUNTER( STAT_BYGLocalization_MapBlob );
+
+	Reset();
+
+	MappedHandle.Reset( FPlatformFileManager::Get().GetPlatformFile().OpenMapped( *BlobFilename ) );
+	if ( MappedHandle.IsValid() )
+	{
+		MappedRegion.Reset( MappedHandle->MapRegion() );
+	}
+	if ( !MappedRegion.IsValid() )
+	{
+		MappedHandle.Reset();
+		return LoadFromFile( BlobFilename, SourceFilename );
+	}
+
+	return SetDataIfUpToDate( MappedRegion->GetMappedPtr(), MappedRegion->GetMappedSize(), BlobFilename, SourceFilename );
+}
+
+bool FBYGLocalizationBlob::SetDataIfUpToDate( const uint8* InData, int64 InSize, const FString& BlobFilename, const FString& SourceFilename )
+{
+	if ( !SetData( InData, InSize ) )
+	{
+		UE_LOG( LogBYGLocalization, Warning, TEXT( "Compiled localization '%s' is invalid or from an older version, falling back to CSV" ), *BlobFilename );
+		Reset();
+		return false;
+	}
+
+	if ( !IsSourceUnchanged( SourceFilename, Header->SourceSize, Header->SourceTimestamp ) )
+	{
+		UE_LOG( LogBYGLocalization, Log, TEXT( "Compiled localization '%s' is out of date, falling back to CSV" ), *BlobFilename );
+		Reset();
+		return false;
+	}
+
+	return true;
+}
+
+bool FBYGLocalizationBlob::SetData( const uint8* InData, int64 InSize )
+{
+	Header = nullptr;
+
+	if ( InSize < (int64)sizeof( FHeader ) )
+		return false;
+
+	const FHeader* NewHeader = reinterpret_cast<const FHeader*>( InData );
+	if ( NewHeader->Magic != Magic
+		|| NewHeader->Version != Version
+		|| NewHeader->CharSize != sizeof( TCHAR )
+		|| NewHeader->NumEntries < 0
+		|| NewHeader->StringPoolLength < 0 )
+	{
+		return false;
+	}
+
+	const int64 EntriesOffset = sizeof( FHeader );
+	const int64 HashSlotsOffset = EntriesOffset + (int64)NewHeader->NumEntries * sizeof( FEntry );
+	const int64 StringPoolOffset = HashSlotsOffset + (int64)NewHeader->NumEntries * sizeof( FHashSlot );
+	const int64 ExpectedSize = StringPoolOffset + (int64)NewHeader->StringPoolLength * sizeof( TCHAR );
+	if ( InSize != ExpectedSize )
+		return false;
+
+	// Offsets are validated as they are used rather than here, so a mapped blob only pages in what is looked up
+	Header = NewHeader;
+	Entries = reinterpret_cast<const FEntry*>( InData + EntriesOffset );
+	HashSlots = reinterpret_cast<const FHashSlot*>( InData + HashSlotsOffset );
+	StringPool = reinterpret_cast<const TCHAR*>( InData + StringPoolOffset );
+	return true;
+}
+
+bool FBYGLocalizationBlob::IsSourceUnchanged( const FString& SourceFilename, int64 ExpectedSize, int64 ExpectedTimestamp )
+{
+	// Cooked builds can't change their CSVs, and a stat per file adds up on consoles
+	if ( FPlatformProperties::RequiresCookedData() )
+	{
+		return true;
+	}
+
+	const FFileStatData SourceStat = IFileManager::Get().GetStatData( *SourceFilename );
+	if ( !SourceStat.bIsValid )
+	{
+		// Only the compiled file was shipped
+		return true;
+	}
+	return SourceStat.FileSize == ExpectedSize && SourceStat.ModificationTime.GetTicks() == ExpectedTimestamp;
+}
+
+FStringView FBYGLocalizationBlob::GetField( int32 EntryIndex, EBYGLocBlobField Field ) const
+{
+	check( Header && EntryIndex >= 0 && EntryIndex < Header->NumEntries );
+	const FPoolString& PoolString = Entries[ EntryIndex ].Fields[ (int32)Field ];
+	if ( (int64)PoolString.Offset + PoolString.Length > Header->StringPoolLength )
+	{
+		UE_LOG( LogBYGLocalization, Error, TEXT( "Corrupt compiled localization, entry %d is out of bounds" ), EntryIndex );
+		return FStringView();
+	}
+	return FStringView( StringPool + PoolString.Offset, PoolString.Length );
+}
+
+int32 FBYGLocalizationBlob::FindEntry( FStringView Key ) const
+{
+	if ( !Header )
+		return INDEX_NONE;
+
+	const uint64 KeyHash = FBYGLocalizationHash::HashTextKey( Key );
+
+	// Lower bound
+	int32 First = 0;
+	int32 Count = Header->NumEntries;
+	while ( Count > 0 )
+	{
+		const int32 Step = Count / 2;
+		if ( HashSlots[ First + Step ].KeyHash < KeyHash )
+		{
+			First += Step + 1;
+			Count -= Step + 1;
+		}
+		else
+		{
+			Count = Step;
+		}
+	}
+
+	// Duplicate keys resolve to the last one in the file, the same as FStringTable::ImportStrings
+	int32 Found = INDEX_NONE;
+	for ( int32 i = First; i < Header->NumEntries && HashSlots[ i ].KeyHash == KeyHash; ++i )
+	{
+		const int32 EntryIndex = HashSlots[ i ].EntryIndex;
+		if ( EntryIndex >= 0 && EntryIndex < Header->NumEntries && GetField( EntryIndex, EBYGLocBlobField::Key ).Equals( Key, ESearchCase::CaseSensitive ) )
+		{
+			Found = FMath::Max( Found, EntryIndex );
+		}
+	}
+	return Found;
+}
+
+FStringTableRef FBYGLocalizationBlob::CreateStringTable( const FString& Namespace, bool bFallBackToPrimary ) const
+{
+	QUICK_SCOPE_CYCLE_COUNTER( STAT_BYGLocalization_CreateStringTableFromBlob );
+
+	static const FName MetaDataNames[] = { FName( TEXT( "Comment" ) ), FName( TEXT( "Primary" ) ), FName( TEXT( "Status" ) ) };
+
+	FStringTableRef StringTable = FStringTable::NewStringTable();
+	StringTable->SetNamespace( Namespace );
+
+	for ( int32 i = 0; i < Num(); ++i )
+	{
+		const FString Key( GetField( i, EBYGLocBlobField::Key ) );
+
+		const FStringView SourceString = GetDisplayString( i, bFallBackToPrimary );
+		if ( !SourceString.IsEmpty() )
+		{
+			StringTable->SetSourceString( Key, FString( SourceString ) );
+		}
+
+		for ( int32 MetaData = 0; MetaData < UE_ARRAY_COUNT( MetaDataNames ); ++MetaData )
+		{
+			const FStringView Value = GetField( i, (EBYGLocBlobField)( (int32)EBYGLocBlobField::Comment + MetaData ) );
+			if ( !Value.IsEmpty() )
+			{
+				StringTable->SetMetaData( Key, MetaDataNames[ MetaData ], FString( Value ) );
+			}
+		}
+	}
+
+	return StringTable;
+}
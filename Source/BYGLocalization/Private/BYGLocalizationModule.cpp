@@ -3,13 +3,188 @@
 #include "BYGLocalizationModule.h"
 #include "BYGLocalizationSettings.h"
 #include "BYGLocalization.h"
+#include "BYGLocalizationBlob.h"
+#include "BYGMappedLocale.h"
+#include "BYGCsvReader.h"
+#include "BYGPseudoLocalizer.h"
+#include "BYGStatusScanner.h"
+#include "BYGVirtualLocale.h"
 
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "HAL/FileManager.h"
+#include "Internationalization/StringTableCore.h"
 #include "Internationalization/StringTableRegistry.h"
 #include "Misc/CommandLine.h"
 #include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "Tasks/Task.h"
 
 #define LOCTEXT_NAMESPACE "BYGLocalizationModule"
 
+std::atomic<uint32> FBYGLocalizationModule::StringTableGeneration { 0 };
+
+// Every category's string table for one language. Built on a worker thread, then kept in the warm locale cache so
+// switching back to the language only has to register the tables again
+struct FBYGLocaleTableSet
+{
+	FString Code;
+	// The language the files are read for, which is the primary language for virtual locales
+	FString FileCode;
+	// Only set for virtual locales
+	TSharedPtr<const FBYGVirtualLocaleTransform, ESPMode::ThreadSafe> VirtualTransform;
+	TArray<FString> Categories;
+	// Relative to the project content directory, empty if the category has no file for this language
+	TArray<FString> FilePaths;
+	TArray<FBYGPreparedStringTable> Tables;
+	int64 MemoryBytes = 0;
+
+	// Only touched on the game thread
+	bool bReady = false;
+	// Called on the game thread once built, with null if the module has shut down by then
+	TArray<TUniqueFunction<void( FBYGLocalizationModule* Module )>> OnReady;
+};
+
+// Rough size of a string table, for keeping the warm locale cache under its memory limit
+static int64 EstimateMemory( const FBYGPreparedStringTable& Prepared )
+{
+	int64 Bytes = 0;
+	if ( Prepared.StringTable.IsValid() )
+	{
+		Prepared.StringTable->EnumerateSourceStrings( [&Bytes]( const FString& Key, const FString& SourceString )
+		{
+			// Plus the entry itself and its slot in the table's map
+			Bytes += Key.GetAllocatedSize() + SourceString.GetAllocatedSize() + 64;
+			return true;
+		} );
+	}
+	if ( Prepared.MappedLocale.IsValid() )
+	{
+		// Mapped pages can be dropped by the OS, so only blobs that were read into memory count
+		Bytes += Prepared.MappedLocale->GetBlob().GetAllocatedSize();
+	}
+	return Bytes;
+}
+
+// True if both tables show the same text for every key. Metadata isn't compared, it's never displayed
+static bool HasSameText( const FBYGPreparedStringTable& A, const FBYGPreparedStringTable& B )
+{
+	if ( A.StringTable.IsValid() && B.StringTable.IsValid() )
+	{
+		int32 NumA = 0;
+		bool bSame = true;
+		A.StringTable->EnumerateSourceStrings( [&]( const FString& Key, const FString& SourceString )
+		{
+			++NumA;
+			FString OtherSourceString;
+			bSame = B.StringTable->GetSourceString( Key, OtherSourceString ) && OtherSourceString.Equals( SourceString, ESearchCase::CaseSensitive );
+			return bSame;
+		} );
+
+		int32 NumB = 0;
+		B.StringTable->EnumerateSourceStrings( [&NumB]( const FString& Key, const FString& SourceString )
+		{
+			++NumB;
+			return true;
+		} );
+		return bSame && NumA == NumB;
+	}
+
+	if ( A.MappedLocale.IsValid() && B.MappedLocale.IsValid() )
+	{
+		const FBYGLocalizationBlob& BlobA = A.MappedLocale->GetBlob();
+		const FBYGLocalizationBlob& BlobB = B.MappedLocale->GetBlob();
+		if ( BlobA.Num() != BlobB.Num() )
+			return false;
+
+		for ( int32 Index = 0; Index < BlobA.Num(); ++Index )
+		{
+			for ( const EBYGLocBlobField Field : { EBYGLocBlobField::Key, EBYGLocBlobField::SourceString, EBYGLocBlobField::Primary } )
+			{
+				if ( !BlobA.GetField( Index, Field ).Equals( BlobB.GetField( Index, Field ), ESearchCase::CaseSensitive ) )
+					return false;
+			}
+		}
+		return true;
+	}
+
+	return !A.StringTable.IsValid() && !B.StringTable.IsValid() && !A.MappedLocale.IsValid() && !B.MappedLocale.IsValid();
+}
+
+// What FStringTable::ImportStrings does, in a single streaming pass. With bFallBackToPrimary, untranslated keys use
+// their Primary column instead of being left out, see UBYGLocalizationSettings::bUseEmbeddedPrimaryFallback
+static void ImportStringsFromCsv( FStringTable& StringTable, const FString& Filename, bool bFallBackToPrimary )
+{
+	QUICK_SCOPE_CYCLE_COUNTER( STAT_BYGLocalization_ImportStringsFromCsv );
+
+	int32 KeyColumn = INDEX_NONE;
+	int32 SourceStringColumn = INDEX_NONE;
+	int32 PrimaryColumn = INDEX_NONE;
+	// Every other column is stored as metadata named after its header
+	TArray<TPair<int32, FName>> MetaDataColumns;
+
+	FBYGCsvReader Reader;
+	const bool bRead = Reader.ReadFile( Filename, [&]( const FBYGCsvRow& Row )
+	{
+		if ( Row.Index == 0 )
+		{
+			for ( int32 i = 0; i < FMath::Min( Row.Num(), 64 ); ++i )
+			{
+				const FString Column = Row.GetString( i );
+				if ( KeyColumn == INDEX_NONE && Column.Equals( TEXT( "Key" ), ESearchCase::IgnoreCase ) )
+				{
+					KeyColumn = i;
+				}
+				else if ( SourceStringColumn == INDEX_NONE && Column.Equals( TEXT( "SourceString" ), ESearchCase::IgnoreCase ) )
+				{
+					SourceStringColumn = i;
+				}
+				else
+				{
+					if ( PrimaryColumn == INDEX_NONE && Column.Equals( TEXT( "Primary" ), ESearchCase::IgnoreCase ) )
+					{
+						PrimaryColumn = i;
+					}
+					MetaDataColumns.Emplace( i, FName( *Column ) );
+				}
+			}
+			if ( KeyColumn == INDEX_NONE || SourceStringColumn == INDEX_NONE )
+			{
+				UE_LOG( LogBYGLocalization, Warning, TEXT( "'%s' is missing a 'Key' or 'SourceString' column" ), *Filename );
+				return false;
+			}
+			return true;
+		}
+
+		if ( Row[ KeyColumn ].IsEmpty() )
+			return true;
+
+		FString SourceString = Row.GetString( SourceStringColumn ).ReplaceEscapedCharWithChar();
+		if ( SourceString.IsEmpty() && bFallBackToPrimary && PrimaryColumn != INDEX_NONE )
+		{
+			SourceString = Row.GetString( PrimaryColumn ).ReplaceEscapedCharWithChar();
+		}
+		if ( SourceString.IsEmpty() )
+			return true;
+
+		const FString Key = Row.GetString( KeyColumn ).ReplaceEscapedCharWithChar();
+		StringTable.SetSourceString( Key, MoveTemp( SourceString ) );
+		for ( const TPair<int32, FName>& MetaDataColumn : MetaDataColumns )
+		{
+			if ( !Row[ MetaDataColumn.Key ].IsEmpty() )
+			{
+				StringTable.SetMetaData( Key, MetaDataColumn.Value, Row.GetString( MetaDataColumn.Key ).ReplaceEscapedCharWithChar() );
+			}
+		}
+		return true;
+	} );
+
+	if ( !bRead )
+	{
+		UE_LOG( LogBYGLocalization, Warning, TEXT( "Failed to load file '%s'" ), *Filename );
+	}
+}
+
 void FBYGLocalizationModule::StartupModule()
 {
 	UE_LOG(LogBYGLocalization, Log, TEXT("Initialize module"));
@@ -36,15 +211,34 @@ void FBYGLocalizationModule::StartupModule()
 	{
 		Loc->UpdateTranslations();
 	}
+	if ( Settings->bUseCompiledLocalizations )
+	{
+		Loc->CompileLocalizations();
+	}
 #endif
 
 	UE_LOG(LogBYGLocalization, Log, TEXT("Reload Localizations"));
 	CurrentLanguageCode = Settings->PrimaryLanguageCode;
 	ReloadLocalizations();
+
+	UpdateDebugLocale();
+
+	Loc->OnLocalizationFileModified.AddRaw( this, &FBYGLocalizationModule::OnLocalizationFileModified );
+#if BYG_LOCALIZATION_POLL_FILES
+	PollFilesHandle = FTSTicker::GetCoreTicker().AddTicker( FTickerDelegate::CreateRaw( this, &FBYGLocalizationModule::PollLocalizationFiles ), 1.0f );
+#endif
 }
 
 void FBYGLocalizationModule::ShutdownModule()
 {
+#if BYG_LOCALIZATION_POLL_FILES
+	FTSTicker::GetCoreTicker().RemoveTicker( PollFilesHandle );
+#endif
+	if ( Loc.IsValid() )
+	{
+		Loc->OnLocalizationFileModified.RemoveAll( this );
+	}
+
 	// Using this because GetDefault<UBYGLocalizationSettings>() is not valid inside ShutdownModule
 	UnloadLocalizations();
 
@@ -54,50 +248,655 @@ void FBYGLocalizationModule::ShutdownModule()
 void FBYGLocalizationModule::ReloadLocalizations()
 {
 	UnloadLocalizations();
+	FBYGStatusScanner::ClearCache();
+
+	// Dropped the same way as after a language change, they were started from the old tables
+	++LanguageChangeGeneration;
+
+	// Loaded like any other language, so it's kept in the warm locale cache and hot reloads know which tables are in
+	// use. Virtual locales are made from the primary's tables here too
+	const FString Code = IsLanguageInUse( CurrentLanguageCode ) ? CurrentLanguageCode : UBYGLocalizationSettings::Get()->PrimaryLanguageCode;
+	TSharedRef<FBYGLocaleTableSet, ESPMode::ThreadSafe> TableSet = MakeTableSet( Code );
+	BuildTableSet( *TableSet );
+	TableSet->bReady = true;
+	WarmLocales.Insert( TableSet, 0 );
+
+	// Unlike a language change the culture is left alone, reloading doesn't change which language is picked
+	RegisterTableSet( TableSet );
+	Loc->CallOnLocalizationChanged();
+	TrimWarmLocales();
+}
+
+void FBYGLocalizationModule::LoadStringTable( const FName& TableID, const FString& Category, const FString& FilePath )
+{
+	RegisterStringTable( PrepareStringTable( TableID, Category, FilePath ) );
+}
+
+FBYGPreparedStringTable FBYGLocalizationModule::PrepareStringTable( const FName& TableID, const FString& Category, const FString& FilePath )
+{
+	QUICK_SCOPE_CYCLE_COUNTER( STAT_BYGLocalization_PrepareStringTable );
+
+	const UBYGLocalizationSettings* Settings = UBYGLocalizationSettings::Get();
+
+	FBYGPreparedStringTable Prepared;
+	Prepared.TableID = TableID;
+
+	if ( Settings->bUseCompiledLocalizations )
+	{
+		const FString SourceFilename = FPaths::Combine( FPaths::ProjectContentDir(), FilePath );
+		const FString BlobFilename = FBYGLocalizationBlob::GetBlobFilename( SourceFilename );
+
+		if ( Settings->bMemoryMapCompiledLocalizations )
+		{
+			TSharedPtr<FBYGMappedLocale> MappedLocale = MakeShared<FBYGMappedLocale>();
+			MappedLocale->SetFallBackToPrimary( Settings->bUseEmbeddedPrimaryFallback );
+			if ( MappedLocale->Map( BlobFilename, SourceFilename ) )
+			{
+#if WITH_EDITOR
+				// The editor still needs a real string table to pick keys for FText properties
+				Prepared.StringTable = MappedLocale->GetBlob().CreateStringTable( Category, Settings->bUseEmbeddedPrimaryFallback );
+#endif
+				Prepared.MappedLocale = MappedLocale;
+				return Prepared;
+			}
+		}
+		else
+		{
+			FBYGLocalizationBlob Blob;
+			if ( Blob.LoadFromFile( BlobFilename, SourceFilename ) )
+			{
+				Prepared.StringTable = Blob.CreateStringTable( Category, Settings->bUseEmbeddedPrimaryFallback );
+				return Prepared;
+			}
+		}
+	}
+
+	// What FStringTableRegistry::Internal_LocTableFromFile does, without registering the table
+	FStringTableRef StringTable = FStringTable::NewStringTable();
+	StringTable->SetNamespace( Category );
+	ImportStringsFromCsv( *StringTable, FPaths::Combine( FPaths::ProjectContentDir(), FilePath ), Settings->bUseEmbeddedPrimaryFallback );
+	Prepared.StringTable = StringTable;
+	return Prepared;
+}
+
+void FBYGLocalizationModule::RegisterStringTable( const FBYGPreparedStringTable& Prepared )
+{
+	check( IsInGameThread() );
+
+	// Replaces whatever was registered under the same ID
+	MappedTables.Remove( Prepared.TableID );
+	if ( Prepared.MappedLocale.IsValid() )
+	{
+		MappedTables.Add( Prepared.TableID, Prepared.MappedLocale );
+	}
+	VirtualTables.Remove( Prepared.TableID );
+	if ( Prepared.VirtualLocale.IsValid() )
+	{
+		VirtualTables.Add( Prepared.TableID, Prepared.VirtualLocale );
+	}
+
+	if ( Prepared.StringTable.IsValid() )
+	{
+		FStringTableRegistry::Get().RegisterStringTable( Prepared.TableID, Prepared.StringTable.ToSharedRef() );
+	}
+	else
+	{
+		FStringTableRegistry::Get().UnregisterStringTable( Prepared.TableID );
+	}
+	NotifyStringTablesChanged();
+}
+
+bool FBYGLocalizationModule::IsLanguageInUse( const FString& Code ) const
+{
+	const UBYGLocalizationSettings* Settings = UBYGLocalizationSettings::Get();
+	return Code == Settings->PrimaryLanguageCode || Settings->LanguageCodesInUse.Contains( Code ) || IsVirtualLocale( Code );
+}
+
+FString FBYGLocalizationModule::GetFileLanguageCode( const FString& Code ) const
+{
+	return IsVirtualLocale( Code ) ? UBYGLocalizationSettings::Get()->PrimaryLanguageCode : Code;
+}
+
+FBYGPreparedStringTable FBYGLocalizationModule::MakeVirtualStringTable( const FBYGPreparedStringTable& Source, const TSharedRef<const FBYGVirtualLocaleTransform, ESPMode::ThreadSafe>& Transform )
+{
+	FBYGPreparedStringTable Prepared;
+	Prepared.TableID = Source.TableID;
+	Prepared.VirtualLocale = MakeShared<FBYGVirtualLocale>( Transform );
+	Prepared.StringTable = Prepared.VirtualLocale->CreateStringTable( Source );
+	return Prepared;
+}
+
+void FBYGLocalizationModule::RegisterVirtualLocale( const FString& Code, FBYGVirtualLocaleTransform Transform )
+{
+	check( IsInGameThread() );
+
+	VirtualLocales.Add( Code, MakeShared<FBYGVirtualLocaleTransform, ESPMode::ThreadSafe>( MoveTemp( Transform ) ) );
+
+	// Anything kept loaded was made with the old transform
+	WarmLocales.RemoveAll( [&Code]( const TSharedRef<FBYGLocaleTableSet, ESPMode::ThreadSafe>& TableSet )
+	{
+		return TableSet->Code == Code;
+	} );
+	if ( CurrentLanguageCode == Code && Loc.IsValid() )
+	{
+		SetLanguage( Code );
+	}
+}
+
+void FBYGLocalizationModule::UnregisterVirtualLocale( const FString& Code )
+{
+	check( IsInGameThread() );
+
+	// If it's the current language it keeps working until the language is changed
+	VirtualLocales.Remove( Code );
+	WarmLocales.RemoveAll( [&Code, this]( const TSharedRef<FBYGLocaleTableSet, ESPMode::ThreadSafe>& TableSet )
+	{
+		return TableSet->Code == Code && TableSet != CurrentTableSet;
+	} );
+}
+
+void FBYGLocalizationModule::UpdateDebugLocale()
+{
+	const UBYGLocalizationSettings* Settings = UBYGLocalizationSettings::Get();
+	if ( !Settings->bUseVirtualDebugLocale )
+	{
+		UnregisterVirtualLocale( TEXT( "Debug" ) );
+		return;
+	}
+
+	const FBYGPseudoLocalizer PseudoLocalizer( FBYGPseudoLocalizer::GetOptionsFromSettings() );
+	RegisterVirtualLocale( TEXT( "Debug" ), [PseudoLocalizer]( FStringView SourceString, FString& OutString )
+	{
+		PseudoLocalizer.Localize( SourceString, OutString );
+	} );
+}
+
+bool FBYGLocalizationModule::SetLanguage( const FString& Code )
+{
+	if ( !IsLanguageInUse( Code ) )
+		return false;
+
+	++LanguageChangeGeneration;
+
+	TSharedPtr<FBYGLocaleTableSet, ESPMode::ThreadSafe> TableSet = FindWarmLocale( Code );
+	if ( TableSet.IsValid() && TableSet->bReady )
+	{
+		WarmLocaleStats.NumHits++;
+	}
+	else
+	{
+		// Waiting for a prefetch would mean waiting on the game thread for a task that finishes on the game thread,
+		// so build another one here and let it replace the prefetch
+		WarmLocaleStats.NumMisses++;
+		if ( TableSet.IsValid() )
+		{
+			WarmLocales.Remove( TableSet.ToSharedRef() );
+		}
+		TableSet = MakeTableSet( Code );
+		BuildTableSet( *TableSet );
+		TableSet->bReady = true;
+		WarmLocales.Insert( TableSet.ToSharedRef(), 0 );
+	}
+
+	ApplyTableSet( TableSet.ToSharedRef() );
+	TrimWarmLocales();
+	return true;
+}
+
+TFuture<bool> FBYGLocalizationModule::SetLanguageAsync( const FString& Code )
+{
+	if ( !IsLanguageInUse( Code ) )
+		return MakeFulfilledPromise<bool>( false ).GetFuture();
+
+	const uint32 Generation = ++LanguageChangeGeneration;
+
+	TSharedPtr<FBYGLocaleTableSet, ESPMode::ThreadSafe> TableSet = FindWarmLocale( Code );
+	if ( TableSet.IsValid() && TableSet->bReady )
+	{
+		// Already built, swapping the tables in is cheap enough to do straight away
+		WarmLocaleStats.NumHits++;
+		ApplyTableSet( TableSet.ToSharedRef() );
+		TrimWarmLocales();
+		return MakeFulfilledPromise<bool>( true ).GetFuture();
+	}
+
+	WarmLocaleStats.NumMisses++;
+	if ( !TableSet.IsValid() )
+	{
+		TableSet = StartLoadingLocale( Code );
+	}
+
+	TSharedRef<TPromise<bool>, ESPMode::ThreadSafe> Promise = MakeShared<TPromise<bool>, ESPMode::ThreadSafe>();
+	TFuture<bool> Future = Promise->GetFuture();
+	TWeakPtr<FBYGLocaleTableSet, ESPMode::ThreadSafe> WeakTableSet = TableSet;
+	TableSet->OnReady.Add( [Promise, Generation, WeakTableSet]( FBYGLocalizationModule* Module )
+	{
+		// Dropped if another language was set while this one was loading
+		TSharedPtr<FBYGLocaleTableSet, ESPMode::ThreadSafe> LoadedTableSet = WeakTableSet.Pin();
+		if ( !Module || !LoadedTableSet.IsValid() || Module->LanguageChangeGeneration != Generation )
+		{
+			Promise->SetValue( false );
+			return;
+		}
+
+		Module->ApplyTableSet( LoadedTableSet.ToSharedRef() );
+		Promise->SetValue( true );
+	} );
+
+	return Future;
+}
+
+void FBYGLocalizationModule::PrefetchLocale( const FString& Code )
+{
+	check( IsInGameThread() );
 
 	const UBYGLocalizationSettings* Settings = UBYGLocalizationSettings::Get();
+	if ( Settings->WarmLocaleCacheSize <= 0 || !IsLanguageInUse( Code ) )
+		return;
 
-	const TArray<FString> Categories = Settings->LocalizationCategories;
-	const TArray<FBYGLocaleInfo> Entries = Loc->GetAvailableLocalizations(CurrentLanguageCode);
+	if ( !FindWarmLocale( Code ).IsValid() )
+	{
+		StartLoadingLocale( Code );
+	}
+}
 
-	for (const FString Category : Categories)
+FBYGWarmLocaleStats FBYGLocalizationModule::GetWarmLocaleStats() const
+{
+	FBYGWarmLocaleStats Stats = WarmLocaleStats;
+	for ( const TSharedRef<FBYGLocaleTableSet, ESPMode::ThreadSafe>& TableSet : WarmLocales )
 	{
-		bool Found = false;
-		for (FBYGLocaleInfo Entry : Entries)
+		if ( TableSet->bReady )
+		{
+			Stats.NumLocales++;
+			Stats.MemoryBytes += TableSet->MemoryBytes;
+		}
+		else
 		{
-			//UE_LOG(LogBYGLocalization, Log, TEXT("Entry: %s / %s / %s / %s"), *Entry.LocaleCode, *Entry.LocalizedName.ToString(), *Entry.Category, *Entry.FilePath);
+			Stats.NumLoading++;
+		}
+	}
+	return Stats;
+}
+
+TArray<FString> FBYGLocalizationModule::GetWarmLocaleCodes() const
+{
+	TArray<FString> Codes;
+	for ( const TSharedRef<FBYGLocaleTableSet, ESPMode::ThreadSafe>& TableSet : WarmLocales )
+	{
+		Codes.Add( TableSet->Code );
+	}
+	return Codes;
+}
 
-			if (/*Entry.LocaleCode == CurrentLanguageCode && */Entry.Category == Category)
+void FBYGLocalizationModule::ClearWarmLocales()
+{
+	// Anything still loading finishes, but isn't kept. The current language stays registered, it just won't be
+	// reused the next time it's switched to
+	WarmLocales.Empty();
+	CurrentTableSet.Reset();
+}
+
+TSharedPtr<FBYGLocaleTableSet, ESPMode::ThreadSafe> FBYGLocalizationModule::FindWarmLocale( const FString& Code )
+{
+	for ( int32 Index = 0; Index < WarmLocales.Num(); ++Index )
+	{
+		if ( WarmLocales[ Index ]->Code == Code )
+		{
+			TSharedRef<FBYGLocaleTableSet, ESPMode::ThreadSafe> TableSet = WarmLocales[ Index ];
+			// Most recently used first
+			WarmLocales.RemoveAt( Index );
+			WarmLocales.Insert( TableSet, 0 );
+			return TableSet;
+		}
+	}
+	return nullptr;
+}
+
+TSharedRef<FBYGLocaleTableSet, ESPMode::ThreadSafe> FBYGLocalizationModule::MakeTableSet( const FString& Code ) const
+{
+	check( IsInGameThread() );
+
+	const UBYGLocalizationSettings* Settings = UBYGLocalizationSettings::Get();
+
+	TSharedRef<FBYGLocaleTableSet, ESPMode::ThreadSafe> TableSet = MakeShared<FBYGLocaleTableSet, ESPMode::ThreadSafe>();
+	TableSet->Code = Code;
+	TableSet->FileCode = GetFileLanguageCode( Code );
+	TableSet->VirtualTransform = VirtualLocales.FindRef( Code );
+	TableSet->Categories = Settings->LocalizationCategories;
+	TableSet->Categories.AddUnique( "Game" );
+	for ( const FString& Category : TableSet->Categories )
+	{
+		FBYGLocaleInfo Localization;
+		bool bFound = Loc->FindLocalization( TableSet->FileCode, Category, Localization );
+#if !WITH_EDITOR
+		// Categories without a file for the language show the primary language instead. Not in the editor, where it
+		// would show up when picking FText keys
+		bFound = bFound || Loc->FindLocalization( Settings->PrimaryLanguageCode, Category, Localization );
+#endif
+		TableSet->FilePaths.Add( bFound ? Localization.FilePath : FString() );
+	}
+	TableSet->Tables.SetNum( TableSet->Categories.Num() );
+
+	if ( TableSet->VirtualTransform.IsValid() )
+	{
+		// Virtual locales are made from the primary's tables if they're loaded, so there's nothing to read. Their text is
+		// still made in BuildTableSet, off the game thread
+		const TSharedRef<FBYGLocaleTableSet, ESPMode::ThreadSafe>* SourceTableSet = WarmLocales.FindByPredicate( [&TableSet]( const TSharedRef<FBYGLocaleTableSet, ESPMode::ThreadSafe>& Other )
+		{
+			return Other->bReady && Other->Code == TableSet->FileCode;
+		} );
+		if ( SourceTableSet && ( *SourceTableSet )->FilePaths == TableSet->FilePaths )
+		{
+			for ( int32 Index = 0; Index < TableSet->Categories.Num(); ++Index )
 			{
-				UE_LOG(LogBYGLocalization, Verbose, TEXT("[ReloadLocalizations] Load Localization file: %s"), *Entry.FilePath);
-				StringTableIDs.Add(FName(*Category));
-				FStringTableRegistry::Get().UnregisterStringTable(StringTableIDs[StringTableIDs.Num() - 1]);
-				FStringTableRegistry::Get().Internal_LocTableFromFile(StringTableIDs[StringTableIDs.Num() - 1], Category, Entry.FilePath, FPaths::ProjectContentDir());
-				Found = true;
-				break;
+				if ( !TableSet->FilePaths[ Index ].IsEmpty() )
+				{
+					TableSet->Tables[ Index ] = ( *SourceTableSet )->Tables[ Index ];
+				}
 			}
 		}
+	}
+	return TableSet;
+}
 
-		if (Found)
+TSharedRef<FBYGLocaleTableSet, ESPMode::ThreadSafe> FBYGLocalizationModule::StartLoadingLocale( const FString& Code )
+{
+	TSharedRef<FBYGLocaleTableSet, ESPMode::ThreadSafe> TableSet = MakeTableSet( Code );
+	WarmLocales.Insert( TableSet, 0 );
+
+	UE::Tasks::Launch( UE_SOURCE_LOCATION, [TableSet]()
+	{
+		BuildTableSet( *TableSet );
+
+		AsyncTask( ENamedThreads::GameThread, [TableSet]()
+		{
+			FBYGLocalizationModule* Module = FModuleManager::GetModulePtr<FBYGLocalizationModule>( "BYGLocalization" );
+			if ( Module && !Module->Loc.IsValid() )
+			{
+				Module = nullptr;
+			}
+
+			TableSet->bReady = true;
+			for ( TUniqueFunction<void( FBYGLocalizationModule* )>& Callback : TableSet->OnReady )
+			{
+				Callback( Module );
+			}
+			TableSet->OnReady.Empty();
+
+			if ( Module )
+			{
+				Module->TrimWarmLocales();
+			}
+		} );
+	}, UE::Tasks::ETaskPriority::BackgroundHigh );
+
+	return TableSet;
+}
+
+void FBYGLocalizationModule::BuildTableSet( FBYGLocaleTableSet& TableSet )
+{
+	QUICK_SCOPE_CYCLE_COUNTER( STAT_BYGLocalization_BuildTableSet );
+
+	TArray<int64> MemoryBytes;
+	MemoryBytes.SetNumZeroed( TableSet.Categories.Num() );
+	ParallelFor( TableSet.Categories.Num(), [&TableSet, &MemoryBytes]( int32 Index )
+	{
+		if ( TableSet.FilePaths[ Index ].IsEmpty() )
+			return;
+
+		// Virtual locales may have been given the primary's tables in MakeTableSet
+		FBYGPreparedStringTable& Table = TableSet.Tables[ Index ];
+		if ( !Table.StringTable.IsValid() && !Table.MappedLocale.IsValid() )
+		{
+			Table = PrepareStringTable( FName( *TableSet.Categories[ Index ] ), TableSet.Categories[ Index ], TableSet.FilePaths[ Index ] );
+		}
+		if ( TableSet.VirtualTransform.IsValid() )
+		{
+			Table = MakeVirtualStringTable( Table, TableSet.VirtualTransform.ToSharedRef() );
+		}
+		MemoryBytes[ Index ] = EstimateMemory( Table );
+	}, EParallelForFlags::Unbalanced );
+
+	for ( const int64 Bytes : MemoryBytes )
+	{
+		TableSet.MemoryBytes += Bytes;
+	}
+}
+
+void FBYGLocalizationModule::ApplyTableSet( const TSharedRef<FBYGLocaleTableSet, ESPMode::ThreadSafe>& TableSet )
+{
+	QUICK_SCOPE_CYCLE_COUNTER( STAT_BYGLocalization_ApplyTableSet );
+
+	RegisterTableSet( TableSet );
+
+#if !WITH_EDITOR
+	// Virtual locales use the primary language's culture, and codes that aren't cultures leave it as it was
+	if ( FInternationalization::Get().GetCulture( TableSet->FileCode ).IsValid() )
+	{
+		FInternationalization::Get().SetCurrentCulture( TableSet->FileCode );
+		FInternationalization::Get().SetCurrentLanguageAndLocale( TableSet->FileCode );
+	}
+#endif
+
+	Loc->CallOnLocalizationChanged();
+}
+
+void FBYGLocalizationModule::RegisterTableSet( const TSharedRef<FBYGLocaleTableSet, ESPMode::ThreadSafe>& TableSet )
+{
+	CurrentLanguageCode = TableSet->Code;
+	CurrentTableSet = TableSet;
+
+	for ( int32 Index = 0; Index < TableSet->Categories.Num(); ++Index )
+	{
+		const FName TableID( *TableSet->Categories[ Index ] );
+		if ( TableSet->FilePaths[ Index ].IsEmpty() )
+		{
+			UnloadStringTable( TableID );
+			continue;
+		}
+
+		RegisterStringTable( TableSet->Tables[ Index ] );
+		StringTableIDs.AddUnique( TableID );
+	}
+}
+
+void FBYGLocalizationModule::TrimWarmLocales()
+{
+	const UBYGLocalizationSettings* Settings = UBYGLocalizationSettings::Get();
+	const int64 MaxMemoryBytes = (int64)Settings->WarmLocaleCacheMaxMemoryMB * 1024 * 1024;
+
+	int32 NumKept = 0;
+	int64 MemoryBytes = 0;
+	for ( const TSharedRef<FBYGLocaleTableSet, ESPMode::ThreadSafe>& TableSet : WarmLocales )
+	{
+		if ( TableSet->bReady )
+		{
+			NumKept += TableSet != CurrentTableSet ? 1 : 0;
+			MemoryBytes += TableSet->MemoryBytes;
+		}
+	}
+
+	// Least recently used first. The current language is in use anyway, and anything still loading can't be
+	// measured yet
+	for ( int32 Index = WarmLocales.Num() - 1; Index >= 0; --Index )
+	{
+		const bool bOverCount = NumKept > Settings->WarmLocaleCacheSize;
+		const bool bOverMemory = MaxMemoryBytes > 0 && MemoryBytes > MaxMemoryBytes;
+		if ( !bOverCount && !bOverMemory )
+			break;
+
+		const TSharedRef<FBYGLocaleTableSet, ESPMode::ThreadSafe> TableSet = WarmLocales[ Index ];
+		if ( !TableSet->bReady || TableSet == CurrentTableSet )
 			continue;
 
-		//StringTableIDs.Add( FName( *Settings->StringtableID ) );
-		//FStringTableRegistry::Get().Internal_LocTableFromFile( StringTableIDs[ 0 ], Settings->StringtableNamespace, Filename, FPaths::ProjectContentDir() );
+		UE_LOG( LogBYGLocalization, Verbose, TEXT( "Evicting warm locale '%s' (%.1fKB)" ), *TableSet->Code, TableSet->MemoryBytes / 1024.0 );
+		NumKept--;
+		MemoryBytes -= TableSet->MemoryBytes;
+		WarmLocales.RemoveAt( Index );
+		WarmLocaleStats.NumEvictions++;
+	}
+}
+
+void FBYGLocalizationModule::OnLocalizationFileModified( const FBYGLocaleInfo& Info )
+{
+	const double StartTime = FPlatformTime::Seconds();
+
+	const UBYGLocalizationSettings* Settings = UBYGLocalizationSettings::Get();
+	if ( !Settings->bHotReloadLocalizations )
+		return;
+
+	// Any other copy of this language that's kept loaded is out of date now, including virtual locales made from it
+	for ( int32 Index = WarmLocales.Num() - 1; Index >= 0; --Index )
+	{
+		if ( WarmLocales[ Index ]->FileCode == Info.LocaleCode && WarmLocales[ Index ]->bReady && WarmLocales[ Index ] != CurrentTableSet )
+		{
+			WarmLocales.RemoveAt( Index );
+		}
+	}
+
+	// Only the file that's actually in use for the category matters
+	FBYGLocaleInfo InUse;
+	const FString FileLanguageCode = GetFileLanguageCode( CurrentLanguageCode );
+	if ( Info.LocaleCode != FileLanguageCode
+		|| !StringTableIDs.Contains( FName( *Info.Category ) )
+		|| !Loc->FindLocalization( FileLanguageCode, Info.Category, InUse )
+		|| !FPaths::IsSamePath( InUse.FilePath, Info.FilePath ) )
+	{
+		return;
+	}
+
+	StartHotReload( Info.Category, Info.FilePath, StartTime );
+}
+
+void FBYGLocalizationModule::StartHotReload( const FString& Category, const FString& FilePath, double StartTime )
+{
+	// Saving can write the file several times in a row, only one reload runs per category at a time
+	if ( bool* bModifiedAgain = HotReloadsInFlight.Find( Category ) )
+	{
+		*bModifiedAgain = true;
+		return;
+	}
+	HotReloadsInFlight.Add( Category, false );
+
+	const uint32 Generation = LanguageChangeGeneration;
+	TSharedPtr<const FBYGVirtualLocaleTransform, ESPMode::ThreadSafe> VirtualTransform = VirtualLocales.FindRef( CurrentLanguageCode );
+	UE::Tasks::Launch( UE_SOURCE_LOCATION, [Category, FilePath, StartTime, Generation, VirtualTransform]()
+	{
+		const double ParseStartTime = FPlatformTime::Seconds();
+		FBYGPreparedStringTable Prepared = PrepareStringTable( FName( *Category ), Category, FilePath );
+		if ( VirtualTransform.IsValid() )
+		{
+			Prepared = MakeVirtualStringTable( Prepared, VirtualTransform.ToSharedRef() );
+		}
+		const double ParseTime = FPlatformTime::Seconds() - ParseStartTime;
+
+		AsyncTask( ENamedThreads::GameThread, [Category, FilePath, Prepared = MoveTemp( Prepared ), StartTime, ParseTime, Generation]()
+		{
+			FBYGLocalizationModule* Module = FModuleManager::GetModulePtr<FBYGLocalizationModule>( "BYGLocalization" );
+			if ( Module && Module->Loc.IsValid() )
+			{
+				Module->FinishHotReload( Category, FilePath, Prepared, StartTime, ParseTime, Generation );
+			}
+		} );
+	}, UE::Tasks::ETaskPriority::BackgroundHigh );
+}
+
+void FBYGLocalizationModule::FinishHotReload( const FString& Category, const FString& FilePath, const FBYGPreparedStringTable& Prepared, double StartTime, double ParseTime, uint32 Generation )
+{
+	QUICK_SCOPE_CYCLE_COUNTER( STAT_BYGLocalization_FinishHotReload );
+
+	bool bModifiedAgain = false;
+	HotReloadsInFlight.RemoveAndCopyValue( Category, bModifiedAgain );
+
+	// The language was changed in the meantime, which read the file again anyway
+	if ( Generation != LanguageChangeGeneration )
+		return;
 
-		// We don't want to register this when we're in editor, because we don't want the 'en' language to be shown when selecting FText in Blueprints
-	#if !WITH_EDITOR
-		// We always keep the localization for the Primary language in memory and use it as a fallback in case a string is not found in another language
+	// Timed from now, the earlier save's time would include this whole reload
+	if ( bModifiedAgain )
+	{
+		StartHotReload( Category, FilePath, FPlatformTime::Seconds() );
+		return;
+	}
+
+	const FName TableID( *Category );
+	const int32 TableSetIndex = CurrentTableSet.IsValid() && CurrentTableSet->Code == CurrentLanguageCode
+		? CurrentTableSet->Categories.IndexOfByKey( Category )
+		: INDEX_NONE;
+
+	FBYGPreparedStringTable Previous;
+	if ( TableSetIndex != INDEX_NONE )
+	{
+		Previous = CurrentTableSet->Tables[ TableSetIndex ];
+	}
+	else
+	{
+		Previous.TableID = TableID;
+		Previous.StringTable = FStringTableRegistry::Get().FindMutableStringTable( TableID );
+		Previous.MappedLocale = MappedTables.FindRef( TableID );
+		Previous.VirtualLocale = VirtualTables.FindRef( TableID );
+	}
+
+	const bool bChanged = !HasSameText( Previous, Prepared );
+	if ( bChanged )
+	{
+		RegisterStringTable( Prepared );
+		StringTableIDs.AddUnique( TableID );
+		if ( TableSetIndex != INDEX_NONE )
 		{
-			FString Filename = Loc->GetFileWithPathFromLanguageCode("en", Category);
-			Filename = Filename.Replace(TEXT("/Game/"), TEXT(""));
-			UE_LOG(LogBYGLocalization, Verbose, TEXT("[ReloadLocalizations] Load FALLOUT Localization file: %s"), *Filename);
-			StringTableIDs.Add( FName( *Category) );
-			FStringTableRegistry::Get().Internal_LocTableFromFile( StringTableIDs[StringTableIDs.Num()-1], Category, Filename, FPaths::ProjectContentDir() );
+			CurrentTableSet->MemoryBytes += EstimateMemory( Prepared ) - EstimateMemory( Previous );
+			CurrentTableSet->Tables[ TableSetIndex ] = Prepared;
 		}
-	#endif
+		Loc->CallOnLocalizationChanged();
+	}
+
+	const double TotalTime = FPlatformTime::Seconds() - StartTime;
+	UE_LOG( LogBYGLocalization, Log, TEXT( "Hot reloaded '%s' in %.1fms (%.1fms parsing)%s" ),
+		*FilePath, TotalTime * 1000.0, ParseTime * 1000.0, bChanged ? TEXT( "" ) : TEXT( ", text is unchanged" ) );
+}
+
+#if BYG_LOCALIZATION_POLL_FILES
+bool FBYGLocalizationModule::PollLocalizationFiles( float DeltaTime )
+{
+	QUICK_SCOPE_CYCLE_COUNTER( STAT_BYGLocalization_PollLocalizationFiles );
 
+	if ( !UBYGLocalizationSettings::Get()->bHotReloadLocalizations )
+		return true;
+
+	for ( const FName& TableID : StringTableIDs )
+	{
+		FBYGLocaleInfo Info;
+		if ( !Loc->FindLocalization( GetFileLanguageCode( CurrentLanguageCode ), TableID.ToString(), Info ) )
+			continue;
+
+		const FDateTime TimeStamp = IFileManager::Get().GetTimeStamp( *FPaths::Combine( FPaths::ProjectContentDir(), Info.FilePath ) );
+		FDateTime& KnownTimeStamp = PolledFileTimes.FindOrAdd( Info.FilePath, TimeStamp );
+		if ( KnownTimeStamp != TimeStamp )
+		{
+			KnownTimeStamp = TimeStamp;
+			OnLocalizationFileModified( Info );
+		}
 	}
+	return true;
+}
+#endif
+
+void FBYGLocalizationModule::UnloadStringTable( const FName& TableID )
+{
+	FStringTableRegistry::Get().UnregisterStringTable( TableID );
+	MappedTables.Remove( TableID );
+	VirtualTables.Remove( TableID );
+	NotifyStringTablesChanged();
+}
 
+TSharedPtr<const FBYGMappedLocale> FBYGLocalizationModule::FindMappedTable( const FName& TableID ) const
+{
+	return MappedTables.FindRef( TableID );
+}
+
+TSharedPtr<const FBYGVirtualLocale> FBYGLocalizationModule::FindVirtualTable( const FName& TableID ) const
+{
+	return VirtualTables.FindRef( TableID );
 }
 
 void FBYGLocalizationModule::UpdateTranslations()
@@ -116,6 +915,11 @@ void FBYGLocalizationModule::UnloadLocalizations()
 		FStringTableRegistry::Get().UnregisterStringTable( ID );
 	}
 	StringTableIDs.Empty();
+	MappedTables.Empty();
+	VirtualTables.Empty();
+	NotifyStringTablesChanged();
+	// Reloading means the files may have changed
+	ClearWarmLocales();
 }
 
 void FBYGLocalizationModule::AddReferencedObjects( FReferenceCollector& Collector )
@@ -57,8 +57,23 @@ void UBYGLocalizationSettings::PostEditChangeProperty( struct FPropertyChangedEv
 		|| ( PropertyChangedEvent.GetPropertyName() == GET_MEMBER_NAME_CHECKED( UBYGLocalizationSettings, AllowedExtensions ) )
 		)
 	{
+		FBYGLocalizationModule::Get().GetLocalization()->InvalidateLocalizationCatalog();
 		FBYGLocalizationModule::Get().ReloadLocalizations();
 	}
+	else if ( PropertyChangedEvent.GetPropertyName() == GET_MEMBER_NAME_CHECKED( UBYGLocalizationSettings, bUseEmbeddedPrimaryFallback ) )
+	{
+		// Same files, but loaded differently
+		FBYGLocalizationModule::Get().ReloadLocalizations();
+	}
+	else if ( PropertyChangedEvent.GetPropertyName() == GET_MEMBER_NAME_CHECKED( UBYGLocalizationSettings, bUseVirtualDebugLocale )
+		|| PropertyChangedEvent.GetPropertyName() == GET_MEMBER_NAME_CHECKED( UBYGLocalizationSettings, PseudoLocalizationExpansion )
+		|| PropertyChangedEvent.GetPropertyName() == GET_MEMBER_NAME_CHECKED( UBYGLocalizationSettings, bPseudoLocalizationAccents )
+		|| PropertyChangedEvent.GetPropertyName() == GET_MEMBER_NAME_CHECKED( UBYGLocalizationSettings, bPseudoLocalizationBrackets ) )
+	{
+		FBYGLocalizationModule::Get().UpdateDebugLocale();
+	}
+	// e.g. StringtableID decides which table GetGameText reads from
+	FBYGLocalizationModule::NotifyStringTablesChanged();
 
 	Super::PostEditChangeProperty( PropertyChangedEvent );
 
@@ -5,13 +5,24 @@
 #include "BYGLocalizationSettings.h"
 #include "BYGLocalizationModule.h"
 #include "BYGLocalization.h"
+#include "BYGMappedLocale.h"
+#include "BYGLocalizationHash.h"
+#include "BYGTextCache.h"
+#include "BYGCsvWriter.h"
 
+#include <Async/ParallelFor.h>
+#include <HAL/FileManager.h>
 #include <Internationalization/StringTableCore.h>
 #include <Internationalization/StringTableRegistry.h>
 #include <Internationalization/StringTable.h>
 
 bool UBYGLocalizationStatics::HasTextInTable( const FString& TableName, const FString& Key )
 {
+	if ( TSharedPtr<const FBYGMappedLocale> MappedTable = FBYGLocalizationModule::Get().FindMappedTable( *TableName ) )
+	{
+		return MappedTable->Contains( Key );
+	}
+
 	FStringTableConstPtr StringTable = FStringTableRegistry::Get().FindStringTable( *TableName );
 
 	if ( StringTable.IsValid() )
@@ -22,96 +33,241 @@ bool UBYGLocalizationStatics::HasTextInTable( const FString& TableName, const FS
 	return false;
 }
 
-bool GetTextFromTable( const FString& TableName, const FString& Key, FText& FoundText )
+// A table looked up once, so that many keys can be read from it
+struct FBYGResolvedTable
 {
-	// Not using UE4's default method because it doesn't differentiate between missing a table and
-	// missing a key
-	FStringTableConstPtr StringTable = FStringTableRegistry::Get().FindStringTable( *TableName );
+	explicit FBYGResolvedTable( const FString& InTableName )
+		: TableName( InTableName )
+	{
+		// Mapped tables are not registered as string tables outside of the editor
+		MappedTable = FBYGLocalizationModule::Get().FindMappedTable( *TableName );
+		if ( !MappedTable.IsValid() )
+		{
+			StringTable = FStringTableRegistry::Get().FindStringTable( *TableName );
+		}
+	}
 
-	if ( StringTable.IsValid() )
+	bool IsValid() const { return MappedTable.IsValid() || StringTable.IsValid(); }
+
+	bool FindText( const FString& Key, FText& FoundText ) const
 	{
-		FStringTableEntryConstPtr pEntry = StringTable->FindEntry( *Key );
-		if ( pEntry.IsValid() )
+		if ( MappedTable.IsValid() )
 		{
-			FTextConstDisplayStringPtr pStr = pEntry->GetDisplayString();
-			FoundText = FText::FromString( *pStr );
-			return true;
+			return MappedTable->FindText( Key, FoundText );
 		}
-		else
+		if ( StringTable.IsValid() )
 		{
-			UE_LOG( LogBYGLocalization, Error, TEXT( "Could not find key '%s' in string table '%s'" ), *TableName, *Key );
+			FStringTableEntryConstPtr pEntry = StringTable->FindEntry( *Key );
+			if ( pEntry.IsValid() )
+			{
+				FTextConstDisplayStringPtr pStr = pEntry->GetDisplayString();
+				FoundText = FText::FromString( *pStr );
+				return true;
+			}
 		}
+		return false;
 	}
-	else
+
+	// Show compact error message: "key not found" or "table not found" + the id
+	FText MakeNotFoundText( const FString& Key ) const
 	{
-		UE_LOG( LogBYGLocalization, Error, TEXT( "Could not find string table '%s'" ), *TableName, *Key );
+		return FText::FromString( FString::Printf( TEXT( "(%s:%s)" ),
+			IsValid() ? TEXT( "KNF" ) : TEXT( "TNF" ),
+			IsValid() ? *Key : *TableName ) );
 	}
 
-	// Show compact error message: "key not found" or "table not found" + the id
-	FoundText = FText::FromString( FString::Printf( TEXT( "(%s:%s)" ),
-		StringTable.IsValid() ? *FString( TEXT( "KNF" ) ) : *FString( TEXT( "TNF" ) ),
-		StringTable.IsValid() ? *Key : *TableName ) );
+	const FString& TableName;
+	TSharedPtr<const FBYGMappedLocale> MappedTable;
+	FStringTableConstPtr StringTable;
+};
+
+bool GetTextFromTable( const FString& TableName, const FString& Key, FText& FoundText )
+{
+	// Not using UE4's default method because it doesn't differentiate between missing a table and
+	// missing a key
+	const FBYGResolvedTable Table( TableName );
+	if ( Table.FindText( Key, FoundText ) )
+	{
+		return true;
+	}
+
+	if ( Table.IsValid() )
+	{
+		UE_LOG( LogBYGLocalization, Error, TEXT( "Could not find key '%s' in string table '%s'" ), *Key, *TableName );
+	}
+	else
+	{
+		UE_LOG( LogBYGLocalization, Error, TEXT( "Could not find string table '%s'" ), *TableName );
+	}
 
+	FoundText = Table.MakeNotFoundText( Key );
 	return false;
 }
 
+// Everything GetGameText has returned since the string tables last changed, including the error texts
+static FBYGTextCache GameTextCache;
+
 FText UBYGLocalizationStatics::GetGameText( const FString& Key )
 {
-	const UBYGLocalizationSettings* Settings = GetDefault<UBYGLocalizationSettings>();
+	QUICK_SCOPE_CYCLE_COUNTER( STAT_BYGLocalization_GetGameText );
+
+	return ResolveGameText( Key, FBYGLocalizationHash::HashTextKey( Key ) );
+}
+
+FText UBYGLocalizationStatics::ResolveGameText( const FString& Key, uint64 KeyHash, const FString& Category )
+{
+	if ( !Category.IsEmpty() )
+	{
+		// Only the default table goes through the cache
+		FText Result;
+		GetTextFromTable( Category, Key, Result );
+		return Result;
+	}
+
+	// Read before looking anything up, so a table that changes part way through can't leave a stale entry behind
+	const uint32 Generation = FBYGLocalizationModule::GetStringTableGeneration();
 
 	FText Result;
+	if ( GameTextCache.Find( Key, KeyHash, Generation, Result ) )
+	{
+		return Result;
+	}
+
+	const UBYGLocalizationSettings* Settings = GetDefault<UBYGLocalizationSettings>();
+
 	bool bFound = GetTextFromTable( Settings->StringtableID, Key, Result );
-	if ( !bFound )
+	// The table already has the primary text for anything untranslated, so there's nowhere else to look
+	if ( !bFound && !Settings->bUseEmbeddedPrimaryFallback )
 	{
 		// Fall back to English if we're not using English and we didn't get the key in the non-English locale  
 		bFound = GetTextFromTable( Settings->PrimaryLanguageCode, Key, Result );
 	}
+
+	// Missing keys are cached too, so the error is only logged once per key until the tables change
+	GameTextCache.Add( Key, KeyHash, Generation, Result, bFound );
 	return Result;
 }
 
-bool UBYGLocalizationStatics::SetLocalizationByCode(const FString& Code)
+int32 UBYGLocalizationStatics::GetGameTexts( const TArray<FString>& Keys, TArray<FText>& OutTexts, TArray<int32>& MissingKeys, const FString& Category )
 {
+	QUICK_SCOPE_CYCLE_COUNTER( STAT_BYGLocalization_GetGameTexts );
+
+	const uint32 Generation = FBYGLocalizationModule::GetStringTableGeneration();
 	const UBYGLocalizationSettings* Settings = GetDefault<UBYGLocalizationSettings>();
 
-	if (Code != Settings->PrimaryLanguageCode && !Settings->LanguageCodesInUse.Contains(Code) && Code != "Debug")
-		return false;
-	
-	FBYGLocalizationModule::Get().SetCurrentLanguageCode(Code);
+	// The GetGameText cache only knows about keys, so it can only be shared when reading from the default table
+	const bool bDefaultTable = Category.IsEmpty();
+	const FString& TableName = bDefaultTable ? Settings->StringtableID : Category;
+
+	OutTexts.SetNum( Keys.Num() );
+	MissingKeys.Reset();
+	MissingKeys.SetNumZeroed( FMath::DivideAndRoundUp( Keys.Num(), 32 ) );
 
-	const TArray<FBYGLocaleInfo> Localizations = FBYGLocalizationModule::Get().GetLocalization()->GetAvailableLocalizations();
+	// Sorted by hash so that repeated keys end up next to each other and are only resolved once
+	TArray<TPair<uint64, int32>> Order;
+	Order.Reserve( Keys.Num() );
+	for ( int32 Index = 0; Index < Keys.Num(); ++Index )
+	{
+		Order.Emplace( FBYGLocalizationHash::HashTextKey( Keys[ Index ] ), Index );
+	}
+	Order.Sort( []( const TPair<uint64, int32>& A, const TPair<uint64, int32>& B )
+	{
+		return A.Key < B.Key || ( A.Key == B.Key && A.Value < B.Value );
+	} );
 
-	TArray<FString> Categories = Settings->LocalizationCategories;
-	Categories.AddUnique("Game");
+	// Only looked up once something isn't already cached
+	TOptional<FBYGResolvedTable> Table;
+	TOptional<FBYGResolvedTable> FallbackTable;
 
-	for (const FString Category : Categories)
+	int32 NumMissing = 0;
+	int32 NumNewlyMissing = 0;
+	for ( int32 OrderIndex = 0; OrderIndex < Order.Num(); ++OrderIndex )
 	{
-		FStringTableRegistry::Get().UnregisterStringTable(FName(*Category));
+		const uint64 KeyHash = Order[ OrderIndex ].Key;
+		const int32 Index = Order[ OrderIndex ].Value;
+		const FString& Key = Keys[ Index ];
 
-		for (const FBYGLocaleInfo Localization : Localizations)
+		bool bFound = true;
+		const int32 PreviousIndex = OrderIndex > 0 ? Order[ OrderIndex - 1 ].Value : INDEX_NONE;
+		if ( PreviousIndex != INDEX_NONE && Order[ OrderIndex - 1 ].Key == KeyHash && Keys[ PreviousIndex ].Equals( Key, ESearchCase::CaseSensitive ) )
 		{
-			if (Localization.Category == Category && Localization.LocaleCode == Code)
+			OutTexts[ Index ] = OutTexts[ PreviousIndex ];
+			bFound = ( MissingKeys[ PreviousIndex / 32 ] & (int32)( 1u << ( PreviousIndex % 32 ) ) ) == 0;
+		}
+		else if ( !bDefaultTable || !GameTextCache.Find( Key, KeyHash, Generation, OutTexts[ Index ], &bFound ) )
+		{
+			if ( !Table.IsSet() )
+			{
+				Table.Emplace( TableName );
+			}
+			const FBYGResolvedTable* LastTable = Table.GetPtrOrNull();
+			bFound = Table->FindText( Key, OutTexts[ Index ] );
+			if ( !bFound && bDefaultTable && !Settings->bUseEmbeddedPrimaryFallback )
 			{
-				FStringTableRegistry::Get().Internal_LocTableFromFile(
-					FName(*Category),
-					Category,
-					Localization.FilePath,
-					FPaths::ProjectContentDir()
-				);
-
-				break;
+				// Same fallback as GetGameText
+				if ( !FallbackTable.IsSet() )
+				{
+					FallbackTable.Emplace( Settings->PrimaryLanguageCode );
+				}
+				LastTable = FallbackTable.GetPtrOrNull();
+				bFound = FallbackTable->FindText( Key, OutTexts[ Index ] );
+			}
+
+			if ( !bFound )
+			{
+				OutTexts[ Index ] = LastTable->MakeNotFoundText( Key );
+				++NumNewlyMissing;
+			}
+			if ( bDefaultTable )
+			{
+				GameTextCache.Add( Key, KeyHash, Generation, OutTexts[ Index ], bFound );
 			}
 		}
+
+		if ( !bFound )
+		{
+			MissingKeys[ Index / 32 ] |= (int32)( 1u << ( Index % 32 ) );
+			++NumMissing;
+		}
 	}
 
-#if !WITH_EDITOR
-	FString UE_Code = (Code == "Debug") ? "en" : Code;
-	FInternationalization::Get().SetCurrentCulture(UE_Code);
-	FInternationalization::Get().SetCurrentLanguageAndLocale(UE_Code);
-#endif
+	// One line for the whole batch rather than one per key, and only the first time they're missed
+	if ( NumNewlyMissing > 0 )
+	{
+		UE_LOG( LogBYGLocalization, Warning, TEXT( "Could not find %d of %d keys in string table '%s'" ), NumNewlyMissing, Keys.Num(), *TableName );
+	}
+
+	return NumMissing;
+}
+
+FBYGTextKey UBYGLocalizationStatics::MakeTextKey( const FString& Key, const FString& Category )
+{
+	return FBYGTextKey( Key, Category );
+}
+
+FText UBYGLocalizationStatics::GetTextFromKey( const FBYGTextKey& TextKey )
+{
+	return TextKey.GetText();
+}
 
-	FBYGLocalizationModule::Get().GetLocalization()->CallOnLocalizationChanged();
+bool UBYGLocalizationStatics::IsGameTextMissing( const TArray<int32>& MissingKeys, int32 Index )
+{
+	return MissingKeys.IsValidIndex( Index / 32 ) && ( MissingKeys[ Index / 32 ] & (int32)( 1u << ( Index % 32 ) ) ) != 0;
+}
+
+bool UBYGLocalizationStatics::SetLocalizationByCode(const FString& Code)
+{
+	return FBYGLocalizationModule::Get().SetLanguage(Code);
+}
+
+TFuture<bool> UBYGLocalizationStatics::SetLocalizationByCodeAsync(const FString& Code)
+{
+	return FBYGLocalizationModule::Get().SetLanguageAsync(Code);
+}
 
-	return true;
+void UBYGLocalizationStatics::PrefetchLocalizationByCode(const FString& Code)
+{
+	FBYGLocalizationModule::Get().PrefetchLocale(Code);
 }
 
 void UBYGLocalizationStatics::SetTextAsStringTableEntry(FText &Text, const FName &StringTableID, const FString &Key)
@@ -142,6 +298,7 @@ void UBYGLocalizationStatics::AddNewEntryToTheLocalization(const FString &Catego
 		StringTable->SetMetaData(Key, TEXT("Comment"), Comment);
 		StringTable->SetMetaData(Key, TEXT("Primary"), SourceString);
 		StringTable->SetMetaData(Key, TEXT("Status"), FString("New Key Added from UE4"));
+		FBYGLocalizationModule::NotifyStringTablesChanged();
 	}
 }
 
@@ -154,6 +311,7 @@ void UBYGLocalizationStatics::RemoveEntryFromLocalization(const FString& Categor
 	if (StringTable.IsValid())
 	{
 		StringTable->RemoveSourceString(Key);
+		FBYGLocalizationModule::NotifyStringTablesChanged();
 	}
 }
 
@@ -177,6 +335,7 @@ bool UBYGLocalizationStatics::UpdateLocalizationSourceString(const FString& Cate
 			return false;
 		
 		StringTable->SetSourceString(Key, SourceString);
+		FBYGLocalizationModule::NotifyStringTablesChanged();
 
 		if(InMainLanguage)
 		{
@@ -217,76 +376,156 @@ void UBYGLocalizationStatics::UpdateCSV(const FString &Category, const FString &
 	ExportStrings(FName(*Category), Filename);
 }
 
-bool UBYGLocalizationStatics::ExportStrings(const FName StringTableName, const FString& InFilename)
+bool UBYGLocalizationStatics::UpdateAllCSVs()
 {
-	const FStringTablePtr StringTable = FStringTableRegistry::Get().FindMutableStringTable(StringTableName);
+	const FString LanguageCode = FBYGLocalizationModule::Get().GetCurrentLanguageCode();
 
-	if (!StringTable.IsValid())
+	TArray<FString> Categories;
+	GetLocalizationCategories(Categories);
+
+	TArray<TPair<FName, FString>> TablesAndFilenames;
+	for (const FString& Category : Categories)
 	{
-		return false;
+		// Virtual languages like Debug have no files to update
+		FString FilePath;
+		GetLocalizationFilePath(LanguageCode, Category, FilePath);
+		if (!FilePath.IsEmpty())
+		{
+			TablesAndFilenames.Emplace(FName(*Category), FPaths::Combine(FPaths::ProjectContentDir(), FilePath));
+		}
 	}
 
-	FString ExportedStrings;
-	TArray<FName> MetaDataColumnNames;
-	MetaDataColumnNames.Add(TEXT("Comment"));
-	MetaDataColumnNames.Add(TEXT("Primary"));
-	MetaDataColumnNames.Add(TEXT("Status"));
+	return ExportStrings(TablesAndFilenames);
+}
+
+namespace BYGLocalizationStatics
+{
+	// Rows are written out whenever this much is waiting, so exporting never needs more than this
+	static const int32 ExportChunkBytes = 64 * 1024;
 
+	// Same as ReplaceCharWithEscapedChar() followed by replacing " with "", without the intermediate strings
+	static void AppendEscaped(const FString& Text, FString& Out)
 	{
-		// Write header
-		ExportedStrings += TEXT("Key,SourceString,Comment,Primary,Status\r\n");
+		for (const TCHAR Char : Text)
+		{
+			switch (Char)
+			{
+			case TEXT('\\'): Out += TEXT("\\\\"); break;
+			case TEXT('\n'): Out += TEXT("\\n"); break;
+			case TEXT('\r'): Out += TEXT("\\r"); break;
+			case TEXT('\t'): Out += TEXT("\\t"); break;
+			case TEXT('\''): Out += TEXT("\\'"); break;
+			case TEXT('"'): Out += TEXT("\\\"\""); break;
+			default: Out.AppendChar(Char); break;
+			}
+		}
+	}
 
-		// Write entries
-		TArray<FString> KeysFromStringTable;
-		StringTable->EnumerateSourceStrings([&](const FString& InKey, const FString& InSourceString) -> bool
-		{			
-			FString ExportedKey = InKey.ReplaceCharWithEscapedChar();
-			ExportedKey.ReplaceInline(TEXT("\""), TEXT("\"\""));
+	static void AppendQuoted(const FString& Text, FString& Out)
+	{
+		Out.AppendChar(TEXT('"'));
+		Out.Append(Text);
+		Out.AppendChar(TEXT('"'));
+	}
+}
 
-			FString ExportedSourceString = InSourceString.ReplaceCharWithEscapedChar();
-			ExportedSourceString.ReplaceInline(TEXT("\""), TEXT("\"\""));
+bool UBYGLocalizationStatics::ExportStrings(const FName StringTableName, const FString& InFilename)
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_BYGLocalization_ExportStrings);
 
-			ExportedStrings += TEXT("\"");
-			ExportedStrings += ExportedKey;
-			ExportedStrings += TEXT("\"");
+	const FStringTableConstPtr StringTable = FStringTableRegistry::Get().FindStringTable(StringTableName);
 
-			ExportedStrings += TEXT(",");
+	if (!StringTable.IsValid())
+	{
+		return false;
+	}
+
+	TUniquePtr<FArchive> FileWriter(IFileManager::Get().CreateFileWriter(*InFilename));
+	if (!FileWriter)
+	{
+		return false;
+	}
 
-			ExportedStrings += TEXT("\"");
-			ExportedStrings += ExportedSourceString;
-			ExportedStrings += TEXT("\"");
+	static const FName CommentName(TEXT("Comment"));
+	static const FName PrimaryName(TEXT("Primary"));
+	static const FName StatusName(TEXT("Status"));
 
-			for (const FName& MetaDataColumnName : MetaDataColumnNames)
-			{
-				FString ExportedMetaData = StringTable->GetMetaData(InKey, MetaDataColumnName).ReplaceCharWithEscapedChar();
-				ExportedMetaData.ReplaceInline(TEXT("\""), TEXT("\"\""));
+	FBYGCsvWriter Writer;
+	Writer.Reserve(BYGLocalizationStatics::ExportChunkBytes * 2);
+	Writer.AddRaw(TEXT("Key,SourceString,Comment,Primary,Status\r\n"));
 
-				ExportedStrings += TEXT(",");
+	// Reused for every row, so they only grow to fit the longest one
+	FString Row;
+	FString Comment;
+	FString Primary;
+	FString Status;
 
-				ExportedStrings += TEXT("\"");
-				ExportedStrings += ExportedMetaData;
-				ExportedStrings += TEXT("\"");
+	StringTable->EnumerateSourceStrings([&](const FString& InKey, const FString& InSourceString) -> bool
+	{
+		Comment.Reset();
+		Primary.Reset();
+		Status.Reset();
+		StringTable->EnumerateMetaData(InKey, [&](FName InMetaDataId, const FString& InMetaData) -> bool
+		{
+			if (InMetaDataId == CommentName)
+			{
+				BYGLocalizationStatics::AppendEscaped(InMetaData, Comment);
 			}
-
-			ExportedStrings += TEXT("\r\n");
-			KeysFromStringTable.Add(InKey);
-			return true; // continue enumeration
+			else if (InMetaDataId == PrimaryName)
+			{
+				BYGLocalizationStatics::AppendEscaped(InMetaData, Primary);
+			}
+			else if (InMetaDataId == StatusName)
+			{
+				BYGLocalizationStatics::AppendEscaped(InMetaData, Status);
+			}
+			return true;
 		});
-	}
 
-	return FFileHelper::SaveStringToFile(ExportedStrings, *InFilename, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+		Row.Reset();
+		Row.AppendChar(TEXT('"'));
+		BYGLocalizationStatics::AppendEscaped(InKey, Row);
+		Row += TEXT("\",\"");
+		BYGLocalizationStatics::AppendEscaped(InSourceString, Row);
+		Row.AppendChar(TEXT('"'));
+		for (const FString* MetaData : { &Comment, &Primary, &Status })
+		{
+			Row.AppendChar(TEXT(','));
+			BYGLocalizationStatics::AppendQuoted(*MetaData, Row);
+		}
+		Row += TEXT("\r\n");
+
+		Writer.AddRaw(Row);
+		if (Writer.GetOutput().Num() >= BYGLocalizationStatics::ExportChunkBytes)
+		{
+			Writer.Flush(*FileWriter);
+		}
+		return true; // continue enumeration
+	});
+
+	Writer.Flush(*FileWriter);
+	return FileWriter->Close();
+}
+
+bool UBYGLocalizationStatics::ExportStrings(const TArray<TPair<FName, FString>>& TablesAndFilenames)
+{
+	// Each table is written to its own file, so they can all be exported at once
+	TArray<bool> Succeeded;
+	Succeeded.SetNumZeroed(TablesAndFilenames.Num());
+	ParallelFor(TablesAndFilenames.Num(), [&TablesAndFilenames, &Succeeded](int32 Index)
+	{
+		Succeeded[Index] = ExportStrings(TablesAndFilenames[Index].Key, TablesAndFilenames[Index].Value);
+	});
+
+	return !Succeeded.Contains(false);
 }
 
 void UBYGLocalizationStatics::GetLocalizationFilePath(const FString &LanguageCode, const FString &Category, FString &FilePath)
 {
-	const TArray<FBYGLocaleInfo> Localizations = FBYGLocalizationModule::Get().GetLocalization()->GetAvailableLocalizations();
-	for (const FBYGLocaleInfo &Localization : Localizations)
+	FBYGLocaleInfo Localization;
+	if (FBYGLocalizationModule::Get().GetLocalization()->FindLocalization(LanguageCode, Category, Localization))
 	{
-		if (Localization.LocaleCode == LanguageCode && Localization.Category == Category)
-		{
-			FilePath = Localization.FilePath;
-			return;
-		}
+		FilePath = Localization.FilePath;
 	}
 }
 
@@ -309,11 +548,10 @@ void UBYGLocalizationStatics::GetLocalizationCategories(TArray<FString> &Categor
 
 	const UBYGLocalizationSettings* Settings = GetDefault<UBYGLocalizationSettings>();
 	FString PrimaryCode = Settings->PrimaryLanguageCode;
-	const TArray<FBYGLocaleInfo> Localizations = FBYGLocalizationModule::Get().GetLocalization()->GetAvailableLocalizations();
+	const TArray<FBYGLocaleInfo> Localizations = FBYGLocalizationModule::Get().GetLocalization()->GetAvailableLocalizations(PrimaryCode);
 	for (const FBYGLocaleInfo &Localization : Localizations)
 	{
-		if(Localization.LocaleCode == PrimaryCode)
-			Categories.AddUnique(Localization.Category);
+		Categories.AddUnique(Localization.Category);
 	}
 }
 
@@ -342,6 +580,7 @@ bool UBYGLocalizationStatics::AddNewCategory(FString CategoryToAdd /*= "NewCateg
 		UE_LOG(LogBYGLocalization, Log, TEXT("AddNewCategory: %s"), *FullPath);
 		if (FFileHelper::SaveStringToFile(ExportedStrings, *FullPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
 		{
+			FBYGLocalizationModule::Get().GetLocalization()->AddLocalizationFile(FullPath);
 			UpdateLocalizationTranslations();
 		}
 
@@ -0,0 +1,46 @@
+// Copyright 2017-2021 Brace Yourself Games. All Rights Reserved.
+
+#include "BYGMappedLocale.h"
+
+bool FBYGMappedLocale::Map( const FString& BlobFilename, const FString& SourceFilename )
+{
+	Texts.Empty();
+	return Blob.MapFile( BlobFilename, SourceFilename );
+}
+
+int32 FBYGMappedLocale::FindTranslatedEntry( FStringView Key ) const
+{
+	const int32 EntryIndex = Blob.FindEntry( Key );
+	if ( EntryIndex == INDEX_NONE || Blob.GetDisplayString( EntryIndex, bFallBackToPrimary ).IsEmpty() )
+	{
+		return INDEX_NONE;
+	}
+	return EntryIndex;
+}
+
+bool FBYGMappedLocale::FindText( FStringView Key, FText& OutText ) const
+{
+	const int32 EntryIndex = FindTranslatedEntry( Key );
+	if ( EntryIndex == INDEX_NONE )
+	{
+		return false;
+	}
+
+	{
+		FReadScopeLock ReadLock( TextsLock );
+		if ( const FText* Found = Texts.Find( EntryIndex ) )
+		{
+			OutText = *Found;
+			return true;
+		}
+	}
+
+	FWriteScopeLock WriteLock( TextsLock );
+	OutText = Texts.FindOrAdd( EntryIndex, FText::FromString( FString( Blob.GetDisplayString( EntryIndex, bFallBackToPrimary ) ) ) );
+	return true;
+}
+
+bool FBYGMappedLocale::Contains( FStringView Key ) const
+{
+	return FindTranslatedEntry( Key ) != INDEX_NONE;
+}
@@ -0,0 +1,36 @@
+// Copyright 2017-2021 Brace Yourself Games. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BYGLocalizationBlob.h"
+#include "Misc/ScopeRWLock.h"
+
+// A compiled localization file that is memory-mapped instead of being copied into a string table.
+// Translations are read straight out of the mapping, and an FText is only built the first time a key is looked up.
+class FBYGMappedLocale
+{
+public:
+	bool Map( const FString& BlobFilename, const FString& SourceFilename );
+
+	// Entries without a translation use their Primary column, see UBYGLocalizationSettings::bUseEmbeddedPrimaryFallback
+	void SetFallBackToPrimary( bool bInFallBackToPrimary ) { bFallBackToPrimary = bInFallBackToPrimary; }
+	bool FallsBackToPrimary() const { return bFallBackToPrimary; }
+
+	// Empty translations count as missing, the same as when loading through FStringTable, unless falling back to the
+	// Primary column
+	bool FindText( FStringView Key, FText& OutText ) const;
+	bool Contains( FStringView Key ) const;
+
+	const FBYGLocalizationBlob& GetBlob() const { return Blob; }
+
+protected:
+	int32 FindTranslatedEntry( FStringView Key ) const;
+
+	FBYGLocalizationBlob Blob;
+	bool bFallBackToPrimary = false;
+
+	// Entry index to text, only for keys that have been looked up
+	mutable TMap<int32, FText> Texts;
+	mutable FRWLock TextsLock;
+};
@@ -0,0 +1,163 @@
+// Copyright 2017-2021 Brace Yourself Games. All Rights Reserved.
+
+#include "BYGPseudoLocalizer.h"
+#include "BYGLocalizationSettings.h"
+
+namespace BYGPseudoLocalizer
+{
+	// a-z then A-Z
+	static const TCHAR AccentedLetters[] =
+		TEXT( "\u00E0\u0180\u00E7\u00F0\u00E9\u0192\u011D\u0125\u00EE\u0135\u0137\u013C\u0271" )
+		TEXT( "\u00F1\u00F6\u00FE\u01EB\u0155\u0161\u0163\u00FB\u1E7D\u0175\u1E8B\u00FD\u017E" )
+		TEXT( "\u00C5\u0181\u00C7\u00D0\u00C9\u0191\u011C\u0124\u00CE\u0134\u0136\u013B\u1E40" )
+		TEXT( "\u00D1\u00D6\u00DE\u01EA\u0154\u0160\u0162\u00DB\u1E7C\u0174\u1E8A\u00DD\u017D" );
+
+	// Added to the end when there are no vowels to repeat
+	static const TCHAR PaddingChar = TEXT( '~' );
+
+	static bool IsVowel( TCHAR Char )
+	{
+		switch ( Char )
+		{
+		case 'a': case 'e': case 'i': case 'o': case 'u':
+		case 'A': case 'E': case 'I': case 'O': case 'U':
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	static TCHAR Accent( TCHAR Char )
+	{
+		if ( Char >= 'a' && Char <= 'z' )
+			return AccentedLetters[ Char - 'a' ];
+		if ( Char >= 'A' && Char <= 'Z' )
+			return AccentedLetters[ 26 + Char - 'A' ];
+		return Char;
+	}
+
+	// Returns the index after the markup starting at Start, or Start if there isn't any
+	static int32 SkipMarkup( FStringView Source, int32 Start )
+	{
+		const TCHAR Open = Source[ Start ];
+		if ( Open == '<' || Open == '{' )
+		{
+			const TCHAR Close = Open == '<' ? '>' : '}';
+			for ( int32 i = Start + 1; i < Source.Len(); ++i )
+			{
+				if ( Source[ i ] == Close )
+					return i + 1;
+			}
+			// Unclosed, so it's just text
+			return Start;
+		}
+
+		if ( Open == '|' )
+		{
+			int32 i = Start + 1;
+			while ( i < Source.Len() && FChar::IsIdentifier( Source[ i ] ) )
+			{
+				++i;
+			}
+			if ( i < Source.Len() && Source[ i ] == '(' )
+			{
+				int32 Depth = 0;
+				for ( ; i < Source.Len(); ++i )
+				{
+					Depth += Source[ i ] == '(' ? 1 : Source[ i ] == ')' ? -1 : 0;
+					if ( Depth == 0 )
+						return i + 1;
+				}
+				return Source.Len();
+			}
+			return i;
+		}
+
+		return Start;
+	}
+}
+
+FBYGPseudoLocalizer::FBYGPseudoLocalizer()
+{
+}
+
+FBYGPseudoLocalizer::FBYGPseudoLocalizer( const FBYGPseudoLocalizationOptions& InOptions )
+	: Options( InOptions )
+{
+	Options.ExpansionRatio = FMath::Max( Options.ExpansionRatio, 1.0f );
+}
+
+FBYGPseudoLocalizationOptions FBYGPseudoLocalizer::GetOptionsFromSettings()
+{
+	const UBYGLocalizationSettings* Settings = UBYGLocalizationSettings::Get();
+
+	FBYGPseudoLocalizationOptions Options;
+	Options.ExpansionRatio = Settings->PseudoLocalizationExpansion;
+	Options.bAccents = Settings->bPseudoLocalizationAccents;
+	Options.bBrackets = Settings->bPseudoLocalizationBrackets;
+	return Options;
+}
+
+void FBYGPseudoLocalizer::Localize( FStringView Source, FString& Out ) const
+{
+	using namespace BYGPseudoLocalizer;
+
+	const float Extra = Options.ExpansionRatio - 1.0f;
+
+	Out.Reset( FMath::CeilToInt( Source.Len() * Options.ExpansionRatio ) + 2 );
+	if ( Options.bBrackets )
+	{
+		Out.AppendChar( '[' );
+	}
+
+	// Every character of text adds Extra to what's owed, and it's paid back by repeating the next vowel
+	int32 NumTextChars = 0;
+	int32 NumAdded = 0;
+	float Owed = 0.0f;
+
+	int32 i = 0;
+	while ( i < Source.Len() )
+	{
+		const int32 MarkupEnd = SkipMarkup( Source, i );
+		if ( MarkupEnd != i )
+		{
+			Out.Append( Source.GetData() + i, MarkupEnd - i );
+			i = MarkupEnd;
+			continue;
+		}
+
+		const TCHAR Char = Source[ i++ ];
+		const TCHAR OutChar = Options.bAccents ? Accent( Char ) : Char;
+		Out.AppendChar( OutChar );
+
+		++NumTextChars;
+		Owed += Extra;
+		if ( IsVowel( Char ) )
+		{
+			for ( ; Owed >= 1.0f; Owed -= 1.0f )
+			{
+				Out.AppendChar( OutChar );
+				++NumAdded;
+			}
+		}
+	}
+
+	// Whatever couldn't be paid back by vowels, e.g. there weren't any
+	const int32 NumWanted = FMath::CeilToInt( NumTextChars * Extra - KINDA_SMALL_NUMBER );
+	for ( ; NumAdded < NumWanted; ++NumAdded )
+	{
+		Out.AppendChar( PaddingChar );
+	}
+
+	if ( Options.bBrackets )
+	{
+		Out.AppendChar( ']' );
+	}
+}
+
+FString FBYGPseudoLocalizer::Localize( FStringView Source ) const
+{
+	FString Out;
+	Localize( Source, Out );
+	return Out;
+}
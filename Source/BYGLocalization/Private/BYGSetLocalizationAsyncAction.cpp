@@ -0,0 +1,33 @@
+// Copyright 2017-2021 Brace Yourself Games. All Rights Reserved.
+
+#include "BYGSetLocalizationAsyncAction.h"
+#include "BYGLocalizationStatics.h"
+
+UBYGSetLocalizationAsyncAction* UBYGSetLocalizationAsyncAction::SetLocalizationByCodeAsync( UObject* WorldContextObject, const FString& Code )
+{
+	UBYGSetLocalizationAsyncAction* Action = NewObject<UBYGSetLocalizationAsyncAction>();
+	Action->Code = Code;
+	Action->RegisterWithGameInstance( WorldContextObject );
+	return Action;
+}
+
+void UBYGSetLocalizationAsyncAction::Activate()
+{
+	// The result is always handed out on the game thread
+	TWeakObjectPtr<UBYGSetLocalizationAsyncAction> WeakThis( this );
+	UBYGLocalizationStatics::SetLocalizationByCodeAsync( Code ).Then( [WeakThis]( TFuture<bool> Result )
+	{
+		if ( UBYGSetLocalizationAsyncAction* This = WeakThis.Get() )
+		{
+			if ( Result.Get() )
+			{
+				This->Completed.Broadcast();
+			}
+			else
+			{
+				This->Failed.Broadcast();
+			}
+			This->SetReadyToDestroy();
+		}
+	} );
+}
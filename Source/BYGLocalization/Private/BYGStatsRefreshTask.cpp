@@ -0,0 +1,47 @@
+// Copyright 2017-2021 Brace Yourself Games. All Rights Reserved.
+
+#include "BYGStatsRefreshTask.h"
+#include "BYGLocalizationCoreMinimal.h"
+
+#include "Async/ParallelFor.h"
+#include "Misc/ScopeLock.h"
+
+FBYGStatsRefreshTask::FBYGStatsRefreshTask( const TArray<FString>& Paths )
+	: State( MakeShared<FState, ESPMode::ThreadSafe>() )
+{
+	State->Paths = Paths;
+	State->PendingResults.Reserve( Paths.Num() );
+
+	Task = UE::Tasks::Launch( UE_SOURCE_LOCATION, [State = State]()
+	{
+		ParallelFor( State->Paths.Num(), [&State]( int32 Index )
+		{
+			if ( State->bCancelled )
+				return;
+
+			FResult Result;
+			Result.Path = State->Paths[ Index ];
+			Result.bSucceeded = State->Scanner.GetStats( Result.Path, Result.Stats );
+			if ( !Result.bSucceeded )
+			{
+				UE_LOG( LogBYGLocalization, Error, TEXT( "Failed to load file '%s'" ), *Result.Path );
+			}
+
+			FScopeLock Lock( &State->ResultsLock );
+			State->PendingResults.Add( MoveTemp( Result ) );
+		}, EParallelForFlags::BackgroundPriority | EParallelForFlags::Unbalanced );
+	}, UE::Tasks::ETaskPriority::BackgroundNormal );
+}
+
+FBYGStatsRefreshTask::~FBYGStatsRefreshTask()
+{
+	Cancel();
+	Task.Wait();
+}
+
+void FBYGStatsRefreshTask::DrainResults( TArray<FResult>& OutResults )
+{
+	FScopeLock Lock( &State->ResultsLock );
+	OutResults.Append( MoveTemp( State->PendingResults ) );
+	State->PendingResults.Reset();
+}
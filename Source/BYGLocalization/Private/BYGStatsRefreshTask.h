@@ -0,0 +1,52 @@
+// Copyright 2017-2021 Brace Yourself Games. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tasks/Task.h"
+#include "BYGLocalization/Public/BYGLocalization.h"
+#include "BYGLocalization/Public/BYGStatusScanner.h"
+#include <atomic>
+
+// Gathers localization stats for a set of files, one task per file on the worker pool. Results are queued up and
+// collected from the game thread with DrainResults, nothing is called back from the workers.
+class BYGLOCALIZATION_API FBYGStatsRefreshTask
+{
+public:
+	struct FResult
+	{
+		FString Path;
+		BYGLocStats Stats;
+		bool bSucceeded = false;
+	};
+
+	// Call from the game thread
+	FBYGStatsRefreshTask( const TArray<FString>& Paths );
+
+	// Cancels and waits for the workers to finish whatever file they are on
+	~FBYGStatsRefreshTask();
+
+	// Files that haven't started yet are skipped
+	void Cancel() { State->bCancelled = true; }
+
+	bool IsComplete() const { return Task.IsCompleted(); }
+
+	// Moves out every result finished since the last call
+	void DrainResults( TArray<FResult>& OutResults );
+
+protected:
+	// Shared with the workers
+	struct FState
+	{
+		TArray<FString> Paths;
+		// Made on the game thread, so the workers don't read the settings or need UBYGLocalization
+		FBYGStatusScanner Scanner;
+		std::atomic<bool> bCancelled { false };
+
+		FCriticalSection ResultsLock;
+		TArray<FResult> PendingResults;
+	};
+
+	TSharedRef<FState, ESPMode::ThreadSafe> State;
+	UE::Tasks::FTask Task;
+};
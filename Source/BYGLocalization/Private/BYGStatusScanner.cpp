@@ -0,0 +1,142 @@
+// Copyright 2017-2021 Brace Yourself Games. All Rights Reserved.
+
+#include "BYGStatusScanner.h"
+#include "BYGCsvReader.h"
+#include "BYGLocalizationCoreMinimal.h"
+#include "BYGLocalizationHash.h"
+#include "BYGLocalizationSettings.h"
+
+#include "HAL/PlatformFilemanager.h"
+#include "Misc/ScopeLock.h"
+
+namespace BYGStatusScanner
+{
+	struct FCachedStats
+	{
+		int64 Size = 0;
+		int64 ModificationTicks = 0;
+		uint64 SettingsHash = 0;
+		BYGLocStats Counts;
+	};
+
+	// Stats are gathered on a worker thread for the stats window
+	static FCriticalSection CacheLock;
+	static TMap<FString, FCachedStats> Cache;
+
+	static TArray<UTF8CHAR> ToUTF8( const FString& String )
+	{
+		const FTCHARToUTF8 Converted( *String, String.Len() );
+		return TArray<UTF8CHAR>( (const UTF8CHAR*)Converted.Get(), Converted.Length() );
+	}
+
+	static inline UTF8CHAR ToLowerAscii( UTF8CHAR Char )
+	{
+		return ( Char >= 'A' && Char <= 'Z' ) ? (UTF8CHAR)( Char + ( 'a' - 'A' ) ) : Char;
+	}
+
+	// FString::StartsWith ignores case by default, so this does too. Status prefixes are ASCII in practice, anything
+	// outside of that has to match exactly
+	static bool StartsWith( FUtf8StringView String, const TArray<UTF8CHAR>& Prefix )
+	{
+		if ( String.Len() < Prefix.Num() )
+			return false;
+		for ( int32 i = 0; i < Prefix.Num(); ++i )
+		{
+			if ( ToLowerAscii( String[ i ] ) != ToLowerAscii( Prefix[ i ] ) )
+				return false;
+		}
+		return true;
+	}
+}
+
+FBYGStatusScanner::FBYGStatusScanner()
+{
+	const UBYGLocalizationSettings* Settings = UBYGLocalizationSettings::Get();
+	DeprecatedPrefix = BYGStatusScanner::ToUTF8( Settings->DeprecatedStatus );
+	ModifiedPrefix = BYGStatusScanner::ToUTF8( Settings->ModifiedStatusLeft );
+	NewPrefix = BYGStatusScanner::ToUTF8( Settings->NewStatus );
+
+	const FString Combined = Settings->DeprecatedStatus + TEXT( "\n" ) + Settings->ModifiedStatusLeft + TEXT( "\n" ) + Settings->NewStatus;
+	SettingsHash = FBYGLocalizationHash::HashBuffer( *Combined, Combined.Len() * sizeof( TCHAR ) );
+}
+
+EBYGLocEntryStatus FBYGStatusScanner::Classify( FUtf8StringView Status ) const
+{
+	if ( BYGStatusScanner::StartsWith( Status, DeprecatedPrefix ) )
+		return EBYGLocEntryStatus::Deprecated;
+	if ( BYGStatusScanner::StartsWith( Status, ModifiedPrefix ) )
+		return EBYGLocEntryStatus::Modified;
+	if ( BYGStatusScanner::StartsWith( Status, NewPrefix ) )
+		return EBYGLocEntryStatus::New;
+	return EBYGLocEntryStatus::None;
+}
+
+bool FBYGStatusScanner::GetStats( const FString& Filename, BYGLocStats& OutCounts ) const
+{
+	const FFileStatData StatData = FPlatformFileManager::Get().GetPlatformFile().GetStatData( *Filename );
+	if ( StatData.bIsValid )
+	{
+		FScopeLock Lock( &BYGStatusScanner::CacheLock );
+		const BYGStatusScanner::FCachedStats* Cached = BYGStatusScanner::Cache.Find( Filename );
+		if ( Cached
+			&& Cached->Size == StatData.FileSize
+			&& Cached->ModificationTicks == StatData.ModificationTime.GetTicks()
+			&& Cached->SettingsHash == SettingsHash )
+		{
+			OutCounts = Cached->Counts;
+			return true;
+		}
+	}
+
+	if ( !ScanFile( Filename, OutCounts ) )
+		return false;
+
+	if ( StatData.bIsValid )
+	{
+		BYGStatusScanner::FCachedStats Cached;
+		Cached.Size = StatData.FileSize;
+		Cached.ModificationTicks = StatData.ModificationTime.GetTicks();
+		Cached.SettingsHash = SettingsHash;
+		Cached.Counts = OutCounts;
+
+		FScopeLock Lock( &BYGStatusScanner::CacheLock );
+		BYGStatusScanner::Cache.Add( Filename, MoveTemp( Cached ) );
+	}
+	return true;
+}
+
+void FBYGStatusScanner::ClearCache()
+{
+	FScopeLock Lock( &BYGStatusScanner::CacheLock );
+	BYGStatusScanner::Cache.Empty();
+}
+
+bool FBYGStatusScanner::ScanFile( const FString& Filename, BYGLocStats& OutCounts ) const
+{
+	QUICK_SCOPE_CYCLE_COUNTER( STAT_BYGLocalization_ScanStatus );
+
+	int32 Counts[ 4 ] = { 0, 0, 0, 0 };
+
+	// Only the status column is needed
+	const int32 StatusColumn = 4;
+	FBYGCsvReader Reader;
+	Reader.SetColumnMask( 1ull << StatusColumn );
+	const bool bSucceeded = Reader.ReadFile( Filename, [this, &Counts]( const FBYGCsvRow& Row )
+	{
+		// Note that we skip the header
+		if ( Row.Index > 0 && Row.Num() > StatusColumn )
+		{
+			Counts[ (int32)Classify( Row[ StatusColumn ] ) ] += 1;
+		}
+		return true;
+	} );
+	if ( !bSucceeded )
+		return false;
+
+	OutCounts.Empty();
+	OutCounts.Add( EBYGLocEntryStatus::None, Counts[ (int32)EBYGLocEntryStatus::None ] );
+	OutCounts.Add( EBYGLocEntryStatus::New, Counts[ (int32)EBYGLocEntryStatus::New ] );
+	OutCounts.Add( EBYGLocEntryStatus::Modified, Counts[ (int32)EBYGLocEntryStatus::Modified ] );
+	OutCounts.Add( EBYGLocEntryStatus::Deprecated, Counts[ (int32)EBYGLocEntryStatus::Deprecated ] );
+	return true;
+}
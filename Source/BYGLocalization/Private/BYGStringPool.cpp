@@ -0,0 +1,101 @@
+// Copyright 2017-2021 Brace Yourself Games. All Rights Reserved.
+
+#include "BYGStringPool.h"
+#include "BYGLocalizationHash.h"
+
+int32 FBYGStringPool::Add( FString&& String )
+{
+	if ( String.IsEmpty() )
+		return INDEX_NONE;
+
+	const uint64 Hash = FBYGLocalizationHash::HashString( String );
+	const int32 ExistingId = FindByHash( Hash, String );
+	if ( ExistingId != INDEX_NONE )
+		return ExistingId;
+
+	// Kept at most half full so probe sequences stay short
+	if ( ( Strings.Num() + 1 ) * 2 > SlotIds.Num() )
+	{
+		Grow();
+	}
+
+	const int32 Id = Strings.Add( MoveTemp( String ) );
+	Hashes.Add( Hash );
+
+	uint32 Slot = (uint32)Hash & SlotMask;
+	while ( SlotIds[ Slot ] != INDEX_NONE )
+	{
+		Slot = ( Slot + 1 ) & SlotMask;
+	}
+	SlotHashes[ Slot ] = Hash;
+	SlotIds[ Slot ] = Id;
+	return Id;
+}
+
+int32 FBYGStringPool::Add( FStringView String )
+{
+	const int32 ExistingId = Find( String );
+	return ExistingId != INDEX_NONE ? ExistingId : Add( FString( String ) );
+}
+
+int32 FBYGStringPool::Find( FStringView String ) const
+{
+	if ( String.IsEmpty() || Strings.Num() == 0 )
+		return INDEX_NONE;
+	return FindByHash( FBYGLocalizationHash::HashString( String ), String );
+}
+
+int32 FBYGStringPool::FindByHash( uint64 Hash, FStringView String ) const
+{
+	if ( SlotIds.Num() == 0 )
+		return INDEX_NONE;
+
+	uint32 Slot = (uint32)Hash & SlotMask;
+	while ( true )
+	{
+		const int32 Id = SlotIds[ Slot ];
+		if ( Id == INDEX_NONE )
+			return INDEX_NONE;
+		if ( SlotHashes[ Slot ] == Hash && String.Equals( Strings[ Id ], ESearchCase::CaseSensitive ) )
+			return Id;
+		Slot = ( Slot + 1 ) & SlotMask;
+	}
+}
+
+void FBYGStringPool::Grow()
+{
+	const uint32 NumSlots = FMath::Max( 16u, (uint32)SlotIds.Num() * 2 );
+	SlotHashes.SetNumUninitialized( NumSlots );
+	SlotIds.Init( INDEX_NONE, NumSlots );
+	SlotMask = NumSlots - 1;
+
+	for ( int32 Id = 0; Id < Strings.Num(); ++Id )
+	{
+		uint32 Slot = (uint32)Hashes[ Id ] & SlotMask;
+		while ( SlotIds[ Slot ] != INDEX_NONE )
+		{
+			Slot = ( Slot + 1 ) & SlotMask;
+		}
+		SlotHashes[ Slot ] = Hashes[ Id ];
+		SlotIds[ Slot ] = Id;
+	}
+}
+
+SIZE_T FBYGStringPool::GetAllocatedSize() const
+{
+	SIZE_T Size = Strings.GetAllocatedSize() + Hashes.GetAllocatedSize() + SlotHashes.GetAllocatedSize() + SlotIds.GetAllocatedSize();
+	for ( const FString& String : Strings )
+	{
+		Size += String.GetAllocatedSize();
+	}
+	return Size;
+}
+
+void FBYGStringPool::Reset()
+{
+	Strings.Reset();
+	Hashes.Reset();
+	SlotHashes.Reset();
+	SlotIds.Reset();
+	SlotMask = 0;
+}
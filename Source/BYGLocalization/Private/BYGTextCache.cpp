@@ -0,0 +1,48 @@
+// Copyright 2017-2021 Brace Yourself Games. All Rights Reserved.
+
+#include "BYGTextCache.h"
+
+bool FBYGTextCache::Find( FStringView Key, uint64 KeyHash, uint32 InGeneration, FText& OutText, bool* bOutFound ) const
+{
+	FReadScopeLock ReadLock( Lock );
+	if ( InGeneration != Generation )
+		return false;
+
+	const FEntry* Entry = Entries.Find( KeyHash );
+	if ( !Entry || !Key.Equals( Entry->Key, ESearchCase::CaseSensitive ) )
+		return false;
+
+	OutText = Entry->Text;
+	if ( bOutFound )
+	{
+		*bOutFound = Entry->bFound;
+	}
+	return true;
+}
+
+void FBYGTextCache::Add( FStringView Key, uint64 KeyHash, uint32 InGeneration, const FText& Text, bool bFound )
+{
+	FWriteScopeLock WriteLock( Lock );
+	if ( InGeneration != Generation )
+	{
+		// Resolved against tables that have since changed
+		if ( (int32)( InGeneration - Generation ) < 0 )
+			return;
+
+		// Reset rather than Empty, the same keys will most likely be looked up again
+		Entries.Reset();
+		Generation = InGeneration;
+	}
+
+	FEntry& Entry = Entries.FindOrAdd( KeyHash );
+	// On a hash collision the newest key wins
+	Entry.Key = FString( Key );
+	Entry.Text = Text;
+	Entry.bFound = bFound;
+}
+
+int32 FBYGTextCache::Num() const
+{
+	FReadScopeLock ReadLock( Lock );
+	return Entries.Num();
+}
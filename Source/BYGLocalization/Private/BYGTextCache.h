@@ -0,0 +1,33 @@
+// Copyright 2017-2021 Brace Yourself Games. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/ScopeRWLock.h"
+
+// Remembers what GetGameText returned for each key, including the error text for keys that weren't found, until the
+// string tables change. Entries are keyed by FBYGLocalizationHash::HashTextKey and hold a shared FText, so a lookup that
+// hits doesn't allocate. Keys are case-sensitive, the same as in the string tables.
+class FBYGTextCache
+{
+public:
+	// Generation is FBYGLocalizationModule::GetStringTableGeneration, anything cached under another one is ignored
+	// bOutFound is false if the cached text is the error text for a missing key
+	bool Find( FStringView Key, uint64 KeyHash, uint32 Generation, FText& OutText, bool* bOutFound = nullptr ) const;
+	void Add( FStringView Key, uint64 KeyHash, uint32 Generation, const FText& Text, bool bFound = true );
+
+	int32 Num() const;
+
+protected:
+	struct FEntry
+	{
+		// Kept to tell apart keys with the same hash
+		FString Key;
+		FText Text;
+		bool bFound = true;
+	};
+
+	TMap<uint64, FEntry> Entries;
+	uint32 Generation = 0;
+	mutable FRWLock Lock;
+};
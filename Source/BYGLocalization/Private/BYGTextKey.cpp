@@ -0,0 +1,65 @@
+// Copyright 2017-2021 Brace Yourself Games. All Rights Reserved.
+
+#include "BYGTextKey.h"
+#include "BYGLocalizationHash.h"
+#include "BYGLocalizationModule.h"
+#include "BYGLocalizationStatics.h"
+
+FBYGTextKey::FBYGTextKey( const FString& InKey, const FString& InCategory )
+	: Category( InCategory )
+	, Key( InKey )
+{
+}
+
+void FBYGTextKey::Set( const FString& InKey, const FString& InCategory )
+{
+	Key = InKey;
+	Category = InCategory;
+	Reset();
+}
+
+const FText& FBYGTextKey::GetText() const
+{
+	const uint32 Generation = FBYGLocalizationModule::GetStringTableGeneration();
+
+#if WITH_EDITORONLY_DATA
+	if ( ( bHashed && !CachedKey.Equals( Key, ESearchCase::CaseSensitive ) )
+		|| ( bCached && !CachedCategory.Equals( Category, ESearchCase::CaseSensitive ) ) )
+	{
+		Reset();
+	}
+#endif
+
+	if ( bCached && CachedGeneration == Generation )
+	{
+		return CachedText;
+	}
+
+	CachedText = UBYGLocalizationStatics::ResolveGameText( Key, GetKeyHash(), Category );
+	CachedGeneration = Generation;
+	bCached = true;
+#if WITH_EDITORONLY_DATA
+	CachedCategory = Category;
+#endif
+	return CachedText;
+}
+
+uint64 FBYGTextKey::GetKeyHash() const
+{
+	if ( !bHashed )
+	{
+		KeyHash = FBYGLocalizationHash::HashTextKey( Key );
+		bHashed = true;
+#if WITH_EDITORONLY_DATA
+		CachedKey = Key;
+#endif
+	}
+	return KeyHash;
+}
+
+void FBYGTextKey::Reset() const
+{
+	CachedText = FText::GetEmpty();
+	bHashed = false;
+	bCached = false;
+}
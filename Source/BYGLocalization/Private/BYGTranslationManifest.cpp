@@ -0,0 +1,143 @@
+// Copyright 2017-2021 Brace Yourself Games. All Rights Reserved.
+
+#include "BYGTranslationManifest.h"
+#include "BYGLocalizationCoreMinimal.h"
+#include "BYGLocalizationHash.h"
+#include "BYGLocalizationSettings.h"
+
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFilemanager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+// Paths are stored as absolute so the same file always maps to the same entry
+static FString GetManifestKey( const FString& Path )
+{
+	FString Key = FPaths::ConvertRelativePathToFull( Path );
+	FPaths::NormalizeFilename( Key );
+	return Key;
+}
+
+FString FBYGTranslationManifest::GetManifestFilename()
+{
+	return FPaths::Combine( FPaths::ProjectIntermediateDir(), TEXT( "BYGLocalization" ), TEXT( "BYGTranslationManifest.bin" ) );
+}
+
+uint64 FBYGTranslationManifest::GetSettingsHash()
+{
+	const UBYGLocalizationSettings* Settings = UBYGLocalizationSettings::Get();
+	const FString Combined = FString::Join( TArray<FString>{
+		Settings->PrimaryLanguageCode,
+		FString::FromInt( (int32)Settings->QuotingPolicy ),
+		Settings->bPreserveDeprecatedLines ? TEXT( "1" ) : TEXT( "0" ),
+		Settings->NewStatus,
+		Settings->ModifiedStatusLeft,
+		Settings->ModifiedStatusRight,
+		Settings->DeprecatedStatus,
+		FString::SanitizeFloat( Settings->PseudoLocalizationExpansion ),
+		Settings->bPseudoLocalizationAccents ? TEXT( "1" ) : TEXT( "0" ),
+		Settings->bPseudoLocalizationBrackets ? TEXT( "1" ) : TEXT( "0" ),
+	}, TEXT( "\n" ) );
+	return FBYGLocalizationHash::HashBuffer( *Combined, Combined.Len() * sizeof( TCHAR ) );
+}
+
+bool FBYGTranslationManifest::Load( const FString& Filename )
+{
+	Files.Empty();
+
+	TArray<uint8> Bytes;
+	if ( !FFileHelper::LoadFileToArray( Bytes, *Filename, FILEREAD_Silent ) )
+		return false;
+
+	FMemoryReader Reader( Bytes );
+	uint32 FileMagic = 0;
+	uint32 FileVersion = 0;
+	uint64 SettingsHash = 0;
+	Reader << FileMagic << FileVersion << SettingsHash;
+	if ( Reader.IsError() || FileMagic != Magic || FileVersion != Version )
+	{
+		UE_LOG( LogBYGLocalization, Log, TEXT( "Ignoring out of date translation manifest '%s'" ), *Filename );
+		return false;
+	}
+	if ( SettingsHash != GetSettingsHash() )
+	{
+		UE_LOG( LogBYGLocalization, Log, TEXT( "Localization settings changed, updating all translations" ) );
+		return false;
+	}
+
+	Reader << Files;
+	if ( Reader.IsError() )
+	{
+		UE_LOG( LogBYGLocalization, Warning, TEXT( "Corrupt translation manifest '%s'" ), *Filename );
+		Files.Empty();
+		return false;
+	}
+
+	return true;
+}
+
+bool FBYGTranslationManifest::Save( const FString& Filename ) const
+{
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer( Bytes );
+	uint32 FileMagic = Magic;
+	uint32 FileVersion = Version;
+	uint64 SettingsHash = GetSettingsHash();
+	Writer << FileMagic << FileVersion << SettingsHash;
+	Writer << const_cast<TMap<FString, FBYGManifestFile>&>( Files );
+
+	if ( !FFileHelper::SaveArrayToFile( Bytes, *Filename ) )
+	{
+		UE_LOG( LogBYGLocalization, Warning, TEXT( "Failed to write translation manifest '%s'" ), *Filename );
+		return false;
+	}
+	return true;
+}
+
+const FBYGManifestFile* FBYGTranslationManifest::Find( const FString& Path ) const
+{
+	return Files.Find( GetManifestKey( Path ) );
+}
+
+void FBYGTranslationManifest::Set( const FString& Path, const FBYGManifestFile& File )
+{
+	Files.Add( GetManifestKey( Path ), File );
+}
+
+bool FBYGTranslationManifest::IsUnchanged( const FString& Path ) const
+{
+	const FBYGManifestFile* Known = Find( Path );
+	if ( !Known )
+		return false;
+
+	const FFileStatData StatData = FPlatformFileManager::Get().GetPlatformFile().GetStatData( *Path );
+	return StatData.bIsValid
+		&& StatData.FileSize == Known->Size
+		&& StatData.ModificationTime.GetTicks() == Known->ModificationTicks;
+}
+
+bool FBYGTranslationManifest::GetFileState( const FString& Path, FBYGManifestFile& OutFile, const FBYGManifestFile* Known )
+{
+	const FFileStatData StatData = FPlatformFileManager::Get().GetPlatformFile().GetStatData( *Path );
+	if ( !StatData.bIsValid || StatData.bIsDirectory )
+		return false;
+
+	OutFile.Size = StatData.FileSize;
+	OutFile.ModificationTicks = StatData.ModificationTime.GetTicks();
+
+	if ( Known && Known->Size == OutFile.Size && Known->ModificationTicks == OutFile.ModificationTicks )
+	{
+		OutFile.Hash = Known->Hash;
+		return true;
+	}
+
+	TArray<uint8> Bytes;
+	if ( !FFileHelper::LoadFileToArray( Bytes, *Path, FILEREAD_Silent ) )
+		return false;
+
+	OutFile.Size = Bytes.Num();
+	OutFile.Hash = FBYGLocalizationHash::HashBuffer( Bytes.GetData(), Bytes.Num() );
+	return true;
+}
@@ -0,0 +1,54 @@
+// Copyright 2017-2021 Brace Yourself Games. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// What a localization file looked like the last time it was merged
+struct FBYGManifestFile
+{
+	int64 Size = -1;
+	int64 ModificationTicks = 0;
+	uint64 Hash = 0;
+	// Hash of the primary file this translation was merged against. 0 for primaries
+	uint64 PrimaryHash = 0;
+
+	friend FArchive& operator<<( FArchive& Ar, FBYGManifestFile& File )
+	{
+		return Ar << File.Size << File.ModificationTicks << File.Hash << File.PrimaryHash;
+	}
+};
+
+// Remembers the state of every file touched by UpdateTranslations, so that translations whose contents and primary
+// haven't changed since they were last merged can be skipped with only a stat
+class FBYGTranslationManifest
+{
+public:
+	// Bump whenever the format or the merge output changes, so every file is merged again
+	static const uint32 Version = 1;
+	static const uint32 Magic = 0x464D5942; // "BYMF"
+
+	// Kept in Intermediate rather than next to the files, so it isn't packaged or checked in. Paths are absolute, so one
+	// manifest covers every localization directory
+	static FString GetManifestFilename();
+
+	// Hash of the settings that change how files are written. If they change the whole manifest is discarded
+	static uint64 GetSettingsHash();
+
+	// Returns false and leaves the manifest empty if the file is missing, invalid or was written with other settings
+	bool Load( const FString& Filename );
+	bool Save( const FString& Filename ) const;
+
+	const FBYGManifestFile* Find( const FString& Path ) const;
+	void Set( const FString& Path, const FBYGManifestFile& File );
+
+	// Only stats the file, true if its size and modification time match what was recorded
+	bool IsUnchanged( const FString& Path ) const;
+
+	// Stats the file and fills in its hash. Known is used instead of reading the file if its size and modification
+	// time still match
+	static bool GetFileState( const FString& Path, FBYGManifestFile& OutFile, const FBYGManifestFile* Known = nullptr );
+
+protected:
+	TMap<FString, FBYGManifestFile> Files;
+};
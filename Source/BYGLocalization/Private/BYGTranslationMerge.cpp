@@ -0,0 +1,305 @@
+// Copyright 2017-2021 Brace Yourself Games. All Rights Reserved.
+
+#include "BYGTranslationMerge.h"
+#include "BYGLocalization.h"
+#include "BYGStringPool.h"
+#include "BYGUpdateLog.h"
+
+#include "Async/ParallelFor.h"
+#include "Misc/MemStack.h"
+
+namespace BYGTranslationMerge
+{
+	// Stands in for keys the target doesn't have yet
+	static const FBYGLocalizationEntry EmptyEntry;
+}
+
+void FBYGMergePolicy::TakeEntry( FBYGLocalizationEntry& OldEntry, FBYGLocalizationEntry& OutEntry )
+{
+	OutEntry.Key = OldEntry.Key;
+	OutEntry.Translation = MoveTemp( OldEntry.Translation );
+	OutEntry.Comment = MoveTemp( OldEntry.Comment );
+	OutEntry.Primary = MoveTemp( OldEntry.Primary );
+	OutEntry.OldPrimary = MoveTemp( OldEntry.OldPrimary );
+	OutEntry.Status = OldEntry.Status;
+	OutEntry.PrimaryId = OldEntry.PrimaryId;
+	OutEntry.CommentId = OldEntry.CommentId;
+}
+
+void FBYGMergePolicy::TakePrimary( FBYGLocalizationEntry& Entry, FString& OutPrimary ) const
+{
+	if ( Entry.PrimaryId != INDEX_NONE )
+	{
+		OutPrimary = StringPool->Get( Entry.PrimaryId );
+	}
+	else
+	{
+		OutPrimary = MoveTemp( Entry.Primary );
+	}
+}
+
+bool FBYGMergePolicy::IsSamePrimary( const FBYGLocalizationEntry& OldEntry, const FBYGLocalizationEntry& PrimaryEntry ) const
+{
+	if ( OldEntry.PrimaryId != INDEX_NONE && PrimaryEntry.PrimaryId != INDEX_NONE )
+	{
+		return OldEntry.PrimaryId == PrimaryEntry.PrimaryId;
+	}
+	return OldEntry.GetPrimary( StringPool ) == PrimaryEntry.Translation;
+}
+
+void FBYGMergePolicy::SetPrimary( const FBYGLocalizationEntry& PrimaryEntry, FBYGLocalizationEntry& OutEntry )
+{
+	OutEntry.PrimaryId = PrimaryEntry.PrimaryId;
+	if ( OutEntry.PrimaryId != INDEX_NONE )
+	{
+		OutEntry.Primary.Empty();
+	}
+	else
+	{
+		OutEntry.Primary = PrimaryEntry.Translation;
+	}
+}
+
+void FBYGMergePolicy::SetComment( const FBYGLocalizationEntry& PrimaryEntry, FBYGLocalizationEntry& OutEntry )
+{
+	OutEntry.CommentId = PrimaryEntry.CommentId;
+	if ( OutEntry.CommentId != INDEX_NONE )
+	{
+		OutEntry.Comment.Empty();
+	}
+	else
+	{
+		OutEntry.Comment = PrimaryEntry.Comment;
+	}
+}
+
+bool FBYGTranslationMergePolicy::MergeEntry( const FBYGLocalizationEntry& PrimaryEntry, FBYGLocalizationEntry* OldEntry, const FString& CultureName, FBYGLocalizationEntry& OutEntry ) const
+{
+	const FBYGLocalizationEntry& OldLocalizedEntry = OldEntry ? *OldEntry : BYGTranslationMerge::EmptyEntry;
+
+	if ( OldLocalizedEntry.Translation.IsEmpty() && !PrimaryEntry.Translation.IsEmpty() )
+	{
+		BYG_UPDATE_LOG( Warning, TEXT( "%s missing key '%s', adding." ), *CultureName, *PrimaryEntry.Key );
+		OutEntry.Key = PrimaryEntry.Key;
+		SetPrimary( PrimaryEntry, OutEntry );
+		// We want to show Primary until they replace the new key with a correct translation, so for now just write in the Primary to the translation field
+		OutEntry.Translation = PrimaryEntry.Translation;
+		if ( OutEntry.Key == "_LocMeta_Author" )
+		{
+			// Don't copy across author "Brace Yourself Games" for updated translations
+			OutEntry.Translation = "Unknown";
+		}
+		OutEntry.Status = EBYGLocEntryStatus::New;
+	}
+	// The display text in the master Primary is not the same as the Primary in the localization, something was modified
+	else if ( !IsSamePrimary( OldLocalizedEntry, PrimaryEntry ) )
+	{
+		BYG_UPDATE_LOG( Warning, TEXT( "A:'%s' -> B:'%s'" ), *OldLocalizedEntry.GetPrimary( StringPool ), *PrimaryEntry.Translation );
+
+		if ( OldEntry )
+		{
+			TakeEntry( *OldEntry, OutEntry );
+		}
+		const FString& OldPrimary = OutEntry.GetPrimary( StringPool );
+		if ( !OldPrimary.IsEmpty() )
+		{
+			BYG_UPDATE_LOG( Warning, TEXT( "Lang %s: Modified key '%s'. Was '%s', now is '%s'" ), *CultureName, *PrimaryEntry.Key, *OldPrimary, *PrimaryEntry.Translation );
+			OutEntry.Status = EBYGLocEntryStatus::Modified;
+			TakePrimary( OutEntry, OutEntry.OldPrimary );
+		}
+		SetPrimary( PrimaryEntry, OutEntry );
+	}
+	else if ( OldEntry )
+	{
+		TakeEntry( *OldEntry, OutEntry );
+	}
+
+	SetComment( PrimaryEntry, OutEntry );
+	return false;
+}
+
+FBYGPseudoLocalizationMergePolicy::FBYGPseudoLocalizationMergePolicy( const FBYGPseudoLocalizationOptions& Options, const FBYGStringPool* InStringPool )
+	: FBYGMergePolicy( InStringPool )
+	, PseudoLocalizer( Options )
+{
+}
+
+bool FBYGPseudoLocalizationMergePolicy::MergeEntry( const FBYGLocalizationEntry& PrimaryEntry, FBYGLocalizationEntry* OldEntry, const FString& CultureName, FBYGLocalizationEntry& OutEntry ) const
+{
+	const FBYGLocalizationEntry& OldLocalizedEntry = OldEntry ? *OldEntry : BYGTranslationMerge::EmptyEntry;
+
+	if ( OldLocalizedEntry.Translation.IsEmpty() && !PrimaryEntry.Translation.IsEmpty() )
+	{
+		BYG_UPDATE_LOG( Warning, TEXT( "%s missing key '%s', adding." ), *CultureName, *PrimaryEntry.Key );
+		OutEntry.Key = PrimaryEntry.Key;
+		SetPrimary( PrimaryEntry, OutEntry );
+		OutEntry.Status = EBYGLocEntryStatus::New;
+	}
+	// The display text in the master Primary is not the same as the Primary in the localization, something was modified
+	else if ( !IsSamePrimary( OldLocalizedEntry, PrimaryEntry ) )
+	{
+		if ( OldEntry )
+		{
+			TakeEntry( *OldEntry, OutEntry );
+		}
+		const FString& OldPrimary = OutEntry.GetPrimary( StringPool );
+		if ( OldPrimary.IsEmpty() )
+		{
+			// Keep the existing translation
+			SetPrimary( PrimaryEntry, OutEntry );
+			return false;
+		}
+
+		BYG_UPDATE_LOG( Warning, TEXT( "Lang %s: Modified key '%s'. Was '%s', now is '%s'" ), *CultureName, *PrimaryEntry.Key, *OldPrimary, *PrimaryEntry.Translation );
+		OutEntry.Status = EBYGLocEntryStatus::Modified;
+		TakePrimary( OutEntry, OutEntry.OldPrimary );
+		SetPrimary( PrimaryEntry, OutEntry );
+	}
+	else if ( OldEntry )
+	{
+		TakeEntry( *OldEntry, OutEntry );
+	}
+
+	// Always generated again from the Primary, so changing the pseudo-localization settings updates every entry
+	return true;
+}
+
+void FBYGPseudoLocalizationMergePolicy::FinishEntry( const FBYGLocalizationEntry& PrimaryEntry, FBYGLocalizationEntry& Entry ) const
+{
+	if ( PrimaryEntry.Translation.IsEmpty() )
+	{
+		Entry.Translation.Reset();
+	}
+	else
+	{
+		PseudoLocalizer.Localize( PrimaryEntry.Translation, Entry.Translation );
+	}
+}
+
+void FBYGTranslationMerge::Merge( const FBYGLocaleData& PrimaryData, TArrayView<FBYGMergeTarget> Targets )
+{
+	QUICK_SCOPE_CYCLE_COUNTER( STAT_BYGLocalization_MergeTranslations );
+
+	const TArray<FBYGLocalizationEntry>& PrimaryEntries = *PrimaryData.GetEntriesInOrder();
+
+	// Scratch arrays come from this thread's FMemStack, and are all freed at once when the merge ends
+	FMemMark Mark( FMemStack::Get() );
+
+	// Primary rows each target wants FinishEntry called for. Rows from the primary come first and in the same order,
+	// so the index is the same in both
+	TArray<TArray<int32, TMemStackAllocator<>>, TMemStackAllocator<>> RowsToFinish;
+	RowsToFinish.SetNum( Targets.Num() );
+	for ( FBYGMergeTarget& Target : Targets )
+	{
+		Target.Entries.Reset( PrimaryEntries.Num() + Target.Data->GetEntriesInOrder()->Num() );
+	}
+
+	// Log lines go to whichever target is being merged
+	FBYGUpdateLog*& CurrentLog = FBYGUpdateLog::Current();
+	FBYGUpdateLog* const PreviousLog = CurrentLog;
+
+	// Each target row is only merged once unless the primary repeats a key, then every repeat gets a copy as before
+	const bool bCanTakeEntries = !PrimaryData.HasDuplicateKeys();
+	FBYGLocalizationEntry OldEntryCopy;
+
+	for ( int32 PrimaryIndex = 0; PrimaryIndex < PrimaryEntries.Num(); ++PrimaryIndex )
+	{
+		const FBYGLocalizationEntry& PrimaryEntry = PrimaryEntries[ PrimaryIndex ];
+		const uint64 KeyHash = PrimaryData.GetKeyHash( PrimaryIndex );
+
+		for ( int32 TargetIndex = 0; TargetIndex < Targets.Num(); ++TargetIndex )
+		{
+			FBYGMergeTarget& Target = Targets[ TargetIndex ];
+			CurrentLog = Target.Log ? Target.Log : PreviousLog;
+
+			const TOptional<int32> LocalIndex = Target.Data->FindIndexByHash( KeyHash, PrimaryEntry.Key );
+			FBYGLocalizationEntry* OldEntry = LocalIndex ? &Target.Data->GetMutableEntry( *LocalIndex ) : nullptr;
+			if ( OldEntry && !bCanTakeEntries )
+			{
+				OldEntryCopy = *OldEntry;
+				OldEntry = &OldEntryCopy;
+			}
+
+			if ( Target.Policy->MergeEntry( PrimaryEntry, OldEntry, Target.CultureName, Target.Entries.AddDefaulted_GetRef() ) )
+			{
+				RowsToFinish[ TargetIndex ].Add( PrimaryIndex );
+			}
+		}
+	}
+
+	for ( FBYGMergeTarget& Target : Targets )
+	{
+		CurrentLog = Target.Log ? Target.Log : PreviousLog;
+
+		// Rows the primary has kept their keys, so these are the only ones left to move
+		const int32 NumLocalEntries = Target.Data->GetEntriesInOrder()->Num();
+		for ( int32 LocalIndex = 0; LocalIndex < NumLocalEntries; ++LocalIndex )
+		{
+			FBYGLocalizationEntry& Entry = Target.Data->GetMutableEntry( LocalIndex );
+			if ( !PrimaryData.FindIndexByHash( Target.Data->GetKeyHash( LocalIndex ), Entry.Key ) )
+			{
+				// TODO
+				BYG_UPDATE_LOG( Warning, TEXT( "%s has unused key '%s', marking deprecated." ), *Target.CultureName, *Entry.Key );
+				FBYGLocalizationEntry& NewEntry = Target.Entries.Add_GetRef( MoveTemp( Entry ) );
+				NewEntry.Status = EBYGLocEntryStatus::Deprecated;
+			}
+		}
+	}
+
+	CurrentLog = PreviousLog;
+
+	for ( int32 TargetIndex = 0; TargetIndex < Targets.Num(); ++TargetIndex )
+	{
+		FBYGMergeTarget& Target = Targets[ TargetIndex ];
+		const TArray<int32, TMemStackAllocator<>>& Rows = RowsToFinish[ TargetIndex ];
+		ParallelFor( TEXT( "BYGLocalization.FinishMerge" ), Rows.Num(), 256, [&Target, &Rows, &PrimaryEntries]( int32 i )
+		{
+			Target.Policy->FinishEntry( PrimaryEntries[ Rows[ i ] ], Target.Entries[ Rows[ i ] ] );
+		} );
+	}
+}
+
+void FBYGTranslationMerge::PoolPrimary( FBYGLocaleData& PrimaryData, FBYGStringPool& StringPool )
+{
+	QUICK_SCOPE_CYCLE_COUNTER( STAT_BYGLocalization_PoolPrimary );
+
+	const int32 NumEntries = PrimaryData.GetEntriesInOrder()->Num();
+	for ( int32 EntryIndex = 0; EntryIndex < NumEntries; ++EntryIndex )
+	{
+		// Keys are left alone, the index needs them
+		FBYGLocalizationEntry& Entry = PrimaryData.GetMutableEntry( EntryIndex );
+		// The translation is still needed as text for new and Debug rows
+		Entry.PrimaryId = StringPool.Add( FStringView( Entry.Translation ) );
+		if ( Entry.CommentId == INDEX_NONE )
+		{
+			Entry.CommentId = StringPool.Add( MoveTemp( Entry.Comment ) );
+		}
+	}
+}
+
+void FBYGTranslationMerge::PoolTarget( FBYGLocaleData& Data, const FBYGStringPool& StringPool )
+{
+	QUICK_SCOPE_CYCLE_COUNTER( STAT_BYGLocalization_PoolTarget );
+
+	const int32 NumEntries = Data.GetEntriesInOrder()->Num();
+	for ( int32 EntryIndex = 0; EntryIndex < NumEntries; ++EntryIndex )
+	{
+		FBYGLocalizationEntry& Entry = Data.GetMutableEntry( EntryIndex );
+		if ( Entry.PrimaryId == INDEX_NONE )
+		{
+			Entry.PrimaryId = StringPool.Find( Entry.Primary );
+			if ( Entry.PrimaryId != INDEX_NONE )
+			{
+				Entry.Primary.Empty();
+			}
+		}
+		if ( Entry.CommentId == INDEX_NONE )
+		{
+			Entry.CommentId = StringPool.Find( Entry.Comment );
+			if ( Entry.CommentId != INDEX_NONE )
+			{
+				Entry.Comment.Empty();
+			}
+		}
+	}
+}
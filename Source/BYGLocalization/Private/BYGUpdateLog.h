@@ -0,0 +1,71 @@
+// Copyright 2017-2021 Brace Yourself Games. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BYGLocalizationCoreMinimal.h"
+
+// Buffers log lines from one file update so that updates running in parallel can be printed in a stable order
+struct FBYGUpdateLog
+{
+	void Add( ELogVerbosity::Type Verbosity, FString&& Message )
+	{
+		Lines.Add( { Verbosity, MoveTemp( Message ) } );
+	}
+
+	void Flush()
+	{
+		for ( const FLine& Line : Lines )
+		{
+			FMsg::Logf( __FILE__, __LINE__, LogBYGLocalization.GetCategoryName(), Line.Verbosity, TEXT( "%s" ), *Line.Message );
+		}
+		Lines.Empty();
+	}
+
+	// Set on the current thread by FBYGScopedUpdateLog
+	static FBYGUpdateLog*& Current()
+	{
+		static thread_local FBYGUpdateLog* CurrentLog = nullptr;
+		return CurrentLog;
+	}
+
+protected:
+	struct FLine
+	{
+		ELogVerbosity::Type Verbosity;
+		FString Message;
+	};
+	TArray<FLine> Lines;
+};
+
+// While in scope, BYG_UPDATE_LOG on this thread goes to Log instead of straight to the output
+struct FBYGScopedUpdateLog
+{
+	FBYGScopedUpdateLog( FBYGUpdateLog& Log )
+		: Previous( FBYGUpdateLog::Current() )
+	{
+		FBYGUpdateLog::Current() = &Log;
+	}
+	~FBYGScopedUpdateLog()
+	{
+		FBYGUpdateLog::Current() = Previous;
+	}
+private:
+	FBYGUpdateLog* Previous;
+};
+
+#define BYG_UPDATE_LOG( Verbosity, Format, ... ) \
+	do \
+	{ \
+		if ( FBYGUpdateLog* BYGUpdateLog = FBYGUpdateLog::Current() ) \
+		{ \
+			if ( !LogBYGLocalization.IsSuppressed( ELogVerbosity::Verbosity ) ) \
+			{ \
+				BYGUpdateLog->Add( ELogVerbosity::Verbosity, FString::Printf( Format, ##__VA_ARGS__ ) ); \
+			} \
+		} \
+		else \
+		{ \
+			UE_LOG( LogBYGLocalization, Verbosity, Format, ##__VA_ARGS__ ); \
+		} \
+	} while ( false )
@@ -0,0 +1,53 @@
+// Copyright 2017-2021 Brace Yourself Games. All Rights Reserved.
+
+#include "BYGVirtualLocale.h"
+#include "BYGMappedLocale.h"
+
+#include "Internationalization/StringTableCore.h"
+
+FBYGVirtualLocale::FBYGVirtualLocale( const TSharedRef<const FBYGVirtualLocaleTransform, ESPMode::ThreadSafe>& InTransform )
+	: Transform( InTransform )
+{
+}
+
+FStringTableRef FBYGVirtualLocale::CreateStringTable( const FBYGPreparedStringTable& Source ) const
+{
+	QUICK_SCOPE_CYCLE_COUNTER( STAT_BYGLocalization_CreateVirtualStringTable );
+
+	FStringTableRef StringTable = FStringTable::NewStringTable();
+	StringTable->SetNamespace( Source.TableID.ToString() );
+
+	// Reused for every key, so it only grows to fit the longest text
+	FString Translation;
+	auto AddEntry = [&]( const FString& Key, FStringView SourceString )
+	{
+		Translation.Reset();
+		( *Transform )( SourceString, Translation );
+		StringTable->SetSourceString( Key, Translation );
+	};
+
+	if ( Source.MappedLocale.IsValid() )
+	{
+		// Outside of the editor mapped tables have no string table to read from
+		const FBYGLocalizationBlob& Blob = Source.MappedLocale->GetBlob();
+		for ( int32 Index = 0; Index < Blob.Num(); ++Index )
+		{
+			const FStringView SourceString = Blob.GetDisplayString( Index, Source.MappedLocale->FallsBackToPrimary() );
+			if ( !SourceString.IsEmpty() )
+			{
+				AddEntry( FString( Blob.GetField( Index, EBYGLocBlobField::Key ) ), SourceString );
+			}
+		}
+	}
+	else if ( Source.StringTable.IsValid() )
+	{
+		StringTable->SetNamespace( Source.StringTable->GetNamespace() );
+		Source.StringTable->EnumerateSourceStrings( [&AddEntry]( const FString& Key, const FString& SourceString )
+		{
+			AddEntry( Key, SourceString );
+			return true;
+		} );
+	}
+
+	return StringTable;
+}
@@ -0,0 +1,23 @@
+// Copyright 2017-2021 Brace Yourself Games. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BYGLocalizationModule.h"
+
+// A language that has no files of its own, e.g. Debug. Its string table is made in memory from another language's
+// table when it's switched to, see FBYGLocalizationModule::RegisterVirtualLocale
+class FBYGVirtualLocale
+{
+public:
+	explicit FBYGVirtualLocale( const TSharedRef<const FBYGVirtualLocaleTransform, ESPMode::ThreadSafe>& InTransform );
+
+	// Runs the transform once for every key that has text in Source. The table is registered like any other, so FText
+	// properties that reference it show the virtual locale's text too
+	FStringTableRef CreateStringTable( const FBYGPreparedStringTable& Source ) const;
+
+	const TSharedRef<const FBYGVirtualLocaleTransform, ESPMode::ThreadSafe>& GetTransform() const { return Transform; }
+
+protected:
+	TSharedRef<const FBYGVirtualLocaleTransform, ESPMode::ThreadSafe> Transform;
+};
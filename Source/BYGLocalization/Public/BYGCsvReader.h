@@ -0,0 +1,109 @@
+// Copyright 2017-2021 Brace Yourself Games. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// One row handed out by FBYGCsvReader. Cells point into the reader's row buffer and are only valid during the callback
+struct FBYGCsvRow
+{
+	// Index of the row in the file, counting the header as 0 and ignoring blank lines like FCsvParser does
+	int32 Index = 0;
+	TArrayView<const FUtf8StringView> Cells;
+
+	int32 Num() const { return Cells.Num(); }
+
+	// Columns that weren't kept, or are past the end of the row, are empty
+	FUtf8StringView operator[]( int32 Column ) const
+	{
+		return Cells.IsValidIndex( Column ) ? Cells[ Column ] : FUtf8StringView();
+	}
+
+	FString GetString( int32 Column ) const;
+};
+
+// Streaming RFC 4180 reader that works straight on UTF-8 bytes, reading the file in fixed-size chunks rather than
+// widening the whole thing to TCHAR first. Rows are read the same way FCsvParser would read them: blank lines are
+// skipped, "" inside quotes is a quote, and \r\n, \n or \r end a row.
+class BYGLOCALIZATION_API FBYGCsvReader
+{
+public:
+	static const int32 ChunkSize = 64 * 1024;
+
+	// Return false to stop reading
+	typedef TFunctionRef<bool( const FBYGCsvRow& Row )> FRowCallback;
+
+	FBYGCsvReader();
+
+	// Only columns with their bit set are copied out, the rest are skipped. Can be changed from inside the
+	// callback, e.g. once the header has been read. Columns past 63 are never kept
+	void SetColumnMask( uint64 InColumnMask ) { ColumnMask = InColumnMask; }
+
+	// Returns false if the file could not be opened. UTF-16 files are converted up front since they can't be streamed
+	bool ReadFile( const FString& Filename, FRowCallback Callback );
+
+	// Feeds the next piece of the file. Chunks can split rows, cells or multi-byte characters anywhere
+	void Parse( const UTF8CHAR* Data, int64 Num, FRowCallback Callback );
+
+	// Hands out the last row if the file didn't end with a newline
+	void Finish( FRowCallback Callback );
+
+	bool IsStopped() const { return bStopped; }
+
+	// Vector scanning is used by default when the platform supports it. Only worth turning off to compare against
+	void SetUseVectorScan( bool bInUseVectorScan ) { bUseVectorScan = bInUseVectorScan && HasVectorScan(); }
+	bool IsUsingVectorScan() const { return bUseVectorScan; }
+
+	// True if built with SSE2 (AVX2 if the compiler targets it) or NEON
+	static bool HasVectorScan();
+	// e.g. "AVX2", "SSE2", "NEON" or "Scalar"
+	static const TCHAR* GetVectorScanName();
+
+	// A quoted cell was still open at the end of the file, usually a missing closing quote that swallowed every row
+	// after it
+	bool HasRunawayQuote() const { return bRunawayQuote; }
+
+	// Returns the offset of the first character that can end the current run of a cell: " inside quotes, otherwise
+	// a comma, \r or \n. Returns Num if there isn't one
+	static int64 FindSpecialCharScalar( const UTF8CHAR* Data, int64 Num, bool bInQuotes );
+	static int64 FindSpecialCharVector( const UTF8CHAR* Data, int64 Num, bool bInQuotes );
+
+protected:
+	enum class EState : uint8
+	{
+		CellStart,
+		Unquoted,
+		Quoted,
+		// Found a quote inside a quoted cell, either the end of the cell or the first half of ""
+		QuoteInQuoted,
+		// Ended a row on \r, skip the \n if there is one
+		AfterCR,
+	};
+
+	bool IsKept( int32 Column ) const { return Column < 64 && ( ColumnMask & ( 1ull << Column ) ) != 0; }
+	void ParseInternal( const UTF8CHAR* Data, int64 Num, FRowCallback Callback );
+	int64 FindSpecialChar( const UTF8CHAR* Data, int64 Num, bool bInQuotes ) const
+	{
+		return bUseVectorScan ? FindSpecialCharVector( Data, Num, bInQuotes ) : FindSpecialCharScalar( Data, Num, bInQuotes );
+	}
+	void Append( const UTF8CHAR* Data, int64 Num );
+	void EndCell();
+	void EndRow( FRowCallback Callback );
+
+	EState State = EState::CellStart;
+	uint64 ColumnMask = MAX_uint64;
+	bool bStopped = false;
+	bool bUseVectorScan = false;
+	bool bRunawayQuote = false;
+	bool bCheckedBOM = false;
+	int32 NumBOMBytesMatched = 0;
+	int32 RowIndex = 0;
+
+	// Reused between rows so reading allocates only when a row is longer than any seen before
+	TArray<UTF8CHAR> RowBuffer;
+	// Cell N is RowBuffer[ CellEnds[ N - 1 ], CellEnds[ N ] )
+	TArray<int32> CellEnds;
+	TArray<FUtf8StringView> Cells;
+	// Distinguishes a blank line from a row with one empty cell
+	bool bRowHasContent = false;
+};
@@ -0,0 +1,36 @@
+// Copyright 2017-2021 Brace Yourself Games. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Builds a CSV file as UTF-8 in a single buffer. Each cell is scanned once to decide whether it needs quoting, then
+// escaped and converted straight into the buffer, with ASCII cells copied a character at a time. Writes the same
+// bytes UBYGLocalization::WriteCSV always has: " is escaped as "", cells containing ", \r, \n or a comma are quoted
+// (every cell is if bForceQuoted), and empty cells never are.
+class BYGLOCALIZATION_API FBYGCsvWriter
+{
+public:
+	explicit FBYGCsvWriter( bool bInForceQuoted = false ) : bForceQuoted( bInForceQuoted ) {}
+
+	void Reserve( int32 NumBytes ) { Output.Reserve( NumBytes ); }
+
+	// Cells are separated by commas until EndRow. Keys are never quoted, so pass bAllowQuotes = false for them
+	void AddCell( FStringView Text, bool bAllowQuotes = true );
+	void EndRow();
+
+	// Copied without escaping, e.g. the header row
+	void AddRaw( FStringView Text );
+
+	const TArray<uint8>& GetOutput() const { return Output; }
+
+	// Writes out what has been built so far and empties the buffer, keeping its memory for the next chunk
+	void Flush( FArchive& Ar );
+
+protected:
+	void AddUTF8( const TCHAR* Data, int32 Len );
+
+	TArray<uint8> Output;
+	bool bForceQuoted = false;
+	bool bRowStarted = false;
+};
@@ -0,0 +1,38 @@
+// Copyright 2017-2021 Brace Yourself Games. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FBYGLocalizationEntry;
+
+// Maps localization keys to their index in an array of entries. Every key is hashed once when the index is built, and
+// the hashes live in a flat open-addressed table with the hashes and indices in separate arrays, so probing only
+// touches hashes. Keys are case-insensitive, the same as TMap<FString, ...>.
+class BYGLOCALIZATION_API FBYGKeyIndex
+{
+public:
+	// Keys that appear more than once keep their first index, the later ones are added to OutDuplicates
+	void Build( TArrayView<const FBYGLocalizationEntry> Entries, TArray<int32>* OutDuplicates = nullptr );
+
+	void Reset();
+
+	// Entries must be the same entries the index was built from
+	TOptional<int32> Find( FStringView Key, TArrayView<const FBYGLocalizationEntry> Entries ) const;
+	// Same as Find, with the hash already worked out by FBYGLocalizationHash::HashKey
+	TOptional<int32> FindByHash( uint64 KeyHash, FStringView Key, TArrayView<const FBYGLocalizationEntry> Entries ) const;
+
+	// Hash of the key of every entry the index was built from, so other indices can be searched without hashing again
+	uint64 GetKeyHash( int32 EntryIndex ) const { return EntryHashes[ EntryIndex ]; }
+
+	int32 Num() const { return NumKeys; }
+
+protected:
+	// Power of two sized, with an index of INDEX_NONE for empty slots
+	TArray<uint64> SlotHashes;
+	TArray<int32> SlotIndices;
+	uint32 SlotMask = 0;
+	int32 NumKeys = 0;
+
+	TArray<uint64> EntryHashes;
+};
@@ -5,6 +5,10 @@
 #include "CoreMinimal.h"
 #include "Internationalization/Culture.h"
 #include "Delegates/DelegateCombinations.h"
+#include "BYGKeyIndex.h"
+#include "BYGStringPool.h"
+#include "Tasks/Task.h"
+#include <atomic>
 #include "BYGLocalization.generated.h"
 
 UDELEGATE()
@@ -34,13 +38,15 @@ struct FBYGLocaleInfo
 	FString FilePath;
 };
 
+DECLARE_MULTICAST_DELEGATE_OneParam( FOnLocalizationFileModified, const FBYGLocaleInfo& );
+
 struct FBYGLocalizationEntry
 {
 	FBYGLocalizationEntry() {}
 	FBYGLocalizationEntry( FString Key_, FString Translation_, FString Comment_ )
-		: Key( Key_ )
-		, Translation( Translation_ )
-		, Comment( Comment_ )
+		: Key( MoveTemp( Key_ ) )
+		, Translation( MoveTemp( Translation_ ) )
+		, Comment( MoveTemp( Comment_ ) )
 	{
 	}
 	FString Key;
@@ -49,43 +55,121 @@ struct FBYGLocalizationEntry
 	FString Primary;
 	FString OldPrimary; // Not in CSV
 	EBYGLocEntryStatus Status = EBYGLocEntryStatus::None;
+
+	// Set instead of Primary and Comment while the text is held by an FBYGStringPool, see FBYGTranslationMerge::PoolPrimary.
+	// In a primary file PrimaryId is the row's own translation, which is what its translations have as their Primary
+	int32 PrimaryId = INDEX_NONE;
+	int32 CommentId = INDEX_NONE;
+
+	const FString& GetPrimary( const FBYGStringPool* StringPool ) const { return PrimaryId != INDEX_NONE ? StringPool->Get( PrimaryId ) : Primary; }
+	const FString& GetComment( const FBYGStringPool* StringPool ) const { return CommentId != INDEX_NONE ? StringPool->Get( CommentId ) : Comment; }
 };
 
 // Internal data structure for 
-struct FBYGLocaleData
+struct BYGLOCALIZATION_API FBYGLocaleData
 {
 public:
 	FBYGLocaleData() {}
 	FBYGLocaleData( const TArray<FBYGLocalizationEntry>& NewEntries );
+	FBYGLocaleData( TArray<FBYGLocalizationEntry>&& NewEntries );
 
 	inline const TArray<FBYGLocalizationEntry>* GetEntriesInOrder() const { return &EntriesInOrder; }
-	inline const TMap<FString, int32>* GetKeyToIndex() const { return &KeyToIndex; }
+	// For moving values out of an entry. Its key has to stay as it was or it can't be found any more
+	inline FBYGLocalizationEntry& GetMutableEntry( int32 EntryIndex ) { return EntriesInOrder[ EntryIndex ]; }
+	inline bool HasDuplicateKeys() const { return bHasDuplicateKeys; }
+
+	inline TOptional<int32> FindIndex( FStringView Key ) const { return KeyIndex.Find( Key, EntriesInOrder ); }
+	// For looking up a key from another FBYGLocaleData without hashing it again, see GetKeyHash
+	inline TOptional<int32> FindIndexByHash( uint64 KeyHash, FStringView Key ) const { return KeyIndex.FindByHash( KeyHash, Key, EntriesInOrder ); }
+	inline uint64 GetKeyHash( int32 EntryIndex ) const { return KeyIndex.GetKeyHash( EntryIndex ); }
 
 protected:
+	void BuildKeyIndex();
+
 	TArray<FBYGLocalizationEntry> EntriesInOrder;
-	TMap<FString, int32> KeyToIndex;
+	FBYGKeyIndex KeyIndex;
+	bool bHasDuplicateKeys = false;
 };
 
 typedef TMap<EBYGLocEntryStatus, int32> BYGLocStats;
 
+// Handle to a translation update running in the background, see UBYGLocalization::UpdateTranslationsAsync
+class BYGLOCALIZATION_API FBYGTranslationUpdate
+{
+public:
+	// Files that haven't started updating yet are skipped. Files already being written are finished
+	void Cancel() { bCancelRequested = true; }
+	bool IsCancelled() const { return bCancelRequested; }
+
+	bool IsComplete() const;
+
+	// 0-1, based on the number of translation files processed
+	float GetProgress() const;
+
+	// Blocks until the update is done. Returns the same as UBYGLocalization::UpdateTranslations
+	bool Wait() const;
+
+	// Only valid once complete. Skipped files were unchanged since their last merge, merged files were read and
+	// written back, and rewritten is the subset of merged files whose contents actually changed
+	int32 GetNumFilesSkipped() const { return NumFilesSkipped; }
+	int32 GetNumFilesMerged() const { return NumFilesMerged; }
+	int32 GetNumFilesRewritten() const { return NumFilesRewritten; }
+
+protected:
+	friend class UBYGLocalization;
+
+	int32 NumFiles = 0;
+	std::atomic<int32> NumFilesCompleted { 0 };
+	std::atomic<bool> bCancelRequested { false };
+	std::atomic<bool> bSucceeded { false };
+	int32 NumFilesSkipped = 0;
+	int32 NumFilesMerged = 0;
+	int32 NumFilesRewritten = 0;
+	UE::Tasks::FTask Task;
+};
+
+struct FBYGTranslationUpdatePlan;
+class FBYGLocaleCatalog;
+
 // Internal data structure used for	updating non-primary localizations based on the information in the primary
 // We re-order entries in the non-primary to match those of the 
 class BYGLOCALIZATION_API UBYGLocalization
 {
 public:
+	UBYGLocalization();
+	~UBYGLocalization();
 
 	// Returns a map from filename to display name
 	TArray<FBYGLocaleInfo> GetAvailableLocalizations(TOptional<FString> LocaleFilter = TOptional<FString>(), TOptional<FString> CategoryFilter = TOptional<FString>()) const;
 
+	// Same as GetAvailableLocalizations with both filters, without copying the others
+	bool FindLocalization( const FString& LocaleCode, const FString& Category, FBYGLocaleInfo& OutInfo ) const;
+
+	// Localization files are only searched for once, then kept track of by the directory watcher in the editor.
+	// Call after changing any of the settings that decide where files are found or what they're called
+	void InvalidateLocalizationCatalog();
+	// Call after creating a localization file, so it can be found straight away
+	void AddLocalizationFile( const FString& FileWithPath );
+
 	// Returns false when no primary translations found
 	bool UpdateTranslations();
 
+	// Same as UpdateTranslations but returns immediately. Files are updated in parallel either way
+	TSharedRef<FBYGTranslationUpdate> UpdateTranslationsAsync();
+
+	// Writes a compiled .bygloc next to every localization file whose compiled form is missing or out of date.
+	// Returns false if any file failed to compile
+	bool CompileLocalizations( bool bForce = false ) const;
+
 	bool GetLocalizationStats( const FString& Filename, BYGLocStats& StatusCounts ) const;
 
 	bool GetLocaleFromPreferences( FBYGLocaleInfo& FoundLocale ) const;
 
 	FBYGLocaleInfo GetCultureFromFilename( const FString& FileWithPath ) const;
 
+	// Native name of the language if the engine knows it, otherwise the code itself
+	static FText GetLocalizedLocaleName( const FString& LocaleCode );
+
 	// Returns an expected filename based on the user settings 
 	FString GetFilenameFromLanguageCode(const FString& LanguageCode, const FString& Category) const;
 
@@ -103,16 +187,27 @@ public:
 
 	FOnLocalizationChanged OnLocalizationChanged;
 
+	// Called on the game thread when a localization file is saved while the editor is running, only once the
+	// directory watcher has started, i.e. after the first lookup
+	FOnLocalizationFileModified OnLocalizationFileModified;
+
 protected:
 
+	// Works out which files need updating. Must be called on the game thread
+	void PrepareTranslationUpdate( FBYGTranslationUpdatePlan& Plan ) const;
+	void RunTranslationUpdate( FBYGTranslationUpdatePlan& Plan, FBYGTranslationUpdate& Update );
+
 	bool GetLocalizationDataFromFile( const FString& Filename, FBYGLocaleData& LocalizationData ) const;
-	bool UpdateTranslationFile(const FString& Path, const TArray<FBYGLocalizationEntry>* PrimaryEntriesInOrder, const TMap<FString, int32>* PrimaryKeyToIndex);
-	bool UpdateDebugFile(const FString& Path, const TArray<FBYGLocalizationEntry>* PrimaryEntriesInOrder, const TMap<FString, int32>* PrimaryKeyToIndex);
-	void GenerateDebugTranslation(const FString& PrimaryEntry, FString &DebugTranslation);
+	// Reads a translation file so it can be merged with its primary, see FBYGTranslationMerge. Returns false if it
+	// shouldn't be updated, e.g. it's read-only
+	bool LoadTranslationFile( const FString& Path, bool bIsDebug, FBYGLocaleData& LocalData ) const;
+	// Merges a single translation with its primary and writes it back
+	bool UpdateTranslationFile( const FString& Path, const FBYGLocaleData& PrimaryData );
 
-	TArray<FString> GetAllLocalizationFiles() const;
 	// Writes datastructure to CSV but with explicit quoting etc.
-	bool WriteCSV( const TArray<FBYGLocalizationEntry>& Entries, const FString& Filename );
+	// Leaves the file untouched if its contents would not change, bOutChanged is set to whether it was written
+	// StringPool is needed if any entries have pooled text
+	bool WriteCSV( const TArray<FBYGLocalizationEntry>& Entries, const FString& Filename, bool* bOutChanged = nullptr, const FBYGStringPool* StringPool = nullptr );
 
 	FString RemovePrefixSuffix(const FString& FileWithExtension) const;
 	void SplitCategoryAndCulture(const FString& CategoryAndCulture, FString &Category, FString &Culture) const;
@@ -121,11 +216,15 @@ protected:
 
 	static FString LazyWrap( const FString& InStr, bool bForceWrap = false );
 
+	TUniquePtr<FBYGLocaleCatalog> Catalog;
+	friend class FBYGLocaleCatalog;
+
 	// Hacky testing
 	friend class FBYGEscapeCharacterTest;
 	friend class FBYGLazyWrapTest;
 	friend class FBYGWriteCSVTest;
 	friend class FBYGFullLoopTest;
+	friend class FBYGHeaderTest;
 
 };
 
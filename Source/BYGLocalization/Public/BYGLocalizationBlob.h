@@ -0,0 +1,128 @@
+// Copyright 2017-2021 Brace Yourself Games. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Internationalization/StringTableCoreFwd.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+// Columns stored for every row, in the same order as the CSV
+enum class EBYGLocBlobField : uint8
+{
+	Key,
+	SourceString,
+	Comment,
+	Primary,
+	Status,
+	Count
+};
+
+// Compiled form of a single loc_<Category>_<Code>.csv file, so it can be loaded without parsing the CSV.
+//
+// Layout:
+//   FHeader
+//   FEntry[ NumEntries ]         string pool offsets for every column, in CSV order
+//   FHashSlot[ NumEntries ]      key hashes sorted ascending, for lookups without building a map
+//   TCHAR[ StringPoolLength ]    string pool
+class BYGLOCALIZATION_API FBYGLocalizationBlob
+{
+public:
+	FBYGLocalizationBlob();
+	~FBYGLocalizationBlob();
+
+	FBYGLocalizationBlob( const FBYGLocalizationBlob& ) = delete;
+	FBYGLocalizationBlob& operator=( const FBYGLocalizationBlob& ) = delete;
+
+	// Bump whenever the layout changes. Blobs with a different version are ignored and the CSV is used instead
+	static const uint32 Version = 3;
+	static const uint32 Magic = 0x4C475942; // "BYGL"
+
+	// Compiled files live next to their CSV, e.g. loc_Game_fr.csv -> loc_Game_fr.bygloc
+	static FString GetBlobFilename( const FString& SourceFilename );
+
+	// Parses the CSV and writes its compiled form
+	static bool Compile( const FString& SourceFilename, const FString& BlobFilename );
+
+	// Returns false if the blob is missing, invalid or SourceFilename's size or modification time changed since it was
+	// compiled. If SourceFilename does not exist (e.g. only compiled files were packaged), or this is a cooked build,
+	// the blob is trusted.
+	bool LoadFromFile( const FString& BlobFilename, const FString& SourceFilename );
+
+	// Same as LoadFromFile but maps the blob read-only instead of copying it into memory, so only the pages that
+	// are actually looked up become resident. Falls back to LoadFromFile on platforms that can't map files.
+	bool MapFile( const FString& BlobFilename, const FString& SourceFilename );
+
+	bool IsMapped() const { return MappedRegion.IsValid(); }
+
+	// Memory the blob was read into, 0 if it's mapped
+	SIZE_T GetAllocatedSize() const { return Data.GetAllocatedSize(); }
+
+	int32 Num() const { return Header ? Header->NumEntries : 0; }
+
+	FStringView GetField( int32 EntryIndex, EBYGLocBlobField Field ) const;
+
+	// Returns INDEX_NONE if not found. Keys are case-sensitive, the same as in FStringTable
+	int32 FindEntry( FStringView Key ) const;
+
+	// Builds a string table with the same contents FStringTable::ImportStrings would have produced from the CSV.
+	// With bFallBackToPrimary, entries without a translation use their Primary column instead
+	FStringTableRef CreateStringTable( const FString& Namespace, bool bFallBackToPrimary = false ) const;
+
+	// The translation, or with bFallBackToPrimary the Primary column if there isn't one. Empty if neither is set
+	FStringView GetDisplayString( int32 EntryIndex, bool bFallBackToPrimary ) const
+	{
+		const FStringView SourceString = GetField( EntryIndex, EBYGLocBlobField::SourceString );
+		return SourceString.IsEmpty() && bFallBackToPrimary ? GetField( EntryIndex, EBYGLocBlobField::Primary ) : SourceString;
+	}
+
+protected:
+	struct FHeader
+	{
+		uint32 Magic;
+		uint32 Version;
+		// FDateTime ticks of the source's modification time
+		int64 SourceTimestamp;
+		int64 SourceSize;
+		int32 NumEntries;
+		// In characters
+		int32 StringPoolLength;
+		// Blobs are only valid on platforms with the same TCHAR size
+		uint32 CharSize;
+		uint32 Reserved;
+	};
+
+	struct FPoolString
+	{
+		uint32 Offset;
+		uint32 Length;
+	};
+
+	struct FEntry
+	{
+		FPoolString Fields[ (int32)EBYGLocBlobField::Count ];
+	};
+
+	struct FHashSlot
+	{
+		uint64 KeyHash;
+		int32 EntryIndex;
+		int32 Reserved;
+	};
+
+	bool SetData( const uint8* InData, int64 InSize );
+	bool SetDataIfUpToDate( const uint8* InData, int64 InSize, const FString& BlobFilename, const FString& SourceFilename );
+	void Reset();
+	static bool IsSourceUnchanged( const FString& SourceFilename, int64 ExpectedSize, int64 ExpectedTimestamp );
+
+	// Only one of Data or MappedRegion is used
+	TArray<uint8> Data;
+	TUniquePtr<IMappedFileHandle> MappedHandle;
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+
+	const FHeader* Header = nullptr;
+	const FEntry* Entries = nullptr;
+	const FHashSlot* HashSlots = nullptr;
+	const TCHAR* StringPool = nullptr;
+};
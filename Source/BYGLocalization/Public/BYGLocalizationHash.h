@@ -0,0 +1,48 @@
+// Copyright 2017-2021 Brace Yourself Games. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Hash/CityHash.h"
+
+struct FBYGLocalizationHash
+{
+	// Case-insensitive, to match the way FString keys are compared by TMap
+	static inline uint64 HashKey( FStringView Key )
+	{
+		// 64-bit FNV-1a
+		uint64 Hash = 0xcbf29ce484222325ull;
+		for ( const TCHAR Char : Key )
+		{
+			Hash ^= static_cast<uint64>( FChar::ToLower( Char ) );
+			Hash *= 0x100000001b3ull;
+		}
+		return Hash;
+	}
+
+	// Case-sensitive, to match FTextKey, which string tables are keyed by
+	static inline uint64 HashTextKey( FStringView Key )
+	{
+		// 64-bit FNV-1a
+		uint64 Hash = 0xcbf29ce484222325ull;
+		for ( const TCHAR Char : Key )
+		{
+			Hash ^= static_cast<uint64>( Char );
+			Hash *= 0x100000001b3ull;
+		}
+		return Hash;
+	}
+
+	// Case-sensitive, for telling text apart
+	static inline uint64 HashString( FStringView String )
+	{
+		return HashBuffer( String.GetData(), String.Len() * sizeof( TCHAR ) );
+	}
+
+	// Used to tell if a file's contents have changed
+	static inline uint64 HashBuffer( const void* Data, int64 Size )
+	{
+		check( Size >= 0 && Size <= MAX_uint32 );
+		return CityHash64( static_cast<const char*>( Data ), static_cast<uint32>( Size ) );
+	}
+};
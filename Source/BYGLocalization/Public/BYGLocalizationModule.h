@@ -3,8 +3,47 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Async/Future.h"
+#include "Containers/Ticker.h"
+#include "Internationalization/StringTableCoreFwd.h"
 #include "Modules/ModuleManager.h"
 #include "UObject/GCObject.h"
+#include <atomic>
+
+struct FBYGLocaleTableSet;
+struct FBYGLocaleInfo;
+
+// There's no directory watcher outside of the editor, so development builds check the current language's files for
+// changes instead
+#define BYG_LOCALIZATION_POLL_FILES ( !WITH_EDITOR && !UE_BUILD_SHIPPING )
+
+// Makes the text for a virtual locale from the primary language's text. Called on a worker thread for every key when
+// the locale's tables are built
+using FBYGVirtualLocaleTransform = TFunction<void( FStringView SourceString, FString& OutString )>;
+
+// One category's string table, built without touching the string table registry so that it can be done on any thread
+struct FBYGPreparedStringTable
+{
+	FName TableID;
+	// Not set for memory-mapped tables outside of the editor. For virtual locales it's made from the primary language's
+	// table
+	FStringTablePtr StringTable;
+	TSharedPtr<class FBYGMappedLocale> MappedLocale;
+	TSharedPtr<class FBYGVirtualLocale> VirtualLocale;
+};
+
+struct FBYGWarmLocaleStats
+{
+	// Languages whose tables are built, including the current one
+	int32 NumLocales = 0;
+	int32 NumLoading = 0;
+	int64 MemoryBytes = 0;
+
+	// Language changes that could reuse built tables, and ones that had to wait for them to load
+	int32 NumHits = 0;
+	int32 NumMisses = 0;
+	int32 NumEvictions = 0;
+};
 
 class FBYGLocalizationModule : public IModuleInterface, public FGCObject
 {
@@ -36,12 +75,107 @@ public:
 	inline FString GetCurrentLanguageCode() { return CurrentLanguageCode; }
 	inline void SetCurrentLanguageCode(FString InCurrentLanguageCode) { CurrentLanguageCode = InCurrentLanguageCode; }
 
+	// Loads every category for the language, swaps them in and broadcasts OnLocalizationChanged. Returns false if the
+	// language isn't in use
+	bool SetLanguage( const FString& Code );
+
+	// Same as SetLanguage, but the string tables are built on worker threads and swapped in together on the game
+	// thread, so the current language stays usable until then. Resolves to false if the language isn't in use, or if
+	// another language was set before this one finished loading
+	TFuture<bool> SetLanguageAsync( const FString& Code );
+
+	// Starts loading a language in the background and keeps it in the warm locale cache, so that switching to it
+	// is instant, e.g. when it's highlighted in an options menu. Does nothing if it's already loaded or loading
+	void PrefetchLocale( const FString& Code );
+
+	FBYGWarmLocaleStats GetWarmLocaleStats() const;
+	// Most recently used first, including the current language and any still loading
+	TArray<FString> GetWarmLocaleCodes() const;
+	void ClearWarmLocales();
+
+	// Adds a language with no files of its own. Its string tables are made in memory from the primary language's tables
+	// with Transform when it's switched to, so nothing is written, and nothing is read if the primary is loaded.
+	// Registering a code again replaces its transform, and reloads it if it's the current language. Debug is registered
+	// this way unless UBYGLocalizationSettings::bUseVirtualDebugLocale is off
+	void RegisterVirtualLocale( const FString& Code, FBYGVirtualLocaleTransform Transform );
+	void UnregisterVirtualLocale( const FString& Code );
+	bool IsVirtualLocale( const FString& Code ) const { return VirtualLocales.Contains( Code ); }
+
+	// Registers or unregisters Debug as a virtual locale to match the settings
+	void UpdateDebugLocale();
+
+	// Registers the string table for a single localization file, using the compiled form if enabled and up to date.
+	// FilePath is relative to the project content directory
+	void LoadStringTable( const FName& TableID, const FString& Category, const FString& FilePath );
+	void UnloadStringTable( const FName& TableID );
+
+	// LoadStringTable split in two, the first half is thread-safe and the second must be on the game thread
+	static FBYGPreparedStringTable PrepareStringTable( const FName& TableID, const FString& Category, const FString& FilePath );
+	void RegisterStringTable( const FBYGPreparedStringTable& Prepared );
+
+	// Wraps a table prepared for the primary language so that it shows a virtual locale's text
+	static FBYGPreparedStringTable MakeVirtualStringTable( const FBYGPreparedStringTable& Source, const TSharedRef<const FBYGVirtualLocaleTransform, ESPMode::ThreadSafe>& Transform );
+
+	// Only set when the table was loaded with bMemoryMapCompiledLocalizations
+	TSharedPtr<const class FBYGMappedLocale> FindMappedTable( const FName& TableID ) const;
+	// Only set while a virtual locale is the current language
+	TSharedPtr<const class FBYGVirtualLocale> FindVirtualTable( const FName& TableID ) const;
+
+	// Changes whenever a string table is loaded, unloaded or edited, so anything cached from them knows to look again.
+	// Doesn't need the module to be loaded, it's checked on every GetGameText
+	static uint32 GetStringTableGeneration() { return StringTableGeneration.load( std::memory_order_acquire ); }
+	static void NotifyStringTablesChanged() { StringTableGeneration.fetch_add( 1, std::memory_order_acq_rel ); }
+
 protected:
 	void UnloadLocalizations();
 
+	bool IsLanguageInUse( const FString& Code ) const;
+	// The language whose files are read for Code, which is the primary language for virtual locales
+	FString GetFileLanguageCode( const FString& Code ) const;
+
+	// Everything to do with the warm locale cache happens on the game thread, apart from BuildTableSet
+	TSharedPtr<FBYGLocaleTableSet, ESPMode::ThreadSafe> FindWarmLocale( const FString& Code );
+	TSharedRef<FBYGLocaleTableSet, ESPMode::ThreadSafe> MakeTableSet( const FString& Code ) const;
+	TSharedRef<FBYGLocaleTableSet, ESPMode::ThreadSafe> StartLoadingLocale( const FString& Code );
+	static void BuildTableSet( FBYGLocaleTableSet& TableSet );
+	void ApplyTableSet( const TSharedRef<FBYGLocaleTableSet, ESPMode::ThreadSafe>& TableSet );
+	// The part of ApplyTableSet that registers the tables, without changing the culture or broadcasting
+	void RegisterTableSet( const TSharedRef<FBYGLocaleTableSet, ESPMode::ThreadSafe>& TableSet );
+	void TrimWarmLocales();
+
+	// Hot reloading, see UBYGLocalizationSettings::bHotReloadLocalizations. The category is parsed on a worker thread
+	// and swapped in on the game thread
+	void OnLocalizationFileModified( const FBYGLocaleInfo& Info );
+	void StartHotReload( const FString& Category, const FString& FilePath, double StartTime );
+	void FinishHotReload( const FString& Category, const FString& FilePath, const FBYGPreparedStringTable& Prepared, double StartTime, double ParseTime, uint32 Generation );
+#if BYG_LOCALIZATION_POLL_FILES
+	bool PollLocalizationFiles( float DeltaTime );
+#endif
+
 	// TODO FGCObject
 	TSharedPtr<class UBYGLocalization> Loc;
 
 	TArray<FName> StringTableIDs;
+	TMap<FName, TSharedPtr<class FBYGMappedLocale>> MappedTables;
+	TMap<FName, TSharedPtr<class FBYGVirtualLocale>> VirtualTables;
+	TMap<FString, TSharedPtr<const FBYGVirtualLocaleTransform, ESPMode::ThreadSafe>> VirtualLocales;
 	FString CurrentLanguageCode;
+
+	// Bumped by every language change, so async changes that were overtaken by a newer one are dropped
+	uint32 LanguageChangeGeneration = 0;
+
+	// Most recently used first. Includes the current language and any still loading
+	TArray<TSharedRef<FBYGLocaleTableSet, ESPMode::ThreadSafe>> WarmLocales;
+	TSharedPtr<FBYGLocaleTableSet, ESPMode::ThreadSafe> CurrentTableSet;
+	FBYGWarmLocaleStats WarmLocaleStats;
+
+	// Categories being reloaded, and whether their file was saved again since the reload started
+	TMap<FString, bool> HotReloadsInFlight;
+#if BYG_LOCALIZATION_POLL_FILES
+	FTSTicker::FDelegateHandle PollFilesHandle;
+	// Relative path to modification time
+	TMap<FString, FDateTime> PolledFileTimes;
+#endif
+
+	static std::atomic<uint32> StringTableGeneration;
 };
@@ -121,7 +121,7 @@ public:
 	UPROPERTY( config, EditAnywhere, Category = "File Settings" )
 	TArray<FString> AllowedExtensions = { "txt" };
 
-	// Creates a backup of the original file when changing any localization files
+	// Copies the original file before changing any localization files, e.g. to Saved/BYGLocalization/Backup/Content/Localization/loc_Game_fr.csv.bak
 	UPROPERTY( config, EditAnywhere, Category = "File Settings" )
 	bool bCreateBackup = true;
 
@@ -133,6 +133,11 @@ public:
 	UPROPERTY( config, EditAnywhere, AdvancedDisplay, Category = "File Settings" )
 	bool bAllowOverwriteReadOnlyFiles = false;
 
+	// When true, saving a localization file for the current language reloads just that category, in the editor and
+	// in development builds. OnLocalizationChanged is only broadcast if the text actually changed
+	UPROPERTY( config, EditAnywhere, Category = "File Settings" )
+	bool bHotReloadLocalizations = true;
+
 	// This can be used to differentiate between multiple localizations of the same language.
 	// e.g. Adding "_meta_author,Fan A,," key to the loc_fr.csv localization file will result in the language showing up as French (Fan A)
 	// if there are multiple French localizations
@@ -174,6 +179,68 @@ public:
 
 
 
+	// When true, localization files are loaded from their compiled .bygloc form instead of parsing the CSV.
+	// Falls back to the CSV if the compiled file is missing or the CSV has changed since it was compiled.
+	// Compiled files are rebuilt in-editor after updating translations, or with -run=BYGLocalizationCompile
+	UPROPERTY( config, EditAnywhere, Category = "Performance" )
+	bool bUseCompiledLocalizations = false;
+
+	// When true, compiled localization files are memory-mapped read-only instead of being copied into string tables.
+	// GetGameText reads translations straight from the mapping and only builds an FText the first time a key is used,
+	// so untouched text never becomes resident. FText properties that reference string tables directly will not
+	// resolve outside of the editor in this mode, use GetGameText instead.
+	UPROPERTY( config, EditAnywhere, Category = "Performance", meta = ( EditCondition = "bUseCompiledLocalizations" ) )
+	bool bMemoryMapCompiledLocalizations = false;
+
+	// When true, keys that haven't been translated yet show the Primary column that updating translations writes into
+	// every translation file, so they appear in the primary language from the same string table. GetGameText then
+	// only looks in one table, instead of also looking in a table named after the PrimaryLanguageCode
+	UPROPERTY( config, EditAnywhere, Category = "Performance" )
+	bool bUseEmbeddedPrimaryFallback = false;
+
+	// Maximum number of translation files updated at the same time when updating translations. 0 uses one per
+	// worker thread, 1 updates them one after the other.
+	UPROPERTY( config, EditAnywhere, Category = "Performance", meta = ( ClampMin = 0 ) )
+	int32 MaxTranslationUpdateThreads = 0;
+
+	// When true, translations are only merged again if they or their primary changed since the last update.
+	// File sizes, modification times and content hashes are kept in
+	// Intermediate/BYGLocalization/BYGTranslationManifest.bin
+	UPROPERTY( config, EditAnywhere, Category = "Performance" )
+	bool bIncrementalTranslationUpdate = true;
+
+	// Number of languages, besides the current one, whose string tables are kept loaded after switching away from
+	// them or prefetching them, so switching to them again doesn't read any files. 0 turns off prefetching too
+	UPROPERTY( config, EditAnywhere, Category = "Performance", meta = ( ClampMin = 0 ) )
+	int32 WarmLocaleCacheSize = 2;
+
+	// Least recently used languages are dropped while the estimated size of all loaded languages is over this.
+	// 0 for no limit
+	UPROPERTY( config, EditAnywhere, Category = "Performance", meta = ( ClampMin = 0 ) )
+	int32 WarmLocaleCacheMaxMemoryMB = 64;
+
+
+
+	// When true, the Debug localization is made in memory from the primary language when it's switched to, instead of
+	// being written to Debug/loc_<Category>_Debug.csv files when updating translations and read back from them
+	UPROPERTY( config, EditAnywhere, Category = "Debug Localization" )
+	bool bUseVirtualDebugLocale = true;
+
+	// Length of the Debug localization's text compared to the primary, to find text that won't fit once
+	// translated. Extra characters are added by repeating vowels
+	UPROPERTY( config, EditAnywhere, Category = "Debug Localization", meta = ( ClampMin = 1 ) )
+	float PseudoLocalizationExpansion = 1.5f;
+
+	// Swap letters for accented versions of themselves in the Debug localization, to find missing glyphs
+	UPROPERTY( config, EditAnywhere, Category = "Debug Localization" )
+	bool bPseudoLocalizationAccents = false;
+
+	// Surround the Debug localization's text with [ ], to find text that is cut off or isn't localized
+	UPROPERTY( config, EditAnywhere, Category = "Debug Localization" )
+	bool bPseudoLocalizationBrackets = true;
+
+
+
 	// WARNING: Changing this string will break any existing FText entries that are saved in Blueprints. Set it once at the start of the project and never change it.
 	UPROPERTY( config, EditAnywhere, AdvancedDisplay, Category = "Internal Settings" )
 	FString StringtableID = "Game";
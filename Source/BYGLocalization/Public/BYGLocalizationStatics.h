@@ -4,6 +4,8 @@
 
 #include "CoreMinimal.h"
 #include "BYGLocalization.h"
+#include "BYGTextKey.h"
+#include "Async/Future.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "BYGLocalizationStatics.generated.h"
 
@@ -15,9 +17,32 @@ class BYGLOCALIZATION_API UBYGLocalizationStatics : public UBlueprintFunctionLib
 	GENERATED_BODY()
 public:
 	// Primary way for dynamically setting up localized strings. Uses the currently-loaded String Table
+	// Results are cached until a string table is loaded, unloaded or edited, so it's cheap to call every frame
 	UFUNCTION( BlueprintCallable, Category = "BYG|Localization" )
 	static FText GetGameText( const FString& Key );
 
+	// Same as GetGameText for a key that has already been hashed with FBYGLocalizationHash::HashTextKey. Reads from
+	// Category's table if set, in which case the result isn't cached
+	static FText ResolveGameText( const FString& Key, uint64 KeyHash, const FString& Category = FString() );
+
+	UFUNCTION( BlueprintPure, Category = "BYG|Localization", meta = ( AutoCreateRefTerm = "Category" ) )
+	static FBYGTextKey MakeTextKey( const FString& Key, const FString& Category );
+
+	// For text keys that are shown all the time. Only looked up again after the string tables change
+	UFUNCTION( BlueprintPure, Category = "BYG|Localization" )
+	static FText GetTextFromKey( const FBYGTextKey& TextKey );
+
+	// Looks up many keys at once, e.g. to fill a list. Tables are only looked up once, keys that appear more than once
+	// are only resolved once, and missing keys are logged as a single line rather than one per key.
+	// Reads from Category's table if set, otherwise from the same table as GetGameText, sharing its cache.
+	// Bit N of MissingKeys is set if Keys[N] wasn't found, 32 keys per element. Returns the number of missing keys
+	UFUNCTION( BlueprintCallable, Category = "BYG|Localization", meta = ( AutoCreateRefTerm = "Category" ) )
+	static int32 GetGameTexts( const TArray<FString>& Keys, TArray<FText>& OutTexts, TArray<int32>& MissingKeys, const FString& Category = "" );
+
+	// For reading the MissingKeys mask from GetGameTexts
+	UFUNCTION( BlueprintPure, Category = "BYG|Localization" )
+	static bool IsGameTextMissing( const TArray<int32>& MissingKeys, int32 Index );
+
 	// Returns false if either table or text does not exist
 	UFUNCTION( BlueprintCallable, Category = "BYG|Localization" )
 	static bool HasTextInTable( const FString& TableName, const FString& Key );
@@ -27,6 +52,15 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "BYG|Localization")
 	static bool SetLocalizationByCode(const FString& Code);
 
+	// Loads the new localization in the background and only swaps it in once it's ready, to avoid a hitch. The old
+	// one can still be used until then. See UBYGSetLocalizationAsyncAction for Blueprints
+	static TFuture<bool> SetLocalizationByCodeAsync(const FString& Code);
+
+	// Starts loading a localization in the background so that switching to it is instant, e.g. when it's highlighted
+	// in an options menu. It's kept loaded until enough other localizations have been used since
+	UFUNCTION(BlueprintCallable, Category = "BYG|Localization")
+	static void PrefetchLocalizationByCode(const FString& Code);
+
 	UFUNCTION(BlueprintCallable, Category = "BYG|Localization|String Tables", meta = (AutoCreateRefTerm = "StringTableID,Key"))
 	static void SetTextAsStringTableEntry(UPARAM(ref) FText &Text, const FName &StringTableID, const FString &Key);
 
@@ -51,7 +85,14 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "BYG|Localization", meta = (AutoCreateRefTerm = "Category,Filename"))
 	static void UpdateCSV(const FString &Category, const FString &Filename);
 
+	// Writes the current language's file for every category, exporting them in parallel
+	UFUNCTION(BlueprintCallable, Category = "BYG|Localization")
+	static bool UpdateAllCSVs();
+
+	// Streams the table to the file a chunk at a time, so memory use doesn't grow with the table
 	static bool ExportStrings(const FName StringTableName, const FString& InFilename);
+	// Exports each table to its file, several at once. Returns false if any of them failed
+	static bool ExportStrings(const TArray<TPair<FName, FString>>& TablesAndFilenames);
 
 	UFUNCTION(BlueprintCallable, Category = "BYG|Localization", meta = (AutoCreateRefTerm = "LanguageCode,Categroy"))
 	static void GetLocalizationFilePath(const FString &LanguageCode, const FString &Category, FString &FilePath);
@@ -0,0 +1,39 @@
+// Copyright 2017-2021 Brace Yourself Games. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FBYGPseudoLocalizationOptions
+{
+	// Length of the pseudo-localized text compared to the original, not counting markup or brackets
+	float ExpansionRatio = 1.5f;
+	// Swap letters for accented versions of themselves
+	bool bAccents = false;
+	// Surround the text with [ ]
+	bool bBrackets = true;
+};
+
+// Generates the text for the Debug localization. Text is lengthened by repeating vowels, so text that won't fit once
+// translated stands out, and markup is copied as-is so it still works:
+// - <tags> up to the closing >
+// - {args} up to the closing }
+// - |argument modifiers, e.g. |plural(one=is,other=are)
+// Each string is written in one pass into a buffer sized up front. Thread-safe.
+class BYGLOCALIZATION_API FBYGPseudoLocalizer
+{
+public:
+	FBYGPseudoLocalizer();
+	explicit FBYGPseudoLocalizer( const FBYGPseudoLocalizationOptions& InOptions );
+
+	// Uses the options from UBYGLocalizationSettings
+	static FBYGPseudoLocalizationOptions GetOptionsFromSettings();
+
+	void Localize( FStringView Source, FString& Out ) const;
+	FString Localize( FStringView Source ) const;
+
+	const FBYGPseudoLocalizationOptions& GetOptions() const { return Options; }
+
+protected:
+	FBYGPseudoLocalizationOptions Options;
+};
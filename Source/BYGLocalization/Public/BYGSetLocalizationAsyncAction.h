@@ -0,0 +1,33 @@
+// Copyright 2017-2021 Brace Yourself Games. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintAsyncActionBase.h"
+#include "BYGSetLocalizationAsyncAction.generated.h"
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE( FBYGSetLocalizationAsyncPin );
+
+UCLASS()
+class BYGLOCALIZATION_API UBYGSetLocalizationAsyncAction : public UBlueprintAsyncActionBase
+{
+	GENERATED_BODY()
+public:
+	// Same as SetLocalizationByCode, but the new localization is loaded in the background so changing language doesn't
+	// cause a hitch. Text keeps showing the old language until Completed fires
+	UFUNCTION( BlueprintCallable, Category = "BYG|Localization", meta = ( BlueprintInternalUseOnly = "true", WorldContext = "WorldContextObject" ) )
+	static UBYGSetLocalizationAsyncAction* SetLocalizationByCodeAsync( UObject* WorldContextObject, const FString& Code );
+
+	// The new language is in use and OnLocalizationChanged has been broadcast
+	UPROPERTY( BlueprintAssignable )
+	FBYGSetLocalizationAsyncPin Completed;
+
+	// The language isn't in use, or another one was set before this one finished loading
+	UPROPERTY( BlueprintAssignable )
+	FBYGSetLocalizationAsyncPin Failed;
+
+	virtual void Activate() override;
+
+protected:
+	FString Code;
+};
@@ -0,0 +1,32 @@
+// Copyright 2017-2021 Brace Yourself Games. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BYGLocalization.h"
+
+// Counts the rows of a localization file by their Status column, for the stats window. Only the Status cell of each
+// row is copied out of the file, and it's matched against the status prefixes as UTF-8 without building strings.
+// Results are cached by file size and modification time, so refreshing unchanged files doesn't read them again.
+class BYGLOCALIZATION_API FBYGStatusScanner
+{
+public:
+	FBYGStatusScanner();
+
+	bool GetStats( const FString& Filename, BYGLocStats& OutCounts ) const;
+
+	EBYGLocEntryStatus Classify( FUtf8StringView Status ) const;
+
+	// Files the plugin rewrites can keep their size and modification time, so this is called after updating
+	// translations and reloading
+	static void ClearCache();
+
+protected:
+	bool ScanFile( const FString& Filename, BYGLocStats& OutCounts ) const;
+
+	// Same order they're checked in GetLocalizationDataFromFile
+	TArray<UTF8CHAR> DeprecatedPrefix;
+	TArray<UTF8CHAR> ModifiedPrefix;
+	TArray<UTF8CHAR> NewPrefix;
+	uint64 SettingsHash = 0;
+};
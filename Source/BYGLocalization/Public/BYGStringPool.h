@@ -0,0 +1,38 @@
+// Copyright 2017-2021 Brace Yourself Games. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Stores each distinct string once and hands out an ID for it, so text repeated across many files is only held once
+// and two pooled strings are the same if their IDs are. Case-sensitive. Safe to search from any number of threads
+// as long as nothing is being added.
+class BYGLOCALIZATION_API FBYGStringPool
+{
+public:
+	// Empty strings are never pooled, and return INDEX_NONE
+	int32 Add( FString&& String );
+	int32 Add( FStringView String );
+
+	// INDEX_NONE if the string hasn't been added
+	int32 Find( FStringView String ) const;
+
+	const FString& Get( int32 Id ) const { return Strings[ Id ]; }
+
+	int32 Num() const { return Strings.Num(); }
+	SIZE_T GetAllocatedSize() const;
+
+	void Reset();
+
+protected:
+	int32 FindByHash( uint64 Hash, FStringView String ) const;
+	void Grow();
+
+	TArray<FString> Strings;
+	TArray<uint64> Hashes;
+
+	// Power of two sized, with an ID of INDEX_NONE for empty slots, see FBYGKeyIndex
+	TArray<uint64> SlotHashes;
+	TArray<int32> SlotIds;
+	uint32 SlotMask = 0;
+};
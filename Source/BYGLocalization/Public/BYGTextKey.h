@@ -0,0 +1,67 @@
+// Copyright 2017-2021 Brace Yourself Games. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BYGTextKey.generated.h"
+
+// A key in one of the localization string tables, for properties and widgets that show the same text over and over.
+// The text is looked up the first time it's needed and then kept until the string tables change, so after that
+// getting it again costs one integer compare.
+// The cached text is not thread-safe, only use it from the game thread.
+USTRUCT( BlueprintType, meta = ( HasNativeMake = "BYGLocalization.BYGLocalizationStatics.MakeTextKey" ) )
+struct BYGLOCALIZATION_API FBYGTextKey
+{
+	GENERATED_BODY()
+
+	FBYGTextKey() {}
+	explicit FBYGTextKey( const FString& InKey, const FString& InCategory = FString() );
+
+	// Empty to read from the same table as GetGameText
+	UPROPERTY( EditAnywhere, BlueprintReadOnly, Category = "BYG|Localization" )
+	FString Category;
+
+	UPROPERTY( EditAnywhere, BlueprintReadOnly, Category = "BYG|Localization" )
+	FString Key;
+
+	// Use this rather than writing Key or Category directly, so the cached text is thrown away
+	void Set( const FString& InKey, const FString& InCategory = FString() );
+	bool IsEmpty() const { return Key.IsEmpty(); }
+
+	const FText& GetText() const;
+	uint64 GetKeyHash() const;
+
+	// Forgets the cached text and hash
+	void Reset() const;
+
+	// Case-sensitive, the same as string table keys. Also used to decide if the property differs from its default, so
+	// an edit that only changes case still has to count as a change to be saved
+	bool operator==( const FBYGTextKey& Other ) const
+	{
+		return Key.Equals( Other.Key, ESearchCase::CaseSensitive ) && Category.Equals( Other.Category, ESearchCase::CaseSensitive );
+	}
+	bool operator!=( const FBYGTextKey& Other ) const { return !( *this == Other ); }
+
+protected:
+	mutable FText CachedText;
+	mutable uint64 KeyHash = 0;
+	// FBYGLocalizationModule::GetStringTableGeneration when CachedText was looked up
+	mutable uint32 CachedGeneration = 0;
+	mutable bool bHashed = false;
+	mutable bool bCached = false;
+
+#if WITH_EDITORONLY_DATA
+	// The details panel, undo and copy-paste write the properties directly
+	mutable FString CachedKey;
+	mutable FString CachedCategory;
+#endif
+};
+
+template<>
+struct TStructOpsTypeTraits<FBYGTextKey> : public TStructOpsTypeTraitsBase2<FBYGTextKey>
+{
+	enum
+	{
+		WithIdenticalViaEquality = true,
+	};
+};
@@ -0,0 +1,93 @@
+// Copyright 2017-2021 Brace Yourself Games. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BYGPseudoLocalizer.h"
+
+struct FBYGLocalizationEntry;
+struct FBYGLocaleData;
+struct FBYGUpdateLog;
+class FBYGStringPool;
+
+// Decides what one target file's rows look like when it's merged with its primary, see FBYGTranslationMerge
+class BYGLOCALIZATION_API FBYGMergePolicy
+{
+public:
+	// Needed if the primary or targets have been pooled, see FBYGTranslationMerge::PoolPrimary
+	explicit FBYGMergePolicy( const FBYGStringPool* InStringPool = nullptr ) : StringPool( InStringPool ) {}
+	virtual ~FBYGMergePolicy() {}
+
+	// Called for every primary row in order. OldEntry is null if the target doesn't have the key yet, otherwise it's
+	// only used for this row and its values can be moved into OutEntry with TakeEntry. Return true to have
+	// FinishEntry called for the row once every row has been merged
+	virtual bool MergeEntry( const FBYGLocalizationEntry& PrimaryEntry, FBYGLocalizationEntry* OldEntry, const FString& CultureName, FBYGLocalizationEntry& OutEntry ) const = 0;
+
+	// Called in parallel, for work that doesn't log or depend on other rows
+	virtual void FinishEntry( const FBYGLocalizationEntry& PrimaryEntry, FBYGLocalizationEntry& Entry ) const {}
+
+protected:
+	// Moves everything but the key, which the target still needs to be searched
+	static void TakeEntry( FBYGLocalizationEntry& OldEntry, FBYGLocalizationEntry& OutEntry );
+
+	// Moves or copies Entry's Primary text out, depending on whether it's pooled
+	void TakePrimary( FBYGLocalizationEntry& Entry, FString& OutPrimary ) const;
+	// Whether the target row was translated from the primary's current text. Only compares IDs if both are pooled
+	bool IsSamePrimary( const FBYGLocalizationEntry& OldEntry, const FBYGLocalizationEntry& PrimaryEntry ) const;
+	// Gives OutEntry the primary's text as its Primary, shared if it's pooled
+	static void SetPrimary( const FBYGLocalizationEntry& PrimaryEntry, FBYGLocalizationEntry& OutEntry );
+	static void SetComment( const FBYGLocalizationEntry& PrimaryEntry, FBYGLocalizationEntry& OutEntry );
+
+	const FBYGStringPool* StringPool = nullptr;
+};
+
+// Translations show the primary text until they're translated, and keep their translation when the primary changes
+class BYGLOCALIZATION_API FBYGTranslationMergePolicy : public FBYGMergePolicy
+{
+public:
+	using FBYGMergePolicy::FBYGMergePolicy;
+
+	virtual bool MergeEntry( const FBYGLocalizationEntry& PrimaryEntry, FBYGLocalizationEntry* OldEntry, const FString& CultureName, FBYGLocalizationEntry& OutEntry ) const override;
+};
+
+// The Debug localization, where every translation is the pseudo-localized primary
+class BYGLOCALIZATION_API FBYGPseudoLocalizationMergePolicy : public FBYGMergePolicy
+{
+public:
+	explicit FBYGPseudoLocalizationMergePolicy( const FBYGPseudoLocalizationOptions& Options, const FBYGStringPool* InStringPool = nullptr );
+
+	virtual bool MergeEntry( const FBYGLocalizationEntry& PrimaryEntry, FBYGLocalizationEntry* OldEntry, const FString& CultureName, FBYGLocalizationEntry& OutEntry ) const override;
+	virtual void FinishEntry( const FBYGLocalizationEntry& PrimaryEntry, FBYGLocalizationEntry& Entry ) const override;
+
+protected:
+	FBYGPseudoLocalizer PseudoLocalizer;
+};
+
+struct FBYGMergeTarget
+{
+	// The translation file as it was loaded. Its rows are moved out of as they're merged, so it's only good for
+	// freeing afterwards
+	FBYGLocaleData* Data = nullptr;
+	const FBYGMergePolicy* Policy = nullptr;
+	// Only used in log messages
+	FString CultureName;
+	// Log lines for this target go here if set, so they can be printed in the same order as before
+	FBYGUpdateLog* Log = nullptr;
+
+	// Rows to write out, in the primary's order followed by any keys the primary no longer has
+	TArray<FBYGLocalizationEntry> Entries;
+};
+
+// Merges any number of translations of the same primary in one pass over it, so each primary row is read once for
+// all of them rather than once per language
+struct BYGLOCALIZATION_API FBYGTranslationMerge
+{
+	static void Merge( const FBYGLocaleData& PrimaryData, TArrayView<FBYGMergeTarget> Targets );
+
+	// Every translation repeats the primary's text and comments. Pooling the primary moves its comments into the pool
+	// and adds its translations, then pooling each translation swaps any text the pool has for its ID. Merged rows then
+	// share the pooled text, and a changed primary is found by comparing IDs.
+	// Primaries have to be pooled before any translations, which only search the pool and can be pooled in parallel
+	static void PoolPrimary( FBYGLocaleData& PrimaryData, FBYGStringPool& StringPool );
+	static void PoolTarget( FBYGLocaleData& Data, const FBYGStringPool& StringPool );
+};
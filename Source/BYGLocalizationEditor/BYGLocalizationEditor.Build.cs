@@ -25,6 +25,7 @@ public class BYGLocalizationEditor : ModuleRules
 				"InputCore",
                 "EditorStyle",
 				"FunctionalTesting",
+				"PropertyEditor",
 
 				// UIStyle stuff
 				"Projects",
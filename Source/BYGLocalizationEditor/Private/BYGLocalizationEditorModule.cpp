@@ -8,6 +8,7 @@
 #include "Developer/Settings/Public/ISettingsContainer.h"
 
 #include "BYGLocalizationEditor/Private/StatsWindow/BYGLocalizationStatsWindow.h"
+#include "BYGLocalizationEditor/Private/Customizations/BYGTextKeyCustomization.h"
 #include "Framework/Docking/TabManager.h"
 #include "Editor/WorkspaceMenuStructure/Public/WorkspaceMenuStructureModule.h"
 #include "Editor/WorkspaceMenuStructure/Public/WorkspaceMenuStructure.h"
@@ -16,6 +17,7 @@
 #include "BYGLocalizationSettings.h"
 #include "BYGLocalizationUIStyle.h"
 #include "BYGLocalizationStatics.h"
+#include "BYGTextKey.h"
 
 #define LOCTEXT_NAMESPACE "BYGLocalizationEditorModule"
 
@@ -64,6 +66,9 @@ void FBYGLocalizationEditorModule::StartupModule()
 		.SetIcon( FSlateIcon( FBYGLocalizationUIStyle::GetStyleSetName(), "BYGLocalization.TabIcon" ) );
 
 
+	FPropertyEditorModule& PropertyModule = FModuleManager::LoadModuleChecked<FPropertyEditorModule>( "PropertyEditor" );
+	PropertyModule.RegisterCustomPropertyTypeLayout( FBYGTextKey::StaticStruct()->GetFName(), FOnGetPropertyTypeCustomizationInstance::CreateStatic( &FBYGTextKeyCustomization::MakeInstance ) );
+
 	FEditorDelegates::EndPIE.AddRaw(this, &FBYGLocalizationEditorModule::OnEndPIE);
 }
 
@@ -75,6 +80,12 @@ void FBYGLocalizationEditorModule::ShutdownModule()
 	{
 		SettingsModule->UnregisterSettings( "Project", "Plugins", "BYG Localizations" );
 	}
+
+	FPropertyEditorModule* PropertyModule = FModuleManager::GetModulePtr<FPropertyEditorModule>( "PropertyEditor" );
+	if ( PropertyModule != nullptr && UObjectInitialized() )
+	{
+		PropertyModule->UnregisterCustomPropertyTypeLayout( FBYGTextKey::StaticStruct()->GetFName() );
+	}
 }
 
 bool FBYGLocalizationEditorModule::HandleSettingsSaved()
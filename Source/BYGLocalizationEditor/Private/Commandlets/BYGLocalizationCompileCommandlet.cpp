@@ -0,0 +1,25 @@
+// Copyright 2017-2021 Brace Yourself Games. All Rights Reserved.
+
+#include "BYGLocalizationCompileCommandlet.h"
+
+#include "BYGLocalization.h"
+#include "BYGLocalizationModule.h"
+
+UBYGLocalizationCompileCommandlet::UBYGLocalizationCompileCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 UBYGLocalizationCompileCommandlet::Main( const FString& Params )
+{
+	TArray<FString> Tokens;
+	TArray<FString> Switches;
+	ParseCommandLine( *Params, Tokens, Switches );
+
+	const bool bForce = Switches.Contains( TEXT( "force" ) );
+
+	return FBYGLocalizationModule::Get().GetLocalization()->CompileLocalizations( bForce ) ? 0 : 1;
+}
@@ -0,0 +1,20 @@
+// Copyright 2017-2021 Brace Yourself Games. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "BYGLocalizationCompileCommandlet.generated.h"
+
+// Compiles every localization CSV into its binary .bygloc form, for use as a build step before packaging.
+// Usage: UnrealEditor-Cmd.exe Project.uproject -run=BYGLocalizationCompile [-force]
+UCLASS()
+class UBYGLocalizationCompileCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UBYGLocalizationCompileCommandlet();
+
+	virtual int32 Main( const FString& Params ) override;
+};
@@ -0,0 +1,208 @@
+// Copyright 2017-2021 Brace Yourself Games. All Rights Reserved.
+
+#include "BYGTextKeyCustomization.h"
+
+#include "DetailLayoutBuilder.h"
+#include "DetailWidgetRow.h"
+#include "PropertyHandle.h"
+#include "Widgets/Input/SEditableTextBox.h"
+#include "Widgets/Text/STextBlock.h"
+#include "Internationalization/StringTableCore.h"
+#include "Internationalization/StringTableRegistry.h"
+
+#include "BYGLocalizationSettings.h"
+#include "BYGLocalizationStatics.h"
+#include "BYGTextKey.h"
+
+#define LOCTEXT_NAMESPACE "BYGTextKeyCustomization"
+
+TSharedRef<IPropertyTypeCustomization> FBYGTextKeyCustomization::MakeInstance()
+{
+	return MakeShareable( new FBYGTextKeyCustomization() );
+}
+
+void FBYGTextKeyCustomization::CustomizeHeader( TSharedRef<IPropertyHandle> PropertyHandle, FDetailWidgetRow& HeaderRow, IPropertyTypeCustomizationUtils& CustomizationUtils )
+{
+	CategoryHandle = PropertyHandle->GetChildHandle( GET_MEMBER_NAME_CHECKED( FBYGTextKey, Category ) );
+	KeyHandle = PropertyHandle->GetChildHandle( GET_MEMBER_NAME_CHECKED( FBYGTextKey, Key ) );
+	check( CategoryHandle.IsValid() && KeyHandle.IsValid() );
+
+	RefreshCategoryOptions();
+	RefreshKeyOptions();
+
+	HeaderRow
+		.NameContent()
+		[
+			PropertyHandle->CreatePropertyNameWidget()
+		]
+		.ValueContent()
+		.MinDesiredWidth( 400.0f )
+		.MaxDesiredWidth( 800.0f )
+		[
+			SNew( SVerticalBox )
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			[
+				SNew( SHorizontalBox )
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				.Padding( 0.0f, 0.0f, 4.0f, 0.0f )
+				[
+					SNew( SComboBox<TSharedPtr<FString>> )
+					.OptionsSource( &CategoryOptions )
+					.OnGenerateWidget( this, &FBYGTextKeyCustomization::MakeOptionWidget )
+					.OnSelectionChanged( this, &FBYGTextKeyCustomization::OnCategorySelected )
+					.ToolTipText( LOCTEXT( "CategoryToolTip", "String table to read from. Default uses the same table as GetGameText." ) )
+					[
+						SNew( STextBlock )
+						.Text( this, &FBYGTextKeyCustomization::GetCategoryText )
+						.Font( IDetailLayoutBuilder::GetDetailFont() )
+					]
+				]
+				+ SHorizontalBox::Slot()
+				.FillWidth( 1.0f )
+				[
+					SNew( SEditableTextBox )
+					.Text( this, &FBYGTextKeyCustomization::GetKeyText )
+					.OnTextCommitted( this, &FBYGTextKeyCustomization::OnKeyCommitted )
+					.Font( IDetailLayoutBuilder::GetDetailFont() )
+				]
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				[
+					SAssignNew( KeyComboBox, SComboBox<TSharedPtr<FString>> )
+					.OptionsSource( &KeyOptions )
+					.OnGenerateWidget( this, &FBYGTextKeyCustomization::MakeOptionWidget )
+					.OnSelectionChanged( this, &FBYGTextKeyCustomization::OnKeySelected )
+					.OnComboBoxOpening( this, &FBYGTextKeyCustomization::OnKeyComboOpening )
+					.ToolTipText( LOCTEXT( "KeyToolTip", "Pick a key from the loaded string table" ) )
+				]
+			]
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			[
+				SNew( STextBlock )
+				.Text( this, &FBYGTextKeyCustomization::GetPreviewText )
+				.Font( IDetailLayoutBuilder::GetDetailFontItalic() )
+			]
+		];
+}
+
+void FBYGTextKeyCustomization::RefreshCategoryOptions()
+{
+	TArray<FString> Categories;
+	UBYGLocalizationStatics::GetLocalizationCategories( Categories );
+
+	CategoryOptions.Reset();
+	CategoryOptions.Add( MakeShared<FString>() );
+	for ( const FString& Category : Categories )
+	{
+		CategoryOptions.Add( MakeShared<FString>( Category ) );
+	}
+}
+
+void FBYGTextKeyCustomization::RefreshKeyOptions()
+{
+	KeyOptions.Reset();
+
+	FString Category;
+	if ( CategoryHandle->GetValue( Category ) != FPropertyAccess::Success )
+		return;
+
+	const FString TableName = Category.IsEmpty() ? UBYGLocalizationSettings::Get()->StringtableID : Category;
+	FStringTableConstPtr StringTable = FStringTableRegistry::Get().FindStringTable( *TableName );
+	if ( !StringTable.IsValid() )
+		return;
+
+	StringTable->EnumerateSourceStrings( [ this ]( const FString& Key, const FString& SourceString )
+	{
+		KeyOptions.Add( MakeShared<FString>( Key ) );
+		return true;
+	} );
+	KeyOptions.Sort( []( const TSharedPtr<FString>& A, const TSharedPtr<FString>& B ) { return *A < *B; } );
+}
+
+FText FBYGTextKeyCustomization::GetCategoryText() const
+{
+	FString Category;
+	switch ( CategoryHandle->GetValue( Category ) )
+	{
+	case FPropertyAccess::MultipleValues:
+		return LOCTEXT( "MultipleValues", "Multiple Values" );
+	case FPropertyAccess::Success:
+		return Category.IsEmpty() ? LOCTEXT( "DefaultCategory", "Default" ) : FText::FromString( Category );
+	default:
+		return FText::GetEmpty();
+	}
+}
+
+FText FBYGTextKeyCustomization::GetKeyText() const
+{
+	FString Key;
+	switch ( KeyHandle->GetValue( Key ) )
+	{
+	case FPropertyAccess::MultipleValues:
+		return LOCTEXT( "MultipleValues", "Multiple Values" );
+	case FPropertyAccess::Success:
+		return FText::FromString( Key );
+	default:
+		return FText::GetEmpty();
+	}
+}
+
+FText FBYGTextKeyCustomization::GetPreviewText() const
+{
+	FString Category;
+	FString Key;
+	if ( CategoryHandle->GetValue( Category ) != FPropertyAccess::Success || KeyHandle->GetValue( Key ) != FPropertyAccess::Success || Key.IsEmpty() )
+		return FText::GetEmpty();
+
+	// Checked first so that typing a key in doesn't log an error for every character
+	const FString TableName = Category.IsEmpty() ? UBYGLocalizationSettings::Get()->StringtableID : Category;
+	if ( !UBYGLocalizationStatics::HasTextInTable( TableName, Key ) )
+		return LOCTEXT( "KeyNotFound", "Key not found" );
+
+	return FBYGTextKey( Key, Category ).GetText();
+}
+
+void FBYGTextKeyCustomization::OnCategorySelected( TSharedPtr<FString> Selected, ESelectInfo::Type SelectInfo )
+{
+	if ( Selected.IsValid() )
+	{
+		CategoryHandle->SetValue( *Selected );
+		RefreshKeyOptions();
+		if ( KeyComboBox.IsValid() )
+		{
+			KeyComboBox->RefreshOptions();
+		}
+	}
+}
+
+void FBYGTextKeyCustomization::OnKeySelected( TSharedPtr<FString> Selected, ESelectInfo::Type SelectInfo )
+{
+	if ( Selected.IsValid() && SelectInfo != ESelectInfo::Direct )
+	{
+		KeyHandle->SetValue( *Selected );
+	}
+}
+
+void FBYGTextKeyCustomization::OnKeyCommitted( const FText& NewText, ETextCommit::Type CommitType )
+{
+	KeyHandle->SetValue( NewText.ToString().TrimStartAndEnd() );
+}
+
+void FBYGTextKeyCustomization::OnKeyComboOpening()
+{
+	// Tables may have been reloaded since the panel was opened
+	RefreshKeyOptions();
+	KeyComboBox->RefreshOptions();
+}
+
+TSharedRef<SWidget> FBYGTextKeyCustomization::MakeOptionWidget( TSharedPtr<FString> Option ) const
+{
+	return SNew( STextBlock )
+		.Text( Option->IsEmpty() ? LOCTEXT( "DefaultCategory", "Default" ) : FText::FromString( *Option ) )
+		.Font( IDetailLayoutBuilder::GetDetailFont() );
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,42 @@
+// Copyright 2017-2021 Brace Yourself Games. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "IPropertyTypeCustomization.h"
+#include "Widgets/Input/SComboBox.h"
+
+class IPropertyHandle;
+
+// Shows FBYGTextKey properties as a category and a key picked from the loaded string tables
+class FBYGTextKeyCustomization : public IPropertyTypeCustomization
+{
+public:
+	static TSharedRef<IPropertyTypeCustomization> MakeInstance();
+
+	virtual void CustomizeHeader( TSharedRef<IPropertyHandle> PropertyHandle, FDetailWidgetRow& HeaderRow, IPropertyTypeCustomizationUtils& CustomizationUtils ) override;
+	virtual void CustomizeChildren( TSharedRef<IPropertyHandle> PropertyHandle, IDetailChildrenBuilder& ChildBuilder, IPropertyTypeCustomizationUtils& CustomizationUtils ) override {}
+
+protected:
+	void RefreshCategoryOptions();
+	void RefreshKeyOptions();
+
+	FText GetCategoryText() const;
+	FText GetKeyText() const;
+	FText GetPreviewText() const;
+
+	void OnCategorySelected( TSharedPtr<FString> Selected, ESelectInfo::Type SelectInfo );
+	void OnKeySelected( TSharedPtr<FString> Selected, ESelectInfo::Type SelectInfo );
+	void OnKeyCommitted( const FText& NewText, ETextCommit::Type CommitType );
+	void OnKeyComboOpening();
+
+	TSharedRef<SWidget> MakeOptionWidget( TSharedPtr<FString> Option ) const;
+
+	TSharedPtr<IPropertyHandle> CategoryHandle;
+	TSharedPtr<IPropertyHandle> KeyHandle;
+
+	// The first entry is an empty string, meaning the default table
+	TArray<TSharedPtr<FString>> CategoryOptions;
+	TArray<TSharedPtr<FString>> KeyOptions;
+	TSharedPtr<SComboBox<TSharedPtr<FString>>> KeyComboBox;
+};
@@ -236,7 +236,20 @@ TSharedPtr<SWidget> SBYGLocalizationStatsWindow::GetListContextMenu()
 
 void SBYGLocalizationStatsWindow::CleanupThreads()
 {
-	ParseFileRunnable.Reset();
+	if ( RefreshTask.IsValid() )
+	{
+		RefreshTask->Cancel();
+		RefreshTask.Reset();
+	}
+	if ( RefreshTimer.IsValid() )
+	{
+		UnRegisterActiveTimer( RefreshTimer.ToSharedRef() );
+		RefreshTimer.Reset();
+	}
+	if ( StatusThrobber.IsValid() )
+	{
+		StatusThrobber->SetVisibility( EVisibility::Hidden );
+	}
 }
 
 FReply SBYGLocalizationStatsWindow::RefreshAll()
@@ -247,6 +260,7 @@ FReply SBYGLocalizationStatsWindow::RefreshAll()
 
 	// Load the data I guess?
 	Items.Empty();
+	ItemsByPath.Empty();
 
 	TArray<FBYGLocaleInfo> Entries = FBYGLocalizationModule::Get().GetLocalization()->GetAvailableLocalizations();
 
@@ -264,41 +278,79 @@ FReply SBYGLocalizationStatsWindow::RefreshAll()
 		NewItem->Path = FPaths::Combine( FPaths::ProjectContentDir(), Entry.FilePath );
 		NewItem->bIsRefreshing = true;
 		Items.Add( NewItem );
+		ItemsByPath.Add( FullPath, NewItem );
 	}
 
-	ParseFileRunnable = MakeShareable( new FBYGParseFileRunnable( Paths ) );
-	if ( ParseFileRunnable )
+	if ( StatsList.IsValid() )
 	{
-		ParseFileRunnable->OnGetStatsCompleteSignature.BindRaw( this, &SBYGLocalizationStatsWindow::OnFileParseComplete );
+		StatsList->RequestListRefresh();
 	}
 
+	RefreshTask = MakeUnique<FBYGStatsRefreshTask>( Paths );
+	RefreshTimer = RegisterActiveTimer( 0.1f, FWidgetActiveTimerDelegate::CreateSP( this, &SBYGLocalizationStatsWindow::PollRefresh ) );
+	StatusThrobber->SetVisibility( EVisibility::Visible );
+
 	return FReply::Handled();
 }
 
-void SBYGLocalizationStatsWindow::OnFileParseComplete( const FString& Path, const BYGLocStats& LocStats )
+EActiveTimerReturnType SBYGLocalizationStatsWindow::PollRefresh( double InCurrentTime, float InDeltaTime )
 {
-	// Find the data for this one
-	for ( TSharedPtr<FBYGLocalizationStatEntry> Entry : Items )
+	if ( !RefreshTask.IsValid() )
 	{
-		if ( !Entry.IsValid() )
-			continue;
+		RefreshTimer.Reset();
+		return EActiveTimerReturnType::Stop;
+	}
+
+	// Check before draining so nothing finished in between is missed
+	const bool bComplete = RefreshTask->IsComplete();
 
-		if ( Entry->Path == Path )
+	TArray<FBYGStatsRefreshTask::FResult> Results;
+	RefreshTask->DrainResults( Results );
+	for ( const FBYGStatsRefreshTask::FResult& Result : Results )
+	{
+		if ( Result.bSucceeded )
+		{
+			OnFileParseComplete( Result.Path, Result.Stats );
+		}
+		else if ( TSharedPtr<FBYGLocalizationStatEntry>* Entry = ItemsByPath.Find( Result.Path ) )
 		{
-			Entry->bIsRefreshing = false;
-			Entry->NormalEntries = LocStats[ EBYGLocEntryStatus::None ];
-			Entry->NewEntries = LocStats[ EBYGLocEntryStatus::New ];
-			Entry->ModifiedEntries = LocStats[ EBYGLocEntryStatus::Modified ];
-			Entry->DeprecatedEntries = LocStats[ EBYGLocEntryStatus::Deprecated ];
-			Entry->TotalEntries = LocStats[ EBYGLocEntryStatus::None ] + LocStats[ EBYGLocEntryStatus::New ] + LocStats[ EBYGLocEntryStatus::Modified ];
-			break;
+			( *Entry )->bIsRefreshing = false;
+			( *Entry )->Status = LOCTEXT( "FailedToRead", "Failed to read file" );
 		}
 	}
+
+	if ( !bComplete )
+		return EActiveTimerReturnType::Continue;
+
+	RefreshTask.Reset();
+	RefreshTimer.Reset();
+	StatusThrobber->SetVisibility( EVisibility::Hidden );
+	return EActiveTimerReturnType::Stop;
+}
+
+void SBYGLocalizationStatsWindow::OnFileParseComplete( const FString& Path, const BYGLocStats& LocStats )
+{
+	// Find the data for this one
+	TSharedPtr<FBYGLocalizationStatEntry> Entry = ItemsByPath.FindRef( Path );
+	if ( Entry.IsValid() )
+	{
+		Entry->bIsRefreshing = false;
+		Entry->NormalEntries = LocStats[ EBYGLocEntryStatus::None ];
+		Entry->NewEntries = LocStats[ EBYGLocEntryStatus::New ];
+		Entry->ModifiedEntries = LocStats[ EBYGLocEntryStatus::Modified ];
+		Entry->DeprecatedEntries = LocStats[ EBYGLocEntryStatus::Deprecated ];
+		Entry->TotalEntries = LocStats[ EBYGLocEntryStatus::None ] + LocStats[ EBYGLocEntryStatus::New ] + LocStats[ EBYGLocEntryStatus::Modified ];
+	}
 }
 
 
 FReply SBYGLocalizationStatsWindow::CancelAll()
 {
+	CleanupThreads();
+	for ( const TSharedPtr<FBYGLocalizationStatEntry>& Entry : Items )
+	{
+		Entry->bIsRefreshing = false;
+	}
 	return FReply::Handled();
 }
 
@@ -12,7 +12,7 @@
 #include "Widgets/Views/STableRow.h"
 #include "Widgets/Images/SThrobber.h"
 #include "BYGLocalization/Public/BYGLocalization.h"
-#include "BYGLocalization/Private/BYGParseFileRunnable.h"
+#include "BYGLocalization/Private/BYGStatsRefreshTask.h"
 
 #define LOCTEXT_NAMESPACE "BYGLocalization"
 
@@ -48,8 +48,11 @@ public:
 
 	void Construct( const FArguments& InArgs );
 
-	void OnFileParseComplete( const FString& Path, const BYGLocStats& LocStats );
 protected:
+	void OnFileParseComplete( const FString& Path, const BYGLocStats& LocStats );
+	// Applies finished stats on the game thread while a refresh is running
+	EActiveTimerReturnType PollRefresh( double InCurrentTime, float InDeltaTime );
+
 	TSharedRef<ITableRow> OnGenerateWidgetForList( TSharedPtr<FBYGLocalizationStatEntry> InItem, const TSharedRef<STableViewBase>& OwnerTable );
 	TSharedPtr<SWidget> GetListContextMenu();
 
@@ -68,8 +71,9 @@ protected:
 	FReply RefreshAll();
 	FReply CancelAll();
 	void CleanupThreads();
-	// Could be TUniquePtr?
-	TSharedPtr<FBYGParseFileRunnable> ParseFileRunnable;
+	TUniquePtr<FBYGStatsRefreshTask> RefreshTask;
+	TSharedPtr<FActiveTimerHandle> RefreshTimer;
+	TMap<FString, TSharedPtr<FBYGLocalizationStatEntry>> ItemsByPath;
 
 	TSharedPtr<SCircularThrobber> StatusThrobber;
 };
@@ -0,0 +1,1140 @@
+// Copyright 2017-2021 Brace Yourself Games. All Rights Reserved.
+
+#include "Runtime/Launch/Resources/Version.h"
+// Unit testing did not exist before 4.22
+#if ENGINE_MAJOR_VERSION > 4 || ENGINE_MINOR_VERSION > 22
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#include "BYGLocalization/Public/BYGLocalization.h"
+#include "BYGLocalization/Public/BYGLocalizationBlob.h"
+#include "BYGLocalization/Public/BYGLocalizationModule.h"
+#include "BYGLocalization/Public/BYGLocalizationSettings.h"
+#include "BYGLocalization/Public/BYGLocalizationStatics.h"
+#include "BYGLocalization/Public/BYGCsvReader.h"
+#include "BYGLocalization/Public/BYGCsvWriter.h"
+#include "BYGLocalization/Public/BYGKeyIndex.h"
+#include "BYGLocalization/Public/BYGPseudoLocalizer.h"
+#include "BYGLocalization/Public/BYGStringPool.h"
+#include "BYGLocalization/Public/BYGTranslationMerge.h"
+
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Developer/FunctionalTesting/Classes/FunctionalTestBase.h"
+#include "HAL/FileManager.h"
+#include "HAL/MemoryBase.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformTime.h"
+#include "Internationalization/StringTableCore.h"
+#include "Internationalization/StringTableRegistry.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+// Benchmarks are only run on request, they are too slow to be part of the normal test pass
+static const int BenchmarkFlags = (
+	EAutomationTestFlags::EditorContext
+	| EAutomationTestFlags::CommandletContext
+	| EAutomationTestFlags::PerfFilter );
+
+namespace BYGLocalizationBenchmark
+{
+	// Roughly the shape of a real dialogue file: short keys, a sentence or two of text, a comment
+	FString MakeCSV( int32 NumRows )
+	{
+		FString CSV = TEXT( "Key,SourceString,Comment,Primary,Status\r\n" );
+		CSV.Reserve( NumRows * 160 );
+		for ( int32 i = 0; i < NumRows; ++i )
+		{
+			CSV += FString::Printf( TEXT( "Dialogue_Line_%d,\"Line %d, said with feeling. \"\"Quoted\"\" part.\",Comment for line %d,\"Line %d, said with feeling.\",\r\n" ), i, i, i, i );
+		}
+		return CSV;
+	}
+
+	// One language's file for a category, already up to date with the primary. Prefix is added to every translation
+	FString MakeTranslationCSV( int32 NumRows, const FString& Prefix )
+	{
+		FString CSV = TEXT( "Key,SourceString,Comment,Primary,Status\r\n" );
+		CSV.Reserve( NumRows * 160 );
+		for ( int32 i = 0; i < NumRows; ++i )
+		{
+			CSV += FString::Printf( TEXT( "Dialogue_Line_%d,\"%sLine %d, said with feeling.\",Comment for line %d,\"Line %d, said with feeling.\",\r\n" ), i, *Prefix, i, i, i );
+		}
+		return CSV;
+	}
+
+	FString MakeTempFilename( const TCHAR* Extension )
+	{
+		return FPaths::CreateTempFilename( FPlatformProcess::UserTempDir(), TEXT( "BYGLocalizationBenchmark" ), Extension );
+	}
+
+	// Built in batches so the whole corpus never exists as TCHAR
+	TArray<UTF8CHAR> MakeUTF8CSV( int32 NumRows )
+	{
+		const int32 BatchSize = 10000;
+		TArray<UTF8CHAR> UTF8;
+		UTF8.Reserve( (int64)NumRows * 110 );
+		for ( int32 Row = 0; Row < NumRows; Row += BatchSize )
+		{
+			const FString Batch = MakeCSV( FMath::Min( BatchSize, NumRows - Row ) );
+			const FTCHARToUTF8 Converted( *Batch, Batch.Len() );
+			UTF8.Append( (const UTF8CHAR*)Converted.Get(), Converted.Length() );
+		}
+		return UTF8;
+	}
+}
+
+IMPLEMENT_CUSTOM_SIMPLE_AUTOMATION_TEST( FBYGCompiledLoadBenchmark, FFunctionalTestBase, "BYG.Localization.Benchmark.CompiledLoad", BenchmarkFlags )
+bool FBYGCompiledLoadBenchmark::RunTest( const FString& Parameters )
+{
+	const int32 NumRows = 40000;
+	const int32 NumIterations = 5;
+
+	const FString SourceFilename = BYGLocalizationBenchmark::MakeTempFilename( TEXT( ".csv" ) );
+	const FString BlobFilename = FBYGLocalizationBlob::GetBlobFilename( SourceFilename );
+
+	TestTrue( "write source file", FFileHelper::SaveStringToFile( BYGLocalizationBenchmark::MakeCSV( NumRows ), *SourceFilename, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM ) );
+
+	double StartTime = FPlatformTime::Seconds();
+	TestTrue( "compile", FBYGLocalizationBlob::Compile( SourceFilename, BlobFilename ) );
+	const double CompileTime = FPlatformTime::Seconds() - StartTime;
+
+	// The first iteration is the closest we can get to a cold start without flushing the OS file cache
+	double CSVFirstTime = 0.0;
+	double CSVTotalTime = 0.0;
+	double BlobFirstTime = 0.0;
+	double BlobTotalTime = 0.0;
+	int32 CSVCount = 0;
+	int32 BlobCount = 0;
+
+	for ( int32 Iteration = 0; Iteration < NumIterations; ++Iteration )
+	{
+		StartTime = FPlatformTime::Seconds();
+		{
+			FStringTableRef StringTable = FStringTable::NewStringTable();
+			StringTable->SetNamespace( TEXT( "Benchmark" ) );
+			StringTable->ImportStrings( SourceFilename );
+			CSVCount = 0;
+			StringTable->EnumerateSourceStrings( [&CSVCount]( const FString&, const FString& ) { ++CSVCount; return true; } );
+		}
+		const double CSVTime = FPlatformTime::Seconds() - StartTime;
+
+		StartTime = FPlatformTime::Seconds();
+		{
+			FBYGLocalizationBlob Blob;
+			TestTrue( "load blob", Blob.LoadFromFile( BlobFilename, SourceFilename ) );
+			FStringTableRef StringTable = Blob.CreateStringTable( TEXT( "Benchmark" ) );
+			BlobCount = 0;
+			StringTable->EnumerateSourceStrings( [&BlobCount]( const FString&, const FString& ) { ++BlobCount; return true; } );
+		}
+		const double BlobTime = FPlatformTime::Seconds() - StartTime;
+
+		if ( Iteration == 0 )
+		{
+			CSVFirstTime = CSVTime;
+			BlobFirstTime = BlobTime;
+		}
+		CSVTotalTime += CSVTime;
+		BlobTotalTime += BlobTime;
+	}
+
+	TestEqual( "same number of entries", BlobCount, CSVCount );
+
+	AddInfo( FString::Printf( TEXT( "%d rows, compile %.2fms" ), NumRows, CompileTime * 1000.0 ) );
+	AddInfo( FString::Printf( TEXT( "CSV:  first %.2fms, average %.2fms" ), CSVFirstTime * 1000.0, CSVTotalTime * 1000.0 / NumIterations ) );
+	AddInfo( FString::Printf( TEXT( "Blob: first %.2fms, average %.2fms" ), BlobFirstTime * 1000.0, BlobTotalTime * 1000.0 / NumIterations ) );
+
+	IFileManager::Get().Delete( *SourceFilename );
+	IFileManager::Get().Delete( *BlobFilename );
+
+	return true;
+}
+
+IMPLEMENT_CUSTOM_SIMPLE_AUTOMATION_TEST( FBYGCsvScanBenchmark, FFunctionalTestBase, "BYG.Localization.Benchmark.CsvScan", BenchmarkFlags )
+bool FBYGCsvScanBenchmark::RunTest( const FString& Parameters )
+{
+	const int32 NumIterations = 3;
+
+	// Every localization file in the project, plus a large generated one
+	TArray<TPair<FString, TArray<UTF8CHAR>>> Corpora;
+	{
+		TArray<UTF8CHAR>& ProjectFiles = Corpora.Emplace_GetRef( TEXT( "Project loc files" ), TArray<UTF8CHAR>() ).Value;
+		for ( const FBYGLocaleInfo& Info : FBYGLocalizationModule::Get().GetLocalization()->GetAvailableLocalizations() )
+		{
+			TArray<uint8> Bytes;
+			if ( FFileHelper::LoadFileToArray( Bytes, *FPaths::Combine( FPaths::ProjectContentDir(), Info.FilePath ) ) )
+			{
+				ProjectFiles.Append( (const UTF8CHAR*)Bytes.GetData(), Bytes.Num() );
+			}
+		}
+		Corpora.Emplace( TEXT( "Generated 1M rows" ), BYGLocalizationBenchmark::MakeUTF8CSV( 1000000 ) );
+	}
+
+	for ( const TPair<FString, TArray<UTF8CHAR>>& Corpus : Corpora )
+	{
+		if ( Corpus.Value.Num() == 0 )
+		{
+			AddInfo( FString::Printf( TEXT( "%s: no data" ), *Corpus.Key ) );
+			continue;
+		}
+
+		const double MegaBytes = Corpus.Value.Num() / ( 1024.0 * 1024.0 );
+		int32 NumRows[ 2 ] = { 0, 0 };
+		double BestTime[ 2 ] = { DBL_MAX, DBL_MAX };
+
+		for ( int32 bVector = 0; bVector < 2; ++bVector )
+		{
+			if ( bVector && !FBYGCsvReader::HasVectorScan() )
+				continue;
+
+			for ( int32 Iteration = 0; Iteration < NumIterations; ++Iteration )
+			{
+				FBYGCsvReader Reader;
+				Reader.SetUseVectorScan( bVector != 0 );
+				int32 Rows = 0;
+				auto Callback = [&Rows]( const FBYGCsvRow& Row ) { ++Rows; return true; };
+
+				// Same chunking as reading from disk, without the disk
+				const double StartTime = FPlatformTime::Seconds();
+				for ( int64 Offset = 0; Offset < Corpus.Value.Num(); Offset += FBYGCsvReader::ChunkSize )
+				{
+					Reader.Parse( Corpus.Value.GetData() + Offset, FMath::Min<int64>( FBYGCsvReader::ChunkSize, Corpus.Value.Num() - Offset ), Callback );
+				}
+				Reader.Finish( Callback );
+				BestTime[ bVector ] = FMath::Min( BestTime[ bVector ], FPlatformTime::Seconds() - StartTime );
+				NumRows[ bVector ] = Rows;
+			}
+		}
+
+		AddInfo( FString::Printf( TEXT( "%s: %.1fMB, %d rows" ), *Corpus.Key, MegaBytes, NumRows[ 0 ] ) );
+		AddInfo( FString::Printf( TEXT( "  Scalar: %.1fMB/s" ), MegaBytes / BestTime[ 0 ] ) );
+		if ( FBYGCsvReader::HasVectorScan() )
+		{
+			AddInfo( FString::Printf( TEXT( "  %s: %.1fMB/s" ), FBYGCsvReader::GetVectorScanName(), MegaBytes / BestTime[ 1 ] ) );
+			TestEqual( Corpus.Key + " same rows with vector scan", NumRows[ 1 ], NumRows[ 0 ] );
+		}
+	}
+
+	return true;
+}
+
+IMPLEMENT_CUSTOM_SIMPLE_AUTOMATION_TEST( FBYGKeyIndexBenchmark, FFunctionalTestBase, "BYG.Localization.Benchmark.KeyIndex", BenchmarkFlags )
+bool FBYGKeyIndexBenchmark::RunTest( const FString& Parameters )
+{
+	const int32 NumKeys = 100000;
+	const int32 NumIterations = 5;
+
+	// The translation is missing every tenth key and has a few of its own, like a real file that's a bit behind
+	TArray<FBYGLocalizationEntry> PrimaryEntries;
+	TArray<FBYGLocalizationEntry> LocalEntries;
+	PrimaryEntries.Reserve( NumKeys );
+	LocalEntries.Reserve( NumKeys );
+	for ( int32 i = 0; i < NumKeys; ++i )
+	{
+		PrimaryEntries.Emplace( FString::Printf( TEXT( "Dialogue_Line_%d" ), i ), TEXT( "Text" ), FString() );
+		LocalEntries.Emplace( FString::Printf( i % 10 == 0 ? TEXT( "Old_Line_%d" ) : TEXT( "Dialogue_Line_%d" ), i ), TEXT( "Text" ), FString() );
+	}
+
+	double MapBestTime = DBL_MAX;
+	double IndexBestTime = DBL_MAX;
+	int32 MapFound = 0;
+	int32 IndexFound = 0;
+
+	for ( int32 Iteration = 0; Iteration < NumIterations; ++Iteration )
+	{
+		// What UpdateTranslationFile used to do: build both maps, then look up every primary key in the translation
+		// and every translated key in the primary
+		double StartTime = FPlatformTime::Seconds();
+		{
+			TMap<FString, int32> PrimaryKeyToIndex;
+			TMap<FString, int32> LocalKeyToIndex;
+			for ( int32 i = 0; i < NumKeys; ++i )
+			{
+				if ( !PrimaryKeyToIndex.Contains( PrimaryEntries[ i ].Key ) )
+				{
+					PrimaryKeyToIndex.Add( PrimaryEntries[ i ].Key, i );
+				}
+				if ( !LocalKeyToIndex.Contains( LocalEntries[ i ].Key ) )
+				{
+					LocalKeyToIndex.Add( LocalEntries[ i ].Key, i );
+				}
+			}
+
+			MapFound = 0;
+			for ( const FBYGLocalizationEntry& Entry : PrimaryEntries )
+			{
+				if ( LocalKeyToIndex.Contains( Entry.Key )
+					&& LocalKeyToIndex[ Entry.Key ] >= 0
+					&& LocalKeyToIndex[ Entry.Key ] < LocalEntries.Num() )
+				{
+					MapFound += LocalEntries[ LocalKeyToIndex[ Entry.Key ] ].Translation.Len() > 0 ? 1 : 0;
+				}
+			}
+			for ( const FBYGLocalizationEntry& Entry : LocalEntries )
+			{
+				MapFound += PrimaryKeyToIndex.Contains( Entry.Key ) ? 0 : 1;
+			}
+		}
+		MapBestTime = FMath::Min( MapBestTime, FPlatformTime::Seconds() - StartTime );
+
+		StartTime = FPlatformTime::Seconds();
+		{
+			FBYGKeyIndex PrimaryIndex;
+			FBYGKeyIndex LocalIndex;
+			PrimaryIndex.Build( PrimaryEntries );
+			LocalIndex.Build( LocalEntries );
+
+			IndexFound = 0;
+			for ( int32 i = 0; i < PrimaryEntries.Num(); ++i )
+			{
+				if ( const TOptional<int32> Found = LocalIndex.FindByHash( PrimaryIndex.GetKeyHash( i ), PrimaryEntries[ i ].Key, LocalEntries ) )
+				{
+					IndexFound += LocalEntries[ *Found ].Translation.Len() > 0 ? 1 : 0;
+				}
+			}
+			for ( int32 i = 0; i < LocalEntries.Num(); ++i )
+			{
+				IndexFound += PrimaryIndex.FindByHash( LocalIndex.GetKeyHash( i ), LocalEntries[ i ].Key, PrimaryEntries ) ? 0 : 1;
+			}
+		}
+		IndexBestTime = FMath::Min( IndexBestTime, FPlatformTime::Seconds() - StartTime );
+	}
+
+	TestEqual( "same keys found", IndexFound, MapFound );
+
+	AddInfo( FString::Printf( TEXT( "%d keys, build and look up both ways" ), NumKeys ) );
+	AddInfo( FString::Printf( TEXT( "TMap:     %.2fms" ), MapBestTime * 1000.0 ) );
+	AddInfo( FString::Printf( TEXT( "KeyIndex: %.2fms" ), IndexBestTime * 1000.0 ) );
+
+	return true;
+}
+
+IMPLEMENT_CUSTOM_SIMPLE_AUTOMATION_TEST( FBYGGameTextBenchmark, FFunctionalTestBase, "BYG.Localization.Benchmark.GameText", BenchmarkFlags )
+bool FBYGGameTextBenchmark::RunTest( const FString& Parameters )
+{
+	const int32 NumKeys = 10000;
+	const int32 NumIterations = 20;
+
+	// GetGameText always reads from the active table, so swap a generated one in for the length of the benchmark
+	const FName TableID( *UBYGLocalizationSettings::Get()->StringtableID );
+	const FStringTableConstPtr PreviousTable = FStringTableRegistry::Get().FindStringTable( TableID );
+
+	FStringTableRef StringTable = FStringTable::NewStringTable();
+	StringTable->SetNamespace( TableID.ToString() );
+	TArray<FString> Keys;
+	Keys.Reserve( NumKeys );
+	for ( int32 i = 0; i < NumKeys; ++i )
+	{
+		Keys.Add( FString::Printf( TEXT( "Dialogue_Line_%d" ), i ) );
+		StringTable->SetSourceString( Keys.Last(), FString::Printf( TEXT( "Line %d, said with feeling." ), i ) );
+	}
+	FStringTableRegistry::Get().UnregisterStringTable( TableID );
+	FStringTableRegistry::Get().RegisterStringTable( TableID, StringTable );
+	FBYGLocalizationModule::NotifyStringTablesChanged();
+
+	// What GetGameText used to do on every call
+	double LegacyBestTime = DBL_MAX;
+	int32 LegacyFound = 0;
+	for ( int32 Iteration = 0; Iteration < NumIterations; ++Iteration )
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		LegacyFound = 0;
+		for ( const FString& Key : Keys )
+		{
+			FStringTableConstPtr Table = FStringTableRegistry::Get().FindStringTable( FName( *TableID.ToString() ) );
+			FStringTableEntryConstPtr Entry = Table->FindEntry( *Key );
+			const FText Text = FText::FromString( *Entry->GetDisplayString() );
+			LegacyFound += Text.IsEmpty() ? 0 : 1;
+		}
+		LegacyBestTime = FMath::Min( LegacyBestTime, FPlatformTime::Seconds() - StartTime );
+	}
+
+	// The first pass fills the cache, the rest are all hits
+	double CachedBestTime = DBL_MAX;
+	int32 CachedFound = 0;
+	for ( int32 Iteration = 0; Iteration < NumIterations + 1; ++Iteration )
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		CachedFound = 0;
+		for ( const FString& Key : Keys )
+		{
+			const FText Text = UBYGLocalizationStatics::GetGameText( Key );
+			CachedFound += Text.IsEmpty() ? 0 : 1;
+		}
+		if ( Iteration > 0 )
+		{
+			CachedBestTime = FMath::Min( CachedBestTime, FPlatformTime::Seconds() - StartTime );
+		}
+	}
+
+	// Passing the category skips the GetGameText cache, so this is the cost of resolving everything in one pass
+	double BatchBestTime = DBL_MAX;
+	int32 BatchFound = 0;
+	TArray<FText> BatchTexts;
+	TArray<int32> MissingKeys;
+	for ( int32 Iteration = 0; Iteration < NumIterations; ++Iteration )
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		BatchFound = NumKeys - UBYGLocalizationStatics::GetGameTexts( Keys, BatchTexts, MissingKeys, TableID.ToString() );
+		BatchBestTime = FMath::Min( BatchBestTime, FPlatformTime::Seconds() - StartTime );
+	}
+
+	// Missing keys used to log an error every time, now only the first
+	const FString MissingKey = TEXT( "Missing_Line" );
+	double MissBestTime = DBL_MAX;
+	UBYGLocalizationStatics::GetGameText( MissingKey );
+	for ( int32 Iteration = 0; Iteration < NumIterations; ++Iteration )
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		for ( int32 i = 0; i < NumKeys; ++i )
+		{
+			UBYGLocalizationStatics::GetGameText( MissingKey );
+		}
+		MissBestTime = FMath::Min( MissBestTime, FPlatformTime::Seconds() - StartTime );
+	}
+
+	FStringTableRegistry::Get().UnregisterStringTable( TableID );
+	if ( PreviousTable.IsValid() )
+	{
+		FStringTableRegistry::Get().RegisterStringTable( TableID, ConstCastSharedRef<FStringTable>( PreviousTable.ToSharedRef() ) );
+	}
+	FBYGLocalizationModule::NotifyStringTablesChanged();
+
+	TestEqual( "same texts found", CachedFound, LegacyFound );
+	TestEqual( "same texts found in batch", BatchFound, LegacyFound );
+
+	AddInfo( FString::Printf( TEXT( "%d keys" ), NumKeys ) );
+	AddInfo( FString::Printf( TEXT( "Uncached:    %.1fns per call" ), LegacyBestTime * 1e9 / NumKeys ) );
+	AddInfo( FString::Printf( TEXT( "Cached hit:  %.1fns per call" ), CachedBestTime * 1e9 / NumKeys ) );
+	AddInfo( FString::Printf( TEXT( "Cached miss: %.1fns per call" ), MissBestTime * 1e9 / NumKeys ) );
+	AddInfo( FString::Printf( TEXT( "Batch:       %.1fns per key" ), BatchBestTime * 1e9 / NumKeys ) );
+
+	return true;
+}
+
+IMPLEMENT_CUSTOM_SIMPLE_AUTOMATION_TEST( FBYGHotReloadBenchmark, FFunctionalTestBase, "BYG.Localization.Benchmark.HotReload", BenchmarkFlags )
+bool FBYGHotReloadBenchmark::RunTest( const FString& Parameters )
+{
+	// Hot reloading a category should stay under 50ms for a file this size, from the file changing to the new table
+	// being registered
+	const int32 NumRows = 5000;
+	const int32 NumIterations = 10;
+	const double TargetTime = 0.05;
+	const double TimeOut = 10.0;
+
+	// The current language's file in a directory of its own, with the settings pointed at it
+	const FString DirectoryName = TEXT( "BYGHotReloadBenchmark" );
+	const FString Directory = FPaths::Combine( FPaths::ProjectContentDir(), DirectoryName );
+	const FString Filename = FPaths::Combine( Directory, TEXT( "loc_Game_en.csv" ) );
+
+	UBYGLocalizationSettings* Settings = UBYGLocalizationSettings::Get();
+	const FDirectoryPath OldPrimaryDirectory = Settings->PrimaryLocalizationDirectory;
+	const TArray<FBYGPath> OldAdditionalDirectories = Settings->AdditionalLocalizationDirectories;
+	const FString OldPrimaryLanguageCode = Settings->PrimaryLanguageCode;
+	const TArray<FString> OldCategories = Settings->LocalizationCategories;
+	const bool bOldUseCompiled = Settings->bUseCompiledLocalizations;
+	const bool bOldHotReload = Settings->bHotReloadLocalizations;
+
+	Settings->PrimaryLocalizationDirectory.Path = TEXT( "/Game/" ) + DirectoryName;
+	Settings->AdditionalLocalizationDirectories.Empty();
+	Settings->PrimaryLanguageCode = TEXT( "en" );
+	Settings->LocalizationCategories = { TEXT( "Game" ) };
+	Settings->bUseCompiledLocalizations = false;
+	Settings->bHotReloadLocalizations = true;
+
+	TestTrue( "write file", FFileHelper::SaveStringToFile( BYGLocalizationBenchmark::MakeTranslationCSV( NumRows, FString() ), *Filename, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM ) );
+
+	FBYGLocalizationModule& Module = FBYGLocalizationModule::Get();
+	UBYGLocalization* Loc = Module.GetLocalization();
+	const FString OldLanguageCode = Module.GetCurrentLanguageCode();
+	Loc->InvalidateLocalizationCatalog();
+	Module.SetCurrentLanguageCode( TEXT( "en" ) );
+	Module.ReloadLocalizations();
+
+	FBYGLocaleInfo Info;
+	TestTrue( "find file", Loc->FindLocalization( TEXT( "en" ), TEXT( "Game" ), Info ) );
+
+	double BestTime = DBL_MAX;
+	double WorstTime = 0.0;
+	for ( int32 Iteration = 0; Iteration < NumIterations; ++Iteration )
+	{
+		// Different text every time, a reload that changes nothing isn't registered
+		const FString Prefix = FString::Printf( TEXT( "Reload %d: " ), Iteration );
+		TestTrue( "rewrite file", FFileHelper::SaveStringToFile( BYGLocalizationBenchmark::MakeTranslationCSV( NumRows, Prefix ), *Filename, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM ) );
+
+		// What the directory watcher does when it sees the file change. The table is parsed on a worker thread and
+		// registered by a task on the game thread, so game thread tasks are run until it's there
+		const uint32 Generation = FBYGLocalizationModule::GetStringTableGeneration();
+		const double StartTime = FPlatformTime::Seconds();
+		Loc->OnLocalizationFileModified.Broadcast( Info );
+		while ( FBYGLocalizationModule::GetStringTableGeneration() == Generation && FPlatformTime::Seconds() - StartTime < TimeOut )
+		{
+			FTaskGraphInterface::Get().ProcessThreadUntilIdle( ENamedThreads::GameThread );
+			FPlatformProcess::Sleep( 0.0f );
+		}
+		const double Time = FPlatformTime::Seconds() - StartTime;
+		BestTime = FMath::Min( BestTime, Time );
+		WorstTime = FMath::Max( WorstTime, Time );
+
+		if ( !TestTrue( "table registered", FBYGLocalizationModule::GetStringTableGeneration() != Generation ) )
+			break;
+		TestEqual( "reloaded text", FText::FromStringTable( TEXT( "Game" ), TEXT( "Dialogue_Line_1" ) ).ToString(), Prefix + TEXT( "Line 1, said with feeling." ) );
+	}
+
+	Settings->PrimaryLocalizationDirectory = OldPrimaryDirectory;
+	Settings->AdditionalLocalizationDirectories = OldAdditionalDirectories;
+	Settings->PrimaryLanguageCode = OldPrimaryLanguageCode;
+	Settings->LocalizationCategories = OldCategories;
+	Settings->bUseCompiledLocalizations = bOldUseCompiled;
+	Settings->bHotReloadLocalizations = bOldHotReload;
+	IFileManager::Get().DeleteDirectory( *Directory, false, true );
+	Loc->InvalidateLocalizationCatalog();
+	Module.SetCurrentLanguageCode( OldLanguageCode );
+	Module.ReloadLocalizations();
+
+	AddInfo( FString::Printf( TEXT( "%d rows" ), NumRows ) );
+	AddInfo( FString::Printf( TEXT( "Change to registered: %.2fms best, %.2fms worst (target %.0fms)" ), BestTime * 1000.0, WorstTime * 1000.0, TargetTime * 1000.0 ) );
+	if ( BestTime > TargetTime )
+	{
+		AddWarning( TEXT( "Hot reloading took longer than the target" ) );
+	}
+
+	return true;
+}
+
+namespace BYGLocalizationBenchmark
+{
+	// What UBYGLocalization::GenerateDebugTranslation used to do, with a guard for text without vowels
+	void LegacyPseudoLocalize( const FString& PrimaryEntry, FString& DebugTranslation )
+	{
+		DebugTranslation = PrimaryEntry;
+
+		const int32 Length = PrimaryEntry.Len();
+		const int32 VowelsToAdd = FMath::CeilToInt( (float)Length * 1.5f ) - Length;
+
+		if ( ( PrimaryEntry.Contains( "<" ) && PrimaryEntry.Contains( ">" ) ) || PrimaryEntry.Contains( "|" ) || PrimaryEntry.Contains( "{" ) || PrimaryEntry.Contains( "}" )
+			|| PrimaryEntry.Contains( "[" ) || PrimaryEntry.Contains( "]" ) )
+		{
+			DebugTranslation = "[" + PrimaryEntry + "]";
+			return;
+		}
+
+		int32 TotalVowels = 0;
+		for ( int32 i = 0; i < Length; i++ )
+		{
+			FString Char = PrimaryEntry.Mid( i, 1 );
+			if ( Char.Contains( "A" ) || Char.Contains( "E" ) || Char.Contains( "I" ) || Char.Contains( "O" ) || Char.Contains( "U" ) )
+			{
+				TotalVowels++;
+			}
+		}
+
+		const int32 ExtraVowelsPerPosition = TotalVowels > 0 ? FMath::CeilToInt( (float)VowelsToAdd / TotalVowels ) : 0;
+
+		for ( int32 i = Length - 1; i >= 0; i-- )
+		{
+			FString Char = PrimaryEntry.Mid( i, 1 ).ToLower();
+			if ( Char.Contains( "A" ) || Char.Contains( "E" ) || Char.Contains( "I" ) || Char.Contains( "O" ) || Char.Contains( "U" ) )
+			{
+				for ( int32 j = 0; j < ExtraVowelsPerPosition; j++ )
+				{
+					DebugTranslation.InsertAt( i + 1, Char );
+				}
+			}
+		}
+
+		DebugTranslation = "[" + DebugTranslation + "]";
+	}
+}
+
+IMPLEMENT_CUSTOM_SIMPLE_AUTOMATION_TEST( FBYGPseudoLocalizationBenchmark, FFunctionalTestBase, "BYG.Localization.Benchmark.PseudoLocalization", BenchmarkFlags )
+bool FBYGPseudoLocalizationBenchmark::RunTest( const FString& Parameters )
+{
+	const int32 NumLines = 40000;
+	const int32 NumIterations = 5;
+
+	// Mostly plain sentences, with some markup and some without vowels like a real UI file
+	TArray<FString> Lines;
+	Lines.Reserve( NumLines );
+	for ( int32 i = 0; i < NumLines; ++i )
+	{
+		switch ( i % 8 )
+		{
+		case 0:
+			Lines.Add( FString::Printf( TEXT( "<Bold>Warning</> {Count} |plural(one=unit,other=units) lost in sector %d" ), i ) );
+			break;
+		case 1:
+			Lines.Add( FString::Printf( TEXT( "%d" ), i ) );
+			break;
+		default:
+			Lines.Add( FString::Printf( TEXT( "Line %d, said with feeling. The quick brown fox jumps over the lazy dog." ), i ) );
+			break;
+		}
+	}
+
+	TArray<FString> Output;
+	Output.SetNum( NumLines );
+	int64 LegacyChars = 0;
+	int64 NewChars = 0;
+	double LegacyBestTime = DBL_MAX;
+	double NewBestTime = DBL_MAX;
+	double ParallelBestTime = DBL_MAX;
+
+	const FBYGPseudoLocalizer PseudoLocalizer;
+	for ( int32 Iteration = 0; Iteration < NumIterations; ++Iteration )
+	{
+		double StartTime = FPlatformTime::Seconds();
+		for ( int32 i = 0; i < NumLines; ++i )
+		{
+			BYGLocalizationBenchmark::LegacyPseudoLocalize( Lines[ i ], Output[ i ] );
+		}
+		LegacyBestTime = FMath::Min( LegacyBestTime, FPlatformTime::Seconds() - StartTime );
+
+		LegacyChars = 0;
+		for ( const FString& Line : Output )
+		{
+			LegacyChars += Line.Len();
+		}
+
+		StartTime = FPlatformTime::Seconds();
+		for ( int32 i = 0; i < NumLines; ++i )
+		{
+			PseudoLocalizer.Localize( Lines[ i ], Output[ i ] );
+		}
+		NewBestTime = FMath::Min( NewBestTime, FPlatformTime::Seconds() - StartTime );
+
+		StartTime = FPlatformTime::Seconds();
+		ParallelFor( TEXT( "BYGLocalization.PseudoLocalize" ), NumLines, 256, [&]( int32 i )
+		{
+			PseudoLocalizer.Localize( Lines[ i ], Output[ i ] );
+		} );
+		ParallelBestTime = FMath::Min( ParallelBestTime, FPlatformTime::Seconds() - StartTime );
+
+		NewChars = 0;
+		for ( const FString& Line : Output )
+		{
+			NewChars += Line.Len();
+		}
+	}
+
+	AddInfo( FString::Printf( TEXT( "%d lines" ), NumLines ) );
+	AddInfo( FString::Printf( TEXT( "Legacy:      %.2fms, %lld characters" ), LegacyBestTime * 1000.0, LegacyChars ) );
+	AddInfo( FString::Printf( TEXT( "Single pass: %.2fms, %lld characters" ), NewBestTime * 1000.0, NewChars ) );
+	AddInfo( FString::Printf( TEXT( "Threaded:    %.2fms" ), ParallelBestTime * 1000.0 ) );
+
+	return true;
+}
+
+
+namespace BYGLocalizationBenchmark
+{
+	// Primary rows shaped like dialogue
+	TArray<FBYGLocalizationEntry> MakePrimaryEntries( int32 NumKeys )
+	{
+		TArray<FBYGLocalizationEntry> Entries;
+		Entries.Reserve( NumKeys );
+		for ( int32 i = 0; i < NumKeys; ++i )
+		{
+			Entries.Emplace( FString::Printf( TEXT( "Dialogue_Line_%d" ), i ), FString::Printf( TEXT( "Line %d, said with feeling." ), i ), TEXT( "Comment" ) );
+		}
+		return Entries;
+	}
+
+	// A translation that is up to date with the primary, so merging it logs nothing
+	TArray<FBYGLocalizationEntry> MakeTranslationEntries( const TArray<FBYGLocalizationEntry>& PrimaryEntries, int32 Language )
+	{
+		TArray<FBYGLocalizationEntry> Entries;
+		Entries.Reserve( PrimaryEntries.Num() );
+		for ( const FBYGLocalizationEntry& PrimaryEntry : PrimaryEntries )
+		{
+			FBYGLocalizationEntry& Entry = Entries.Emplace_GetRef( PrimaryEntry.Key, FString::Printf( TEXT( "%d: %s" ), Language, *PrimaryEntry.Translation ), PrimaryEntry.Comment );
+			Entry.Primary = PrimaryEntry.Translation;
+		}
+		return Entries;
+	}
+
+	// What UpdateTranslationFile used to do for each language, copying every row
+	TArray<FBYGLocalizationEntry> LegacyMergeTranslation( const FBYGLocaleData& PrimaryData, const FBYGLocaleData& LocalData )
+	{
+		const TArray<FBYGLocalizationEntry>& LocalEntries = *LocalData.GetEntriesInOrder();
+		TArray<FBYGLocalizationEntry> NewEntriesInOrder;
+		for ( int32 PrimaryIndex = 0; PrimaryIndex < PrimaryData.GetEntriesInOrder()->Num(); ++PrimaryIndex )
+		{
+			const FBYGLocalizationEntry& PrimaryEntry = ( *PrimaryData.GetEntriesInOrder() )[ PrimaryIndex ];
+
+			FBYGLocalizationEntry OldLocalizedEntry;
+			if ( const TOptional<int32> LocalIndex = LocalData.FindIndexByHash( PrimaryData.GetKeyHash( PrimaryIndex ), PrimaryEntry.Key ) )
+			{
+				OldLocalizedEntry = LocalEntries[ *LocalIndex ];
+			}
+
+			FBYGLocalizationEntry NewLocalizedEntry;
+			NewLocalizedEntry.Key = PrimaryEntry.Key;
+			NewLocalizedEntry.Primary = PrimaryEntry.Translation;
+			if ( OldLocalizedEntry.Translation.IsEmpty() && !PrimaryEntry.Translation.IsEmpty() )
+			{
+				NewLocalizedEntry.Translation = PrimaryEntry.Translation;
+				NewLocalizedEntry.Status = EBYGLocEntryStatus::New;
+			}
+			else if ( OldLocalizedEntry.Primary != PrimaryEntry.Translation )
+			{
+				NewLocalizedEntry = OldLocalizedEntry;
+				NewLocalizedEntry.Primary = PrimaryEntry.Translation;
+			}
+			else
+			{
+				NewLocalizedEntry = OldLocalizedEntry;
+			}
+			NewLocalizedEntry.Comment = PrimaryEntry.Comment;
+			NewEntriesInOrder.Add( NewLocalizedEntry );
+		}
+		for ( int32 LocalIndex = 0; LocalIndex < LocalEntries.Num(); ++LocalIndex )
+		{
+			if ( !PrimaryData.FindIndexByHash( LocalData.GetKeyHash( LocalIndex ), LocalEntries[ LocalIndex ].Key ) )
+			{
+				NewEntriesInOrder.Add( LocalEntries[ LocalIndex ] );
+			}
+		}
+		return NewEntriesInOrder;
+	}
+}
+
+IMPLEMENT_CUSTOM_SIMPLE_AUTOMATION_TEST( FBYGTranslationMergeBenchmark, FFunctionalTestBase, "BYG.Localization.Benchmark.TranslationMerge", BenchmarkFlags )
+bool FBYGTranslationMergeBenchmark::RunTest( const FString& Parameters )
+{
+	const int32 NumKeys = 50000;
+	const int32 NumTargets = 15;
+	const int32 NumIterations = 3;
+
+	const FBYGLocaleData PrimaryData( BYGLocalizationBenchmark::MakePrimaryEntries( NumKeys ) );
+
+	TArray<FBYGLocaleData> TargetData;
+	TargetData.Reserve( NumTargets );
+	for ( int32 Target = 0; Target < NumTargets; ++Target )
+	{
+		TargetData.Emplace( BYGLocalizationBenchmark::MakeTranslationEntries( *PrimaryData.GetEntriesInOrder(), Target ) );
+	}
+
+	double LegacyBestTime = DBL_MAX;
+	double MergeBestTime = DBL_MAX;
+	int64 LegacyRows = 0;
+	int64 MergeRows = 0;
+
+	for ( int32 Iteration = 0; Iteration < NumIterations; ++Iteration )
+	{
+		// What UpdateTranslationFile used to do for each language: go through the whole primary again
+		double StartTime = FPlatformTime::Seconds();
+		LegacyRows = 0;
+		for ( const FBYGLocaleData& LocalData : TargetData )
+		{
+			LegacyRows += BYGLocalizationBenchmark::LegacyMergeTranslation( PrimaryData, LocalData ).Num();
+		}
+		LegacyBestTime = FMath::Min( LegacyBestTime, FPlatformTime::Seconds() - StartTime );
+
+		// Merging moves rows out of the translations, so each iteration gets its own
+		TArray<FBYGLocaleData> MergeData = TargetData;
+
+		StartTime = FPlatformTime::Seconds();
+		const FBYGTranslationMergePolicy Policy;
+		TArray<FBYGMergeTarget> Targets;
+		Targets.SetNum( NumTargets );
+		for ( int32 Target = 0; Target < NumTargets; ++Target )
+		{
+			Targets[ Target ].Data = &MergeData[ Target ];
+			Targets[ Target ].Policy = &Policy;
+		}
+		FBYGTranslationMerge::Merge( PrimaryData, Targets );
+		MergeRows = 0;
+		for ( const FBYGMergeTarget& Target : Targets )
+		{
+			MergeRows += Target.Entries.Num();
+		}
+		MergeBestTime = FMath::Min( MergeBestTime, FPlatformTime::Seconds() - StartTime );
+	}
+
+	TestEqual( "same rows", MergeRows, LegacyRows );
+
+	AddInfo( FString::Printf( TEXT( "%d keys, %d languages" ), NumKeys, NumTargets ) );
+	AddInfo( FString::Printf( TEXT( "One pass per language: %.2fms" ), LegacyBestTime * 1000.0 ) );
+	AddInfo( FString::Printf( TEXT( "One pass for all:      %.2fms" ), MergeBestTime * 1000.0 ) );
+
+	return true;
+}
+
+
+namespace BYGLocalizationBenchmark
+{
+	// Highest physical memory use of the whole process while Body runs, above what was used just before it. Sampled
+	// from another thread every millisecond, so it's only as exact as the platform's stats. The allocator is trimmed
+	// first so memory it was holding on to from earlier tests isn't handed out for free
+	int64 MeasurePeakMemory( TFunctionRef<void()> Body )
+	{
+		GMalloc->Trim( true );
+		const int64 Baseline = FPlatformMemory::GetStats().UsedPhysical;
+
+		std::atomic<bool> bDone { false };
+		int64 Peak = Baseline;
+		TFuture<void> Sampler = Async( EAsyncExecution::Thread, [&bDone, &Peak]()
+		{
+			do
+			{
+				Peak = FMath::Max<int64>( Peak, FPlatformMemory::GetStats().UsedPhysical );
+				FPlatformProcess::Sleep( 0.001f );
+			}
+			while ( !bDone );
+		} );
+
+		Body();
+
+		bDone = true;
+		Sampler.Wait();
+		return FMath::Max<int64>( 0, Peak - Baseline );
+	}
+}
+
+IMPLEMENT_CUSTOM_SIMPLE_AUTOMATION_TEST( FBYGUpdateMemoryBenchmark, FFunctionalTestBase, "BYG.Localization.Benchmark.UpdateMemory", BenchmarkFlags )
+bool FBYGUpdateMemoryBenchmark::RunTest( const FString& Parameters )
+{
+	const int32 NumKeys = 20000;
+	const int32 NumCategories = 4;
+	const TArray<FString> TargetCodes = { "fr", "de", "es", "it", "pt", "ru", "pl", "ja", "ko", "zh", "tr", "nl", "sv", "cs", "hu" };
+
+	// A real UpdateTranslations over files written to a directory of their own, with the settings pointed at it
+	const FString DirectoryName = TEXT( "BYGUpdateMemoryBenchmark" );
+	const FString Directory = FPaths::Combine( FPaths::ProjectContentDir(), DirectoryName );
+
+	UBYGLocalizationSettings* Settings = UBYGLocalizationSettings::Get();
+	const FDirectoryPath OldPrimaryDirectory = Settings->PrimaryLocalizationDirectory;
+	const TArray<FBYGPath> OldAdditionalDirectories = Settings->AdditionalLocalizationDirectories;
+	const FString OldPrimaryLanguageCode = Settings->PrimaryLanguageCode;
+	const TArray<FString> OldLanguageCodes = Settings->LanguageCodesInUse;
+	const int32 OldMaxThreads = Settings->MaxTranslationUpdateThreads;
+	const bool bOldIncremental = Settings->bIncrementalTranslationUpdate;
+	const bool bOldCreateBackup = Settings->bCreateBackup;
+
+	Settings->PrimaryLocalizationDirectory.Path = TEXT( "/Game/" ) + DirectoryName;
+	Settings->AdditionalLocalizationDirectories.Empty();
+	Settings->PrimaryLanguageCode = TEXT( "en" );
+	Settings->LanguageCodesInUse = TargetCodes;
+	Settings->LanguageCodesInUse.Insert( TEXT( "en" ), 0 );
+	Settings->bIncrementalTranslationUpdate = false;
+	Settings->bCreateBackup = false;
+
+	// Written again before every run so each one reads, merges and writes every file
+	int64 NumBytes = 0;
+	auto WriteFiles = [&]()
+	{
+		NumBytes = 0;
+		for ( int32 Category = 0; Category < NumCategories; ++Category )
+		{
+			const FString CategoryName = FString::Printf( TEXT( "Category%d" ), Category );
+			for ( const FString& Code : Settings->LanguageCodesInUse )
+			{
+				const bool bPrimary = Code == Settings->PrimaryLanguageCode;
+				const FString CSV = BYGLocalizationBenchmark::MakeTranslationCSV( NumKeys, bPrimary ? FString() : Code + TEXT( ": " ) );
+				const FString Filename = bPrimary
+					? FPaths::Combine( Directory, FString::Printf( TEXT( "loc_%s_%s.csv" ), *CategoryName, *Code ) )
+					: FPaths::Combine( Directory, Code, FString::Printf( TEXT( "loc_%s_%s.csv" ), *CategoryName, *Code ) );
+				TestTrue( "write " + Filename, FFileHelper::SaveStringToFile( CSV, *Filename, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM ) );
+				NumBytes += IFileManager::Get().FileSize( *Filename );
+			}
+		}
+	};
+
+	auto MeasureUpdate = [&]( int32 MaxThreads, double& OutTime )
+	{
+		Settings->MaxTranslationUpdateThreads = MaxThreads;
+		WriteFiles();
+		UBYGLocalization* Loc = new UBYGLocalization();
+		const int64 Peak = BYGLocalizationBenchmark::MeasurePeakMemory( [&]()
+		{
+			const double StartTime = FPlatformTime::Seconds();
+			TestTrue( "update succeeded", Loc->UpdateTranslations() );
+			OutTime = FPlatformTime::Seconds() - StartTime;
+		} );
+		delete Loc;
+		return Peak;
+	};
+
+	double SerialTime = 0.0;
+	double ParallelTime = 0.0;
+	const int64 SerialPeak = MeasureUpdate( 1, SerialTime );
+	const int64 ParallelPeak = MeasureUpdate( 0, ParallelTime );
+
+	// Every translation should still have every key
+	int32 MergedRows = 0;
+	FBYGCsvReader Reader;
+	TestTrue( "read merged file", Reader.ReadFile( FPaths::Combine( Directory, TEXT( "fr" ), TEXT( "loc_Category0_fr.csv" ) ), [&MergedRows]( const FBYGCsvRow& Row )
+	{
+		MergedRows += Row.Index > 0 ? 1 : 0;
+		return true;
+	} ) );
+	TestEqual( "merged rows", MergedRows, NumKeys );
+
+	Settings->PrimaryLocalizationDirectory = OldPrimaryDirectory;
+	Settings->AdditionalLocalizationDirectories = OldAdditionalDirectories;
+	Settings->PrimaryLanguageCode = OldPrimaryLanguageCode;
+	Settings->LanguageCodesInUse = OldLanguageCodes;
+	Settings->MaxTranslationUpdateThreads = OldMaxThreads;
+	Settings->bIncrementalTranslationUpdate = bOldIncremental;
+	Settings->bCreateBackup = bOldCreateBackup;
+	IFileManager::Get().DeleteDirectory( *Directory, false, true );
+
+	AddInfo( FString::Printf( TEXT( "%d categories of %d keys, %d languages, %.1fMB of files" ), NumCategories, NumKeys, TargetCodes.Num(), NumBytes / ( 1024.0 * 1024.0 ) ) );
+	AddInfo( FString::Printf( TEXT( "One thread:  %.2fms, %.1fMB peak" ), SerialTime * 1000.0, SerialPeak / ( 1024.0 * 1024.0 ) ) );
+	AddInfo( FString::Printf( TEXT( "All threads: %.2fms, %.1fMB peak" ), ParallelTime * 1000.0, ParallelPeak / ( 1024.0 * 1024.0 ) ) );
+
+	return true;
+}
+
+
+namespace BYGLocalizationBenchmark
+{
+	// What UBYGLocalization::WriteCSV used to do for each row, minus the settings lookups
+	void LegacyAppendCSVRow( const FBYGLocalizationEntry& Entry, bool bQuote, TArray<uint8>& Output )
+	{
+		auto Escape = []( const FString& Str )
+		{
+			FString Result( *Str );
+			Result.ReplaceInline( TEXT( "\"" ), TEXT( "\"\"" ) );
+			return Result;
+		};
+		auto LazyWrap = []( const FString& InStr, bool bForceWrap ) -> FString
+		{
+			if ( ( bForceWrap || InStr.Contains( "\"" ) || InStr.Contains( "\r" ) || InStr.Contains( "\n" ) || InStr.Contains( "," ) ) && !InStr.IsEmpty() )
+			{
+				return "\"" + InStr + "\"";
+			}
+			return InStr;
+		};
+
+		FString ExportedStatus = "";
+		if ( Entry.Status == EBYGLocEntryStatus::Modified )
+		{
+			ExportedStatus = FString::Printf( TEXT( "%s%s%s" ), TEXT( "Modified: Was '" ), *Entry.OldPrimary, TEXT( "'" ) );
+		}
+		else if ( Entry.Status == EBYGLocEntryStatus::New )
+		{
+			ExportedStatus = TEXT( "New Entry" );
+		}
+
+		const FString CSVEntry = FString::Printf( TEXT( "%s,%s,%s,%s,%s" ),
+			*Escape( Entry.Key ),
+			*LazyWrap( Escape( Entry.Translation ), bQuote ),
+			*LazyWrap( Escape( Entry.Comment ), bQuote ),
+			*LazyWrap( Escape( Entry.Primary ), bQuote ),
+			*LazyWrap( Escape( ExportedStatus ), bQuote ) );
+
+		FTCHARToUTF8 UTF8String( *( CSVEntry + LINE_TERMINATOR ) );
+		Output.Append( (const uint8*)UTF8String.Get(), UTF8String.Length() );
+	}
+
+	void AppendCSVRow( const FBYGLocalizationEntry& Entry, FString& ModifiedStatus, FBYGCsvWriter& Writer )
+	{
+		FStringView Status;
+		if ( Entry.Status == EBYGLocEntryStatus::Modified )
+		{
+			ModifiedStatus.Reset();
+			ModifiedStatus += TEXT( "Modified: Was '" );
+			ModifiedStatus += Entry.OldPrimary;
+			ModifiedStatus += TEXT( "'" );
+			Status = ModifiedStatus;
+		}
+		else if ( Entry.Status == EBYGLocEntryStatus::New )
+		{
+			Status = TEXT( "New Entry" );
+		}
+
+		Writer.AddCell( Entry.Key, false );
+		Writer.AddCell( Entry.Translation );
+		Writer.AddCell( Entry.Comment );
+		Writer.AddCell( Entry.Primary );
+		Writer.AddCell( Status );
+		Writer.EndRow();
+	}
+}
+
+IMPLEMENT_CUSTOM_SIMPLE_AUTOMATION_TEST( FBYGWriteCSVBenchmark, FFunctionalTestBase, "BYG.Localization.Benchmark.WriteCSV", BenchmarkFlags )
+bool FBYGWriteCSVBenchmark::RunTest( const FString& Parameters )
+{
+	const int32 NumRows = 1000000;
+	const int32 NumIterations = 3;
+
+	// Mostly plain ASCII, with some of every case that changes how a cell is written
+	TArray<FBYGLocalizationEntry> Entries;
+	Entries.Reserve( NumRows );
+	for ( int32 i = 0; i < NumRows; ++i )
+	{
+		FBYGLocalizationEntry& Entry = Entries.Emplace_GetRef( FString::Printf( TEXT( "Dialogue_Line_%d" ), i ), FString::Printf( TEXT( "Line %d said with feeling" ), i ), TEXT( "Comment" ) );
+		Entry.Primary = Entry.Translation;
+		switch ( i % 16 )
+		{
+		case 1: Entry.Translation += TEXT( ", and a comma" ); break;
+		case 2: Entry.Translation += TEXT( " \"quoted\"" ); break;
+		case 3: Entry.Translation += TEXT( "\r\nover two lines" ); break;
+		case 4: Entry.Translation += TEXT( " pr\u00EAt \u00E0 partir" ); break;
+		case 5: Entry.Translation += TEXT( " \u65E5\u672C \"\U0001F600\"" ); break;
+		case 6: Entry.Status = EBYGLocEntryStatus::New; break;
+		case 7: Entry.Status = EBYGLocEntryStatus::Modified; Entry.OldPrimary = TEXT( "Was \"this\"" ); break;
+		default: break;
+		}
+	}
+
+	for ( const bool bQuote : { false, true } )
+	{
+		double LegacyBestTime = DBL_MAX;
+		double WriterBestTime = DBL_MAX;
+		TArray<uint8> LegacyOutput;
+		TArray<uint8> WriterOutput;
+
+		for ( int32 Iteration = 0; Iteration < NumIterations; ++Iteration )
+		{
+			double StartTime = FPlatformTime::Seconds();
+			LegacyOutput.Empty();
+			for ( const FBYGLocalizationEntry& Entry : Entries )
+			{
+				BYGLocalizationBenchmark::LegacyAppendCSVRow( Entry, bQuote, LegacyOutput );
+			}
+			LegacyBestTime = FMath::Min( LegacyBestTime, FPlatformTime::Seconds() - StartTime );
+
+			StartTime = FPlatformTime::Seconds();
+			FBYGCsvWriter Writer( bQuote );
+			int64 EstimatedSize = 0;
+			for ( const FBYGLocalizationEntry& Entry : Entries )
+			{
+				EstimatedSize += Entry.Key.Len() + Entry.Translation.Len() + Entry.Comment.Len() + Entry.Primary.Len() + 8;
+			}
+			Writer.Reserve( (int32)FMath::Min<int64>( EstimatedSize, MAX_int32 ) );
+			FString ModifiedStatus;
+			for ( const FBYGLocalizationEntry& Entry : Entries )
+			{
+				BYGLocalizationBenchmark::AppendCSVRow( Entry, ModifiedStatus, Writer );
+			}
+			WriterBestTime = FMath::Min( WriterBestTime, FPlatformTime::Seconds() - StartTime );
+			WriterOutput = Writer.GetOutput();
+		}
+
+		TestTrue( FString::Printf( TEXT( "byte-identical, quoted %d" ), bQuote ), LegacyOutput.Num() == WriterOutput.Num()
+			&& FMemory::Memcmp( LegacyOutput.GetData(), WriterOutput.GetData(), LegacyOutput.Num() ) == 0 );
+
+		AddInfo( FString::Printf( TEXT( "%d rows, %.1fMB, %s" ), NumRows, WriterOutput.Num() / ( 1024.0 * 1024.0 ), bQuote ? TEXT( "always quoted" ) : TEXT( "quoted when needed" ) ) );
+		AddInfo( FString::Printf( TEXT( "Per-row strings: %.2fms" ), LegacyBestTime * 1000.0 ) );
+		AddInfo( FString::Printf( TEXT( "FBYGCsvWriter:   %.2fms" ), WriterBestTime * 1000.0 ) );
+	}
+
+	return true;
+}
+
+namespace BYGLocalizationBenchmark
+{
+	// UBYGLocalizationStatics::ExportStrings before it streamed: the whole file built in one FString, then saved
+	bool LegacyExportStrings( const FName StringTableName, const FString& InFilename )
+	{
+		const FStringTableConstPtr StringTable = FStringTableRegistry::Get().FindStringTable( StringTableName );
+		if ( !StringTable.IsValid() )
+		{
+			return false;
+		}
+
+		FString ExportedStrings = TEXT( "Key,SourceString,Comment,Primary,Status\r\n" );
+		StringTable->EnumerateSourceStrings( [&]( const FString& InKey, const FString& InSourceString ) -> bool
+		{
+			FString ExportedKey = InKey.ReplaceCharWithEscapedChar();
+			ExportedKey.ReplaceInline( TEXT( "\"" ), TEXT( "\"\"" ) );
+			FString ExportedSourceString = InSourceString.ReplaceCharWithEscapedChar();
+			ExportedSourceString.ReplaceInline( TEXT( "\"" ), TEXT( "\"\"" ) );
+			ExportedStrings += TEXT( "\"" ) + ExportedKey + TEXT( "\",\"" ) + ExportedSourceString + TEXT( "\"" );
+			for ( const TCHAR* MetaDataColumnName : { TEXT( "Comment" ), TEXT( "Primary" ), TEXT( "Status" ) } )
+			{
+				FString ExportedMetaData = StringTable->GetMetaData( InKey, MetaDataColumnName ).ReplaceCharWithEscapedChar();
+				ExportedMetaData.ReplaceInline( TEXT( "\"" ), TEXT( "\"\"" ) );
+				ExportedStrings += TEXT( ",\"" ) + ExportedMetaData + TEXT( "\"" );
+			}
+			ExportedStrings += TEXT( "\r\n" );
+			return true;
+		} );
+
+		return FFileHelper::SaveStringToFile( ExportedStrings, *InFilename, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM );
+	}
+}
+
+IMPLEMENT_CUSTOM_SIMPLE_AUTOMATION_TEST( FBYGExportStringsBenchmark, FFunctionalTestBase, "BYG.Localization.Benchmark.ExportStrings", BenchmarkFlags )
+bool FBYGExportStringsBenchmark::RunTest( const FString& Parameters )
+{
+	const int32 NumTables = 8;
+	const int32 NumKeys = 50000;
+	const int32 NumIterations = 3;
+
+	TArray<TPair<FName, FString>> LegacyFiles;
+	TArray<TPair<FName, FString>> StreamedFiles;
+	for ( int32 Table = 0; Table < NumTables; ++Table )
+	{
+		const FName TableID( *FString::Printf( TEXT( "BYGExportBenchmark%d" ), Table ) );
+		FStringTableRef StringTable = FStringTable::NewStringTable();
+		StringTable->SetNamespace( TableID.ToString() );
+		for ( const FBYGLocalizationEntry& Entry : BYGLocalizationBenchmark::MakePrimaryEntries( NumKeys ) )
+		{
+			StringTable->SetSourceString( Entry.Key, Entry.Translation );
+			StringTable->SetMetaData( Entry.Key, TEXT( "Comment" ), Entry.Comment );
+			StringTable->SetMetaData( Entry.Key, TEXT( "Primary" ), Entry.Primary );
+			StringTable->SetMetaData( Entry.Key, TEXT( "Status" ), TEXT( "Modified: Was \"this\"" ) );
+		}
+		FStringTableRegistry::Get().UnregisterStringTable( TableID );
+		FStringTableRegistry::Get().RegisterStringTable( TableID, StringTable );
+
+		const FString Filename = FPaths::Combine( FPaths::AutomationTransientDir(), TableID.ToString() );
+		LegacyFiles.Emplace( TableID, Filename + TEXT( "_Legacy.csv" ) );
+		StreamedFiles.Emplace( TableID, Filename + TEXT( "_Streamed.csv" ) );
+	}
+
+	double LegacyBestTime = DBL_MAX;
+	double StreamedBestTime = DBL_MAX;
+	for ( int32 Iteration = 0; Iteration < NumIterations; ++Iteration )
+	{
+		double StartTime = FPlatformTime::Seconds();
+		for ( const TPair<FName, FString>& File : LegacyFiles )
+		{
+			BYGLocalizationBenchmark::LegacyExportStrings( File.Key, File.Value );
+		}
+		LegacyBestTime = FMath::Min( LegacyBestTime, FPlatformTime::Seconds() - StartTime );
+
+		StartTime = FPlatformTime::Seconds();
+		TestTrue( "exported", UBYGLocalizationStatics::ExportStrings( StreamedFiles ) );
+		StreamedBestTime = FMath::Min( StreamedBestTime, FPlatformTime::Seconds() - StartTime );
+	}
+
+	// Memory held while writing a single table
+	const int64 LegacyPeak = BYGLocalizationBenchmark::MeasurePeakMemory( [&]()
+	{
+		BYGLocalizationBenchmark::LegacyExportStrings( LegacyFiles[ 0 ].Key, LegacyFiles[ 0 ].Value );
+	} );
+	const int64 StreamedPeak = BYGLocalizationBenchmark::MeasurePeakMemory( [&]()
+	{
+		UBYGLocalizationStatics::ExportStrings( StreamedFiles[ 0 ].Key, StreamedFiles[ 0 ].Value );
+	} );
+
+	int64 NumBytes = 0;
+	for ( int32 Table = 0; Table < NumTables; ++Table )
+	{
+		TArray<uint8> LegacyBytes;
+		TArray<uint8> StreamedBytes;
+		FFileHelper::LoadFileToArray( LegacyBytes, *LegacyFiles[ Table ].Value );
+		FFileHelper::LoadFileToArray( StreamedBytes, *StreamedFiles[ Table ].Value );
+		TestTrue( FString::Printf( TEXT( "byte-identical, table %d" ), Table ), LegacyBytes == StreamedBytes );
+		NumBytes += StreamedBytes.Num();
+
+		FStringTableRegistry::Get().UnregisterStringTable( LegacyFiles[ Table ].Key );
+		IFileManager::Get().Delete( *LegacyFiles[ Table ].Value );
+		IFileManager::Get().Delete( *StreamedFiles[ Table ].Value );
+	}
+	TestTrue( "less memory", StreamedPeak < LegacyPeak );
+
+	AddInfo( FString::Printf( TEXT( "%d tables of %d keys, %.1fMB" ), NumTables, NumKeys, NumBytes / ( 1024.0 * 1024.0 ) ) );
+	AddInfo( FString::Printf( TEXT( "One FString, one at a time: %.2fms, %.1fMB peak" ), LegacyBestTime * 1000.0, LegacyPeak / ( 1024.0 * 1024.0 ) ) );
+	AddInfo( FString::Printf( TEXT( "Streamed, in parallel:      %.2fms, %.1fMB peak" ), StreamedBestTime * 1000.0, StreamedPeak / ( 1024.0 * 1024.0 ) ) );
+
+	return true;
+}
+
+#endif
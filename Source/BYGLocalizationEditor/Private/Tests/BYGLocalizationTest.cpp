@@ -9,13 +9,27 @@
 
 #include "BYGLocalization/Public/BYGLocalizationStatics.h"
 #include "BYGLocalization/Public/BYGLocalization.h"
+#include "BYGLocalization/Public/BYGLocalizationBlob.h"
+#include "BYGLocalization/Public/BYGCsvReader.h"
+#include "BYGLocalization/Public/BYGCsvWriter.h"
+#include "BYGLocalization/Public/BYGKeyIndex.h"
+#include "BYGLocalization/Public/BYGLocalizationModule.h"
+#include "BYGLocalization/Public/BYGPseudoLocalizer.h"
+#include "BYGLocalization/Public/BYGStatusScanner.h"
+#include "BYGLocalization/Public/BYGStringPool.h"
+#include "BYGLocalization/Public/BYGTranslationMerge.h"
+#include "BYGLocalization/Public/BYGTextKey.h"
 
 #include "Editor/UnrealEd/Public/Tests/AutomationEditorCommon.h"
 #include "Developer/FunctionalTesting/Classes/FunctionalTestBase.h"
 #include "Core/Public/Misc/FileHelper.h"
 #include <Windows/WindowsPlatformProcess.h>
 #include <HAL/PlatformFilemanager.h>
+#include <HAL/FileManager.h>
 #include <BYGLocalizationSettings.h>
+#include <Internationalization/StringTableCore.h>
+#include <Internationalization/StringTableRegistry.h>
+#include <Serialization/Csv/CsvParser.h>
 
 	// Stuff to test:
 	// General CSV stuff
@@ -203,6 +217,13 @@ bool FBYGWriteCSVTest::RunTest( const FString& Parameters )
 
 		TestEqual( Pair.Key + " file contents", Output, Pair.Value.ExpectedOutput );
 
+		// Writing the same entries again should leave the file alone
+		bool bChanged = true;
+		TestTrue( Pair.Key + " second file write", Loc->WriteCSV( Pair.Value.Entries, FilenameWithPath, &bChanged ) );
+		TestFalse( Pair.Key + " unchanged file not rewritten", bChanged );
+		TestFalse( Pair.Key + " no temp file left behind", IFileManager::Get().FileExists( *( FilenameWithPath + TEXT( ".tmp" ) ) ) );
+
+		IFileManager::Get().Delete( *FilenameWithPath );
 		delete Loc;
 	}
 
@@ -222,9 +243,7 @@ bool FBYGFullLoopTest::RunTest( const FString& Parameters )
 	const TArray<FBYGLocalizationEntry> PrimaryEntries = {
 		{ "FirstKey", "Hello", "" }
 	};
-	const TMap<FString, int32> PrimaryKeyToIndex = {
-		{ "FirstKey", 0 },
-	};
+	const FBYGLocaleData PrimaryData( PrimaryEntries );
 
 	// TODO test this with the force and lazy quote system
 	// TODO newline \r\n may cause platform issues?
@@ -253,7 +272,7 @@ bool FBYGFullLoopTest::RunTest( const FString& Parameters )
 
 		for ( int32 i = 0; i < LoopCount; ++i )
 		{
-			const bool bSuccess = Loc->UpdateTranslationFile( FilenameWithPath, &PrimaryEntries, &PrimaryKeyToIndex );
+			const bool bSuccess = Loc->UpdateTranslationFile( FilenameWithPath, PrimaryData );
 			TestTrue( Pair.Key + " file write " + FilenameWithPath, bSuccess );
 
 			FString Output;
@@ -269,5 +288,1016 @@ bool FBYGFullLoopTest::RunTest( const FString& Parameters )
 }
 
 
-#endif
+IMPLEMENT_CUSTOM_SIMPLE_AUTOMATION_TEST( FBYGHeaderTest, FFunctionalTestBase, "BYG.Localization.Header", TestFlags )
+bool FBYGHeaderTest::RunTest( const FString& Parameters )
+{
+	// Column names are matched ignoring case, the same as when they were compared as FStrings
+	struct FData
+	{
+		const FString Header;
+		const bool bExpectValid;
+	};
+	const TMap<FString, FData> Data = {
+		{ "Exact", { "Key,SourceString,Comment,Primary,Status", true } },
+		{ "Lower case", { "key,sourcestring,comment,primary,status", true } },
+		{ "Upper case", { "KEY,SOURCESTRING,COMMENT,PRIMARY,STATUS", true } },
+		{ "Wrong key", { "Id,SourceString,Comment,Primary,Status", false } },
+		{ "Wrong source string", { "Key,Source,Comment,Primary,Status", false } },
+		{ "Swapped", { "SourceString,Key,Comment,Primary,Status", false } },
+	};
+
+	// Logged for each wrong header
+	AddExpectedError( TEXT( "in header must be" ), EAutomationExpectedErrorFlags::Contains, 0 );
+
+	UBYGLocalization* Loc = new UBYGLocalization();
+
+	for ( const auto& Pair : Data )
+	{
+		const FString FilenameWithPath = FPaths::CreateTempFilename( FPlatformProcess::UserTempDir(), TEXT( "BYGLocalizationTest" ), TEXT( ".csv" ) );
+		TestTrue( Pair.Key + " write file", FFileHelper::SaveStringToFile( Pair.Value.Header + "\r\nFirstKey,Salut,Just a comment,Hello,\r\n", *FilenameWithPath ) );
+
+		FBYGLocaleData LocaleData;
+		TestEqual( Pair.Key + " valid", Loc->GetLocalizationDataFromFile( FilenameWithPath, LocaleData ), Pair.Value.bExpectValid );
+		if ( Pair.Value.bExpectValid )
+		{
+			const TArray<FBYGLocalizationEntry>& Entries = *LocaleData.GetEntriesInOrder();
+			if ( TestEqual( Pair.Key + " entries", Entries.Num(), 1 ) )
+			{
+				TestEqual( Pair.Key + " translation", Entries[ 0 ].Translation, FString( "Salut" ) );
+				TestEqual( Pair.Key + " comment", Entries[ 0 ].Comment, FString( "Just a comment" ) );
+				TestEqual( Pair.Key + " primary", Entries[ 0 ].Primary, FString( "Hello" ) );
+			}
+		}
+
+		IFileManager::Get().Delete( *FilenameWithPath );
+	}
+
+	delete Loc;
+
+	return true;
+}
+
+
+IMPLEMENT_CUSTOM_SIMPLE_AUTOMATION_TEST( FBYGCompiledBlobTest, FFunctionalTestBase, "BYG.Localization.CompiledBlob", TestFlags )
+bool FBYGCompiledBlobTest::RunTest( const FString& Parameters )
+{
+	const FString Input = "Key,SourceString,Comment,Primary,Status\r\n"
+		"FirstKey,\"Salut, world\",\"Just a comment\",\"Hello, world\",\r\n"
+		"SecondKey,\"She said \"\"Hello\"\"\",,\"She said \"\"Hello\"\"\",New Entry\r\n"
+		"EmptyKey,,,Empty,\r\n";
+
+	const FString SourceFilename = FPaths::CreateTempFilename( FPlatformProcess::UserTempDir(), TEXT( "BYGLocalizationTest" ), TEXT( ".csv" ) );
+	const FString BlobFilename = FBYGLocalizationBlob::GetBlobFilename( SourceFilename );
+	TestTrue( "write source file", FFileHelper::SaveStringToFile( Input, *SourceFilename ) );
+	TestTrue( "compile", FBYGLocalizationBlob::Compile( SourceFilename, BlobFilename ) );
+
+	FBYGLocalizationBlob Blob;
+	TestTrue( "load", Blob.LoadFromFile( BlobFilename, SourceFilename ) );
+	TestEqual( "entry count", Blob.Num(), 3 );
+	TestEqual( "find", Blob.FindEntry( TEXT( "SecondKey" ) ), 1 );
+	TestEqual( "find is case-sensitive", Blob.FindEntry( TEXT( "secondkey" ) ), INDEX_NONE );
+	TestEqual( "missing key", Blob.FindEntry( TEXT( "ThirdKey" ) ), INDEX_NONE );
+
+	// Must match what the engine would have imported from the CSV
+	FStringTableRef Expected = FStringTable::NewStringTable();
+	Expected->ImportStrings( SourceFilename );
+	FStringTableRef Actual = Blob.CreateStringTable( TEXT( "Test" ) );
+
+	for ( const TCHAR* Key : { TEXT( "FirstKey" ), TEXT( "SecondKey" ), TEXT( "EmptyKey" ) } )
+	{
+		FString ExpectedString;
+		FString ActualString;
+		TestEqual( FString( Key ) + " exists", Actual->GetSourceString( Key, ActualString ), Expected->GetSourceString( Key, ExpectedString ) );
+		TestEqual( FString( Key ) + " source string", ActualString, ExpectedString );
+		for ( const TCHAR* MetaData : { TEXT( "Comment" ), TEXT( "Primary" ), TEXT( "Status" ) } )
+		{
+			TestEqual( FString( Key ) + " " + MetaData, Actual->GetMetaData( Key, MetaData ), Expected->GetMetaData( Key, MetaData ) );
+		}
+	}
+
+	// Untranslated keys can use the Primary column instead
+	FStringTableRef WithFallback = Blob.CreateStringTable( TEXT( "Test" ), true );
+	FString FallbackString;
+	TestTrue( "untranslated key uses primary", WithFallback->GetSourceString( TEXT( "EmptyKey" ), FallbackString ) );
+	TestEqual( "untranslated key primary text", FallbackString, FString( "Empty" ) );
+	TestTrue( "translated key keeps translation", WithFallback->GetSourceString( TEXT( "FirstKey" ), FallbackString ) );
+	TestEqual( "translated key text", FallbackString, FString( "Salut, world" ) );
+
+	// Changing the CSV must invalidate the compiled file
+	TestTrue( "modify source file", FFileHelper::SaveStringToFile( Input + "ThirdKey,Third,,,\r\n", *SourceFilename ) );
+	FBYGLocalizationBlob StaleBlob;
+	TestFalse( "stale blob is rejected", StaleBlob.LoadFromFile( BlobFilename, SourceFilename ) );
+
+	IFileManager::Get().Delete( *SourceFilename );
+	IFileManager::Get().Delete( *BlobFilename );
+
+	return true;
+}
+
+
+IMPLEMENT_CUSTOM_SIMPLE_AUTOMATION_TEST( FBYGCsvReaderTest, FFunctionalTestBase, "BYG.Localization.CsvReader", TestFlags )
+bool FBYGCsvReaderTest::RunTest( const FString& Parameters )
+{
+	// Rows must come out the same as FCsvParser, however the input is split into chunks
+	const TMap<FString, FString> Data = {
+		{ "Simple", "Key,SourceString,Comment,Primary,Status\r\nHello,World,,Hello,\r\n" },
+		{ "BOM", TEXT( "\uFEFFKey,SourceString\r\nHello,World\r\n" ) },
+		{ "Quotes", "Key,SourceString\r\nHello,\"Salut, \"\"world\"\"\"\r\n" },
+		{ "Newline in quotes", "Key,SourceString\nHello,\"Salut,\r\n world\",\n" },
+		{ "Blank lines", "Key,SourceString\r\n\r\n\r\nHello,World\r\n\r\n" },
+		{ "No trailing newline", "Key,SourceString\rHello,World," },
+		{ "Non-ascii", TEXT( "Key,SourceString\r\nHello,\"Pr\u00EAt \u00E0 partir, \u65E5\u672C\"\r\n" ) },
+	};
+
+	for ( const auto& Pair : Data )
+	{
+		const FCsvParser Parser( Pair.Value.Replace( TEXT( "\uFEFF" ), TEXT( "" ) ) );
+		const FCsvParser::FRows& ExpectedRows = Parser.GetRows();
+
+		const FTCHARToUTF8 UTF8( *Pair.Value, Pair.Value.Len() );
+		for ( const int32 ChunkSize : { 1, 2, 3, 7, 4096 } )
+		{
+			TArray<TArray<FString>> Rows;
+			FBYGCsvReader Reader;
+			auto Callback = [&Rows]( const FBYGCsvRow& Row )
+			{
+				TArray<FString>& Cells = Rows.AddDefaulted_GetRef();
+				for ( int32 Cell = 0; Cell < Row.Num(); ++Cell )
+				{
+					Cells.Add( Row.GetString( Cell ) );
+				}
+				return true;
+			};
+			for ( int32 Offset = 0; Offset < UTF8.Length(); Offset += ChunkSize )
+			{
+				Reader.Parse( (const UTF8CHAR*)UTF8.Get() + Offset, FMath::Min( ChunkSize, UTF8.Length() - Offset ), Callback );
+			}
+			Reader.Finish( Callback );
+
+			const FString Name = FString::Printf( TEXT( "%s (chunks of %d)" ), *Pair.Key, ChunkSize );
+			TestEqual( Name + " row count", Rows.Num(), ExpectedRows.Num() );
+			for ( int32 RowIndex = 0; RowIndex < FMath::Min( Rows.Num(), ExpectedRows.Num() ); ++RowIndex )
+			{
+				TestEqual( Name + " cell count", Rows[ RowIndex ].Num(), ExpectedRows[ RowIndex ].Num() );
+				for ( int32 Cell = 0; Cell < FMath::Min( Rows[ RowIndex ].Num(), ExpectedRows[ RowIndex ].Num() ); ++Cell )
+				{
+					TestEqual( Name + " cell", Rows[ RowIndex ][ Cell ], FString( ExpectedRows[ RowIndex ][ Cell ] ) );
+				}
+			}
+		}
+	}
+
+	return true;
+}
+
+
+IMPLEMENT_CUSTOM_SIMPLE_AUTOMATION_TEST( FBYGCsvVectorScanTest, FFunctionalTestBase, "BYG.Localization.CsvVectorScan", TestFlags )
+bool FBYGCsvVectorScanTest::RunTest( const FString& Parameters )
+{
+	if ( !FBYGCsvReader::HasVectorScan() )
+	{
+		AddInfo( TEXT( "No vector scan on this platform, comparing scalar against itself" ) );
+	}
+
+	// Fixed seed so failures can be reproduced
+	FRandomStream Random( 4657 );
+
+	// Mostly text with a few of the characters being looked for, plus bytes above 127 since those are negative as
+	// signed 8-bit lanes
+	auto MakeBytes = [&Random]( int32 Num, float SpecialChance )
+	{
+		const UTF8CHAR Special[] = { '"', ',', '\r', '\n' };
+		TArray<UTF8CHAR> Bytes;
+		Bytes.SetNumUninitialized( Num );
+		for ( UTF8CHAR& Byte : Bytes )
+		{
+			Byte = Random.FRand() < SpecialChance
+				? Special[ Random.RandRange( 0, (int32)UE_ARRAY_COUNT( Special ) - 1 ) ]
+				: (UTF8CHAR)( Random.RandRange( 0, 1 ) == 1 ? Random.RandRange( 'a', 'z' ) : Random.RandRange( 0x80, 0xFF ) );
+		}
+		return Bytes;
+	};
+
+	// Every start alignment and every length up to a few vector blocks, so matches land in each lane and in the tail
+	int32 NumMismatches = 0;
+	for ( const float SpecialChance : { 0.0f, 0.01f, 0.05f, 0.3f } )
+	{
+		const TArray<UTF8CHAR> Bytes = MakeBytes( 256, SpecialChance );
+		for ( int32 Offset = 0; Offset < 64; ++Offset )
+		{
+			for ( int32 Num = 0; Num <= Bytes.Num() - Offset; ++Num )
+			{
+				for ( const bool bInQuotes : { false, true } )
+				{
+					const int64 Scalar = FBYGCsvReader::FindSpecialCharScalar( Bytes.GetData() + Offset, Num, bInQuotes );
+					const int64 Vector = FBYGCsvReader::FindSpecialCharVector( Bytes.GetData() + Offset, Num, bInQuotes );
+					if ( Scalar != Vector && NumMismatches++ == 0 )
+					{
+						AddError( FString::Printf( TEXT( "FindSpecialChar differs at offset %d, length %d, %s quotes: scalar %lld, vector %lld" ),
+							Offset, Num, bInQuotes ? TEXT( "in" ) : TEXT( "not in" ), Scalar, Vector ) );
+					}
+				}
+			}
+		}
+	}
+	TestEqual( "FindSpecialChar mismatches", NumMismatches, 0 );
+
+	// A file with long quoted cells holding commas, "" and CRLF, so vector blocks span them
+	FString CSV;
+	for ( int32 Row = 0; Row < 40; ++Row )
+	{
+		for ( int32 Cell = 0; Cell < 4; ++Cell )
+		{
+			if ( Cell > 0 )
+			{
+				CSV += TEXT( "," );
+			}
+			const int32 Length = Random.RandRange( 0, 70 );
+			if ( Random.RandRange( 0, 1 ) == 1 )
+			{
+				CSV += TEXT( "\"" );
+				for ( int32 i = 0; i < Length; ++i )
+				{
+					const TCHAR* Specials[] = { TEXT( "\"\"" ), TEXT( "\r\n" ), TEXT( "," ), TEXT( "\u00E9" ) };
+					const int32 Pick = Random.RandRange( 0, 19 );
+					if ( Pick < (int32)UE_ARRAY_COUNT( Specials ) )
+					{
+						CSV += Specials[ Pick ];
+					}
+					else
+					{
+						CSV.AppendChar( (TCHAR)Random.RandRange( 'a', 'z' ) );
+					}
+				}
+				CSV += TEXT( "\"" );
+			}
+			else
+			{
+				for ( int32 i = 0; i < Length; ++i )
+				{
+					CSV.AppendChar( Random.RandRange( 0, 9 ) == 0 ? TEXT( '\u00E9' ) : (TCHAR)Random.RandRange( 'a', 'z' ) );
+				}
+			}
+		}
+		const int32 LineEnd = Random.RandRange( 0, 3 );
+		CSV += LineEnd == 0 ? TEXT( "\n" ) : LineEnd == 1 ? TEXT( "\r" ) : TEXT( "\r\n" );
+	}
+	const FTCHARToUTF8 UTF8( *CSV, CSV.Len() );
+	const UTF8CHAR* Data = (const UTF8CHAR*)UTF8.Get();
+	const int32 Num = UTF8.Length();
+
+	// Feeds Data split at each of Splits, copied to Offset bytes past an aligned buffer
+	auto ReadRows = [Data, Num]( bool bUseVectorScan, int32 Offset, TArrayView<const int32> Splits )
+	{
+		TArray<UTF8CHAR> Buffer;
+		Buffer.SetNumZeroed( Num + 64 );
+		FMemory::Memcpy( Buffer.GetData() + Offset, Data, Num );
+
+		TArray<TArray<FString>> Rows;
+		FBYGCsvReader Reader;
+		Reader.SetUseVectorScan( bUseVectorScan );
+		auto Callback = [&Rows]( const FBYGCsvRow& Row )
+		{
+			TArray<FString>& Cells = Rows.AddDefaulted_GetRef();
+			for ( int32 Cell = 0; Cell < Row.Num(); ++Cell )
+			{
+				Cells.Add( Row.GetString( Cell ) );
+			}
+			return true;
+		};
+		int32 Start = 0;
+		for ( const int32 Split : Splits )
+		{
+			Reader.Parse( Buffer.GetData() + Offset + Start, Split - Start, Callback );
+			Start = Split;
+		}
+		Reader.Parse( Buffer.GetData() + Offset + Start, Num - Start, Callback );
+		Reader.Finish( Callback );
+		return Rows;
+	};
+
+	const TArray<TArray<FString>> Expected = ReadRows( false, 0, {} );
+	TestEqual( "row count", Expected.Num(), 40 );
+
+	for ( int32 Offset = 0; Offset < 64; ++Offset )
+	{
+		TestTrue( FString::Printf( TEXT( "rows at offset %d" ), Offset ), ReadRows( true, Offset, {} ) == Expected );
+	}
+
+	// Split at every byte, which includes inside quoted cells, between "" and between \r and \n
+	int32 NumSplitsInQuotes = 0;
+	int32 NumSplitsInCRLF = 0;
+	int32 NumSplitMismatches = 0;
+	bool bInQuotes = false;
+	for ( int32 Split = 1; Split < Num; ++Split )
+	{
+		bInQuotes ^= Data[ Split - 1 ] == '"';
+		NumSplitsInQuotes += bInQuotes ? 1 : 0;
+		NumSplitsInCRLF += Data[ Split - 1 ] == '\r' && Data[ Split ] == '\n' ? 1 : 0;
+
+		const int32 Splits[] = { Split };
+		if ( ReadRows( true, Split % 32, Splits ) != Expected && NumSplitMismatches++ == 0 )
+		{
+			AddError( FString::Printf( TEXT( "Rows differ when split at byte %d" ), Split ) );
+		}
+	}
+	TestTrue( "split inside quotes", NumSplitsInQuotes > 0 );
+	TestTrue( "split inside CRLF", NumSplitsInCRLF > 0 );
+	TestEqual( "split mismatches", NumSplitMismatches, 0 );
+
+	// Chunks of every size up to a few blocks, so chunk ends fall at every position relative to vector blocks
+	for ( int32 ChunkSize = 1; ChunkSize <= 70; ++ChunkSize )
+	{
+		TArray<int32> Splits;
+		for ( int32 Split = ChunkSize; Split < Num; Split += ChunkSize )
+		{
+			Splits.Add( Split );
+		}
+		TestTrue( FString::Printf( TEXT( "rows in chunks of %d" ), ChunkSize ), ReadRows( true, 0, Splits ) == Expected );
+	}
+
+	return true;
+}
+
+
+IMPLEMENT_CUSTOM_SIMPLE_AUTOMATION_TEST( FBYGKeyIndexTest, FFunctionalTestBase, "BYG.Localization.KeyIndex", TestFlags )
+bool FBYGKeyIndexTest::RunTest( const FString& Parameters )
+{
+	const TArray<FBYGLocalizationEntry> Entries = {
+		{ "FirstKey", "First", "" },
+		{ "SecondKey", "Second", "" },
+		{ "firstkey", "Duplicate", "" },
+		{ "", "Dummy", "" },
+	};
+
+	TArray<int32> Duplicates;
+	FBYGKeyIndex Index;
+	Index.Build( Entries, &Duplicates );
+
+	TestEqual( "num keys", Index.Num(), 3 );
+	TestTrue( "duplicates", Duplicates == TArray<int32>{ 2 } );
+	TestEqual( "first key", Index.Find( TEXT( "FirstKey" ), Entries ).Get( INDEX_NONE ), 0 );
+	TestEqual( "case-insensitive", Index.Find( TEXT( "SECONDKEY" ), Entries ).Get( INDEX_NONE ), 1 );
+	TestEqual( "empty key", Index.Find( TEXT( "" ), Entries ).Get( INDEX_NONE ), 3 );
+	TestFalse( "missing key", Index.Find( TEXT( "ThirdKey" ), Entries ).IsSet() );
+	TestEqual( "by hash", Index.FindByHash( Index.GetKeyHash( 1 ), TEXT( "SecondKey" ), Entries ).Get( INDEX_NONE ), 1 );
+
+	return true;
+}
+
+
+IMPLEMENT_CUSTOM_SIMPLE_AUTOMATION_TEST( FBYGGameTextCacheTest, FFunctionalTestBase, "BYG.Localization.GameTextCache", TestFlags )
+bool FBYGGameTextCacheTest::RunTest( const FString& Parameters )
+{
+	const FString TableName = UBYGLocalizationSettings::Get()->StringtableID;
+	const FName TableID( *TableName );
+	const FStringTableConstPtr PreviousTable = FStringTableRegistry::Get().FindStringTable( TableID );
+
+	FStringTableRef StringTable = FStringTable::NewStringTable();
+	StringTable->SetNamespace( TableName );
+	StringTable->SetSourceString( TEXT( "Hello_World" ), TEXT( "Salut world" ) );
+	FStringTableRegistry::Get().UnregisterStringTable( TableID );
+	FStringTableRegistry::Get().RegisterStringTable( TableID, StringTable );
+	FBYGLocalizationModule::NotifyStringTablesChanged();
+
+	TestEqual( "first lookup", UBYGLocalizationStatics::GetGameText( "Hello_World" ).ToString(), FString( "Salut world" ) );
+	TestEqual( "cached lookup", UBYGLocalizationStatics::GetGameText( "Hello_World" ).ToString(), FString( "Salut world" ) );
+	const FBYGTextKey TextKey( "Hello_World" );
+	TestEqual( "text key", TextKey.GetText().ToString(), FString( "Salut world" ) );
+	TestEqual( "text key with category", FBYGTextKey( "Hello_World", TableName ).GetText().ToString(), FString( "Salut world" ) );
+
+	// Keys are case-sensitive in string tables, so the cache mustn't answer for a key in another case, whichever was
+	// looked up first
+	TestNotEqual( "other case", UBYGLocalizationStatics::GetGameText( "hello_world" ).ToString(), FString( "Salut world" ) );
+	TestEqual( "after other case", UBYGLocalizationStatics::GetGameText( "Hello_World" ).ToString(), FString( "Salut world" ) );
+	TestNotEqual( "other case after", UBYGLocalizationStatics::GetGameText( "HELLO_WORLD" ).ToString(), FString( "Salut world" ) );
+	TestNotEqual( "other case text key", FBYGTextKey( "hello_world" ).GetText().ToString(), FString( "Salut world" ) );
+
+	// Edits made through the statics must not be hidden by the cache
+	UBYGLocalizationStatics::UpdateLocalizationSourceString( TableName, "Hello_World", "Bonjour world" );
+	TestEqual( "updated key", UBYGLocalizationStatics::GetGameText( "Hello_World" ).ToString(), FString( "Bonjour world" ) );
+	TestEqual( "updated text key", TextKey.GetText().ToString(), FString( "Bonjour world" ) );
+	UBYGLocalizationStatics::AddNewEntryToTheLocalization( TableName, "New_Key", "New text", "" );
+	TestEqual( "added key", UBYGLocalizationStatics::GetGameText( "New_Key" ).ToString(), FString( "New text" ) );
+
+	// Repeated keys are only looked up once, missing ones are reported through the mask
+	TArray<FText> Texts;
+	TArray<int32> MissingKeys;
+	const int32 NumMissing = UBYGLocalizationStatics::GetGameTexts( { "Hello_World", "Missing_Key", "New_Key", "Hello_World" }, Texts, MissingKeys, TableName );
+	TestEqual( "batch num missing", NumMissing, 1 );
+	TestEqual( "batch num texts", Texts.Num(), 4 );
+	TestEqual( "batch mask", MissingKeys.Num(), 1 );
+	TestEqual( "batch first", Texts[ 0 ].ToString(), FString( "Bonjour world" ) );
+	TestEqual( "batch missing", Texts[ 1 ].ToString(), FString( "(KNF:Missing_Key)" ) );
+	TestEqual( "batch added", Texts[ 2 ].ToString(), FString( "New text" ) );
+	TestEqual( "batch repeated", Texts[ 3 ].ToString(), FString( "Bonjour world" ) );
+	TestFalse( "batch first found", UBYGLocalizationStatics::IsGameTextMissing( MissingKeys, 0 ) );
+	TestTrue( "batch missing not found", UBYGLocalizationStatics::IsGameTextMissing( MissingKeys, 1 ) );
+	TestFalse( "batch repeated found", UBYGLocalizationStatics::IsGameTextMissing( MissingKeys, 3 ) );
+
+	FStringTableRegistry::Get().UnregisterStringTable( TableID );
+	if ( PreviousTable.IsValid() )
+	{
+		FStringTableRegistry::Get().RegisterStringTable( TableID, ConstCastSharedRef<FStringTable>( PreviousTable.ToSharedRef() ) );
+	}
+	FBYGLocalizationModule::NotifyStringTablesChanged();
+
+	return true;
+}
+
+
+IMPLEMENT_CUSTOM_SIMPLE_AUTOMATION_TEST( FBYGPseudoLocalizationTest, FFunctionalTestBase, "BYG.Localization.PseudoLocalization", TestFlags )
+bool FBYGPseudoLocalizationTest::RunTest( const FString& Parameters )
+{
+	const FBYGPseudoLocalizer Default;
+	TestEqual( "vowels repeated", Default.Localize( TEXT( "Hello" ) ), FString( "[Heelloo~]" ) );
+	TestEqual( "no vowels", Default.Localize( TEXT( "Rhythm" ) ), FString( "[Rhythm~~~]" ) );
+	TestEqual( "empty", Default.Localize( TEXT( "" ) ), FString( "[]" ) );
+	TestEqual( "tags", Default.Localize( TEXT( "<b>Hi</b>" ) ), FString( "[<b>Hii</b>]" ) );
+	TestEqual( "arguments", Default.Localize( TEXT( "{Count} |plural(one=item,other=items)" ) ), FString( "[{Count} |plural(one=item,other=items)~]" ) );
+	TestEqual( "unclosed tag", Default.Localize( TEXT( "a<b" ) ), FString( "[a<b~~]" ) );
+
+	FBYGPseudoLocalizationOptions Options;
+	Options.ExpansionRatio = 1.0f;
+	Options.bAccents = true;
+	Options.bBrackets = false;
+	const FBYGPseudoLocalizer Accented( Options );
+	TestEqual( "accents", Accented.Localize( TEXT( "Az <b>z</b>!" ) ), FString( TEXT( "\u00C5\u017E <b>\u017E</b>!" ) ) );
+
+	Options.ExpansionRatio = 3.0f;
+	Options.bAccents = false;
+	const FBYGPseudoLocalizer Long( Options );
+	const FString Sentence = TEXT( "The quick brown fox jumps over the lazy dog" );
+	TestEqual( "expansion", Long.Localize( Sentence ).Len(), Sentence.Len() * 3 );
+
+	return true;
+}
+
+
+IMPLEMENT_CUSTOM_SIMPLE_AUTOMATION_TEST( FBYGVirtualLocaleTest, FFunctionalTestBase, "BYG.Localization.VirtualLocale", TestFlags )
+bool FBYGVirtualLocaleTest::RunTest( const FString& Parameters )
+{
+	const FString TableName = "BYGVirtualLocaleTest";
+	const FName TableID( *TableName );
+
+	FStringTableRef StringTable = FStringTable::NewStringTable();
+	StringTable->SetNamespace( TableName );
+	StringTable->SetSourceString( TEXT( "Hello_World" ), TEXT( "Hello world" ) );
+	FBYGPreparedStringTable Source;
+	Source.TableID = TableID;
+	Source.StringTable = StringTable;
+
+	// Counts how often text is made, it should only happen once per key
+	TSharedRef<int32, ESPMode::ThreadSafe> NumTransformed = MakeShared<int32, ESPMode::ThreadSafe>( 0 );
+	const FBYGPreparedStringTable Virtual = FBYGLocalizationModule::MakeVirtualStringTable( Source, MakeShared<FBYGVirtualLocaleTransform, ESPMode::ThreadSafe>(
+		[NumTransformed]( FStringView SourceString, FString& OutString )
+		{
+			++( *NumTransformed );
+			OutString = FString( SourceString ).ToUpper();
+		} ) );
+	TestEqual( "made once", *NumTransformed, 1 );
+	TestEqual( "source untouched", *StringTable->FindEntry( TEXT( "Hello_World" ) )->GetDisplayString(), FString( "Hello world" ) );
+
+	FBYGLocalizationModule& Module = FBYGLocalizationModule::Get();
+	Module.RegisterStringTable( Virtual );
+	TestTrue( "is virtual", Module.FindVirtualTable( TableID ).IsValid() );
 
+	// FText properties read the registered table, so it has to have the virtual text too
+	const FStringTableConstPtr Registered = FStringTableRegistry::Get().FindStringTable( TableID );
+	TestTrue( "registered", Registered.IsValid() && Registered->FindEntry( TEXT( "Hello_World" ) ).IsValid() );
+	if ( Registered.IsValid() && Registered->FindEntry( TEXT( "Hello_World" ) ).IsValid() )
+	{
+		TestEqual( "registered text", *Registered->FindEntry( TEXT( "Hello_World" ) )->GetDisplayString(), FString( "HELLO WORLD" ) );
+	}
+	TestEqual( "same namespace", Registered.IsValid() ? Registered->GetNamespace() : FString(), TableName );
+	TestEqual( "from a text reference", FText::FromStringTable( TableID, TEXT( "Hello_World" ) ).ToString(), FString( "HELLO WORLD" ) );
+
+	TestTrue( "has key", UBYGLocalizationStatics::HasTextInTable( TableName, "Hello_World" ) );
+	TestFalse( "missing key", UBYGLocalizationStatics::HasTextInTable( TableName, "Missing_Key" ) );
+	TestEqual( "transformed", UBYGLocalizationStatics::GetTextFromKey( FBYGTextKey( "Hello_World", TableName ) ).ToString(), FString( "HELLO WORLD" ) );
+	TestEqual( "not made again", *NumTransformed, 1 );
+
+	Module.UnloadStringTable( TableID );
+	TestFalse( "unloaded", Module.FindVirtualTable( TableID ).IsValid() );
+
+	Module.RegisterVirtualLocale( "BYGVirtualLocaleTest", []( FStringView SourceString, FString& OutString ) { OutString = FString( SourceString ); } );
+	TestTrue( "registered", Module.IsVirtualLocale( "BYGVirtualLocaleTest" ) );
+	Module.UnregisterVirtualLocale( "BYGVirtualLocaleTest" );
+	TestFalse( "unregistered", Module.IsVirtualLocale( "BYGVirtualLocaleTest" ) );
+
+	return true;
+}
+
+
+IMPLEMENT_CUSTOM_SIMPLE_AUTOMATION_TEST( FBYGTranslationMergeTest, FFunctionalTestBase, "BYG.Localization.TranslationMerge", TestFlags )
+bool FBYGTranslationMergeTest::RunTest( const FString& Parameters )
+{
+	const FBYGLocaleData PrimaryData( TArray<FBYGLocalizationEntry>{
+		{ "FirstKey", "Hello", "First comment" },
+		{ "SecondKey", "Goodbye", "Second comment" },
+	} );
+
+	TArray<FBYGLocalizationEntry> FrenchEntries = {
+		{ "OldKey", "Vieux", "" },
+		{ "FirstKey", "Salut", "" },
+	};
+	FrenchEntries[ 1 ].Primary = "Hello";
+	FBYGLocaleData FrenchData( MoveTemp( FrenchEntries ) );
+	FBYGLocaleData DebugData;
+
+	const FBYGTranslationMergePolicy TranslationPolicy;
+	const FBYGPseudoLocalizationMergePolicy DebugPolicy( FBYGPseudoLocalizationOptions{} );
+	TArray<FBYGMergeTarget> Targets;
+	Targets.SetNum( 2 );
+	Targets[ 0 ].Data = &FrenchData;
+	Targets[ 0 ].Policy = &TranslationPolicy;
+	Targets[ 0 ].CultureName = "fr";
+	Targets[ 1 ].Data = &DebugData;
+	Targets[ 1 ].Policy = &DebugPolicy;
+	Targets[ 1 ].CultureName = "Debug";
+	FBYGTranslationMerge::Merge( PrimaryData, Targets );
+
+	const TArray<FBYGLocalizationEntry>& French = Targets[ 0 ].Entries;
+	TestEqual( "french rows", French.Num(), 3 );
+	TestEqual( "french kept", French[ 0 ].Translation, FString( "Salut" ) );
+	TestEqual( "french comment", French[ 0 ].Comment, FString( "First comment" ) );
+	TestEqual( "french added", French[ 1 ].Translation, FString( "Goodbye" ) );
+	TestTrue( "french added status", French[ 1 ].Status == EBYGLocEntryStatus::New );
+	TestEqual( "french deprecated", French[ 2 ].Key, FString( "OldKey" ) );
+	TestTrue( "french deprecated status", French[ 2 ].Status == EBYGLocEntryStatus::Deprecated );
+
+	const TArray<FBYGLocalizationEntry>& Debug = Targets[ 1 ].Entries;
+	TestEqual( "debug rows", Debug.Num(), 2 );
+	TestEqual( "debug first", Debug[ 0 ].Translation, FBYGPseudoLocalizer().Localize( TEXT( "Hello" ) ) );
+	TestEqual( "debug second", Debug[ 1 ].Translation, FBYGPseudoLocalizer().Localize( TEXT( "Goodbye" ) ) );
+
+	return true;
+}
+
+IMPLEMENT_CUSTOM_SIMPLE_AUTOMATION_TEST( FBYGTranslationMergeDuplicatesTest, FFunctionalTestBase, "BYG.Localization.TranslationMergeDuplicates", TestFlags )
+bool FBYGTranslationMergeDuplicatesTest::RunTest( const FString& Parameters )
+{
+	// Rows are moved out of the translation as they're merged, a repeated primary key still gets the translation
+	const FBYGLocaleData PrimaryData( TArray<FBYGLocalizationEntry>{
+		{ "FirstKey", "Hello", "" },
+		{ "SecondKey", "Goodbye", "" },
+		{ "FirstKey", "Hello", "" },
+	} );
+
+	TArray<FBYGLocalizationEntry> FrenchEntries = {
+		{ "FirstKey", "Salut", "" },
+		{ "SecondKey", "Au revoir", "" },
+	};
+	FrenchEntries[ 0 ].Primary = "Hello";
+	FrenchEntries[ 1 ].Primary = "Bye";
+	FBYGLocaleData FrenchData( MoveTemp( FrenchEntries ) );
+
+	const FBYGTranslationMergePolicy Policy;
+	FBYGMergeTarget Target;
+	Target.Data = &FrenchData;
+	Target.Policy = &Policy;
+	Target.CultureName = "fr";
+	FBYGTranslationMerge::Merge( PrimaryData, MakeArrayView( &Target, 1 ) );
+
+	TestEqual( "rows", Target.Entries.Num(), 3 );
+	TestEqual( "first", Target.Entries[ 0 ].Translation, FString( "Salut" ) );
+	TestEqual( "repeated", Target.Entries[ 2 ].Translation, FString( "Salut" ) );
+	TestEqual( "modified kept", Target.Entries[ 1 ].Translation, FString( "Au revoir" ) );
+	TestTrue( "modified status", Target.Entries[ 1 ].Status == EBYGLocEntryStatus::Modified );
+	TestEqual( "modified was", Target.Entries[ 1 ].OldPrimary, FString( "Bye" ) );
+	TestEqual( "modified now", Target.Entries[ 1 ].Primary, FString( "Goodbye" ) );
+
+	return true;
+}
+
+IMPLEMENT_CUSTOM_SIMPLE_AUTOMATION_TEST( FBYGStringPoolTest, FFunctionalTestBase, "BYG.Localization.StringPool", TestFlags )
+bool FBYGStringPoolTest::RunTest( const FString& Parameters )
+{
+	FBYGStringPool Pool;
+	const FString Hello = "Hello";
+	const int32 HelloId = Pool.Add( Hello );
+	TestNotEqual( "added", HelloId, (int32)INDEX_NONE );
+	TestEqual( "added once", Pool.Add( FString( "Hello" ) ), HelloId );
+	TestEqual( "found", Pool.Find( TEXT( "Hello" ) ), HelloId );
+	TestEqual( "case-sensitive", Pool.Find( TEXT( "hello" ) ), (int32)INDEX_NONE );
+	TestEqual( "empty", Pool.Add( FString() ), (int32)INDEX_NONE );
+	TestEqual( "text", Pool.Get( HelloId ), Hello );
+
+	// Enough to grow the table a few times
+	for ( int32 i = 0; i < 1000; ++i )
+	{
+		Pool.Add( FString::Printf( TEXT( "String %d" ), i ) );
+	}
+	TestEqual( "count", Pool.Num(), 1001 );
+	TestEqual( "found after growing", Pool.Find( TEXT( "String 500" ) ), Pool.Add( FString( "String 500" ) ) );
+	TestEqual( "kept after growing", Pool.Find( TEXT( "Hello" ) ), HelloId );
+
+	return true;
+}
+
+IMPLEMENT_CUSTOM_SIMPLE_AUTOMATION_TEST( FBYGTranslationMergePooledTest, FFunctionalTestBase, "BYG.Localization.TranslationMergePooled", TestFlags )
+bool FBYGTranslationMergePooledTest::RunTest( const FString& Parameters )
+{
+	// Pooling the text changes how rows are stored but not what they say
+	FBYGLocaleData PrimaryData( TArray<FBYGLocalizationEntry>{
+		{ "FirstKey", "Hello", "Greeting" },
+		{ "SecondKey", "Goodbye", "Greeting" },
+		{ "ThirdKey", "Thanks", "" },
+	} );
+	FBYGStringPool Pool;
+	FBYGTranslationMerge::PoolPrimary( PrimaryData, Pool );
+	TestEqual( "comment shared", ( *PrimaryData.GetEntriesInOrder() )[ 0 ].CommentId, ( *PrimaryData.GetEntriesInOrder() )[ 1 ].CommentId );
+
+	TArray<FBYGLocalizationEntry> FrenchEntries = {
+		{ "FirstKey", "Salut", "Greeting" },
+		{ "SecondKey", "Au revoir", "" },
+	};
+	FrenchEntries[ 0 ].Primary = "Hello";
+	FrenchEntries[ 1 ].Primary = "Bye";
+	FBYGLocaleData FrenchData( MoveTemp( FrenchEntries ) );
+	FBYGTranslationMerge::PoolTarget( FrenchData, Pool );
+	TestTrue( "primary pooled", ( *FrenchData.GetEntriesInOrder() )[ 0 ].Primary.IsEmpty() );
+
+	const FBYGTranslationMergePolicy Policy( &Pool );
+	FBYGMergeTarget Target;
+	Target.Data = &FrenchData;
+	Target.Policy = &Policy;
+	Target.CultureName = "fr";
+	FBYGTranslationMerge::Merge( PrimaryData, MakeArrayView( &Target, 1 ) );
+
+	const TArray<FBYGLocalizationEntry>& French = Target.Entries;
+	TestEqual( "rows", French.Num(), 3 );
+	TestEqual( "kept", French[ 0 ].Translation, FString( "Salut" ) );
+	TestTrue( "unchanged status", French[ 0 ].Status == EBYGLocEntryStatus::None );
+	TestEqual( "primary", French[ 0 ].GetPrimary( &Pool ), FString( "Hello" ) );
+	TestEqual( "comment", French[ 0 ].GetComment( &Pool ), FString( "Greeting" ) );
+	TestTrue( "modified status", French[ 1 ].Status == EBYGLocEntryStatus::Modified );
+	TestEqual( "modified was", French[ 1 ].OldPrimary, FString( "Bye" ) );
+	TestEqual( "modified now", French[ 1 ].GetPrimary( &Pool ), FString( "Goodbye" ) );
+	TestTrue( "added status", French[ 2 ].Status == EBYGLocEntryStatus::New );
+	TestEqual( "added", French[ 2 ].Translation, FString( "Thanks" ) );
+	TestEqual( "added comment", French[ 2 ].GetComment( &Pool ), FString() );
+
+	return true;
+}
+
+IMPLEMENT_CUSTOM_SIMPLE_AUTOMATION_TEST( FBYGCsvWriterTest, FFunctionalTestBase, "BYG.Localization.CsvWriter", TestFlags )
+bool FBYGCsvWriterTest::RunTest( const FString& Parameters )
+{
+	auto Write = []( bool bForceQuoted, const TArray<FString>& Cells )
+	{
+		FBYGCsvWriter Writer( bForceQuoted );
+		Writer.AddCell( Cells[ 0 ], false );
+		for ( int32 i = 1; i < Cells.Num(); ++i )
+		{
+			Writer.AddCell( Cells[ i ] );
+		}
+		Writer.EndRow();
+		return FString( Writer.GetOutput().Num(), (const UTF8CHAR*)Writer.GetOutput().GetData() );
+	};
+
+	TestEqual( "plain", Write( false, { "Key", "Hello", "", "Hello" } ), FString( TEXT( "Key,Hello,,Hello" ) LINE_TERMINATOR ) );
+	TestEqual( "comma", Write( false, { "Key", "Hello, world" } ), FString( TEXT( "Key,\"Hello, world\"" ) LINE_TERMINATOR ) );
+	TestEqual( "quotes", Write( false, { "Key", "Say \"hi\"" } ), FString( TEXT( "Key,\"Say \"\"hi\"\"\"" ) LINE_TERMINATOR ) );
+	TestEqual( "newline", Write( false, { "Key", "Two\nlines" } ), FString( TEXT( "Key,\"Two\nlines\"" ) LINE_TERMINATOR ) );
+	TestEqual( "key never quoted", Write( true, { "My \"Key\"", "Hello" } ), FString( TEXT( "My \"\"Key\"\",\"Hello\"" ) LINE_TERMINATOR ) );
+	TestEqual( "forced, empty", Write( true, { "Key", "", "Hello" } ), FString( TEXT( "Key,,\"Hello\"" ) LINE_TERMINATOR ) );
+	TestEqual( "not ascii", Write( false, { "Key", TEXT( "Caf\u00e9 \"\u00fcber\"" ) } ), FString( TEXT( "Key,\"Caf\u00e9 \"\"\u00fcber\"\"\"" ) LINE_TERMINATOR ) );
+
+	// The same bytes as converting the whole line at once
+	const FString Line = FString( TEXT( "Key,\"\u3053\u3093\u306b\u3061\u306f, \U0001F600\"" ) ) + LINE_TERMINATOR;
+	const FTCHARToUTF8 Expected( *Line );
+	FBYGCsvWriter Writer;
+	Writer.AddCell( TEXT( "Key" ), false );
+	Writer.AddCell( TEXT( "\u3053\u3093\u306b\u3061\u306f, \U0001F600" ) );
+	Writer.EndRow();
+	TestTrue( "utf-8", Writer.GetOutput().Num() == Expected.Length() && FMemory::Memcmp( Writer.GetOutput().GetData(), Expected.Get(), Expected.Length() ) == 0 );
+
+	return true;
+}
+
+IMPLEMENT_CUSTOM_SIMPLE_AUTOMATION_TEST( FBYGExportStringsTest, FFunctionalTestBase, "BYG.Localization.ExportStrings", TestFlags )
+bool FBYGExportStringsTest::RunTest( const FString& Parameters )
+{
+	const FName TableID( TEXT( "BYGExportStringsTest" ) );
+	FStringTableRef StringTable = FStringTable::NewStringTable();
+	StringTable->SetNamespace( TableID.ToString() );
+	StringTable->SetSourceString( TEXT( "Hello_World" ), TEXT( "Say \"hi\", it's\ttabbed\r\nand\\slashed" ) );
+	StringTable->SetMetaData( TEXT( "Hello_World" ), TEXT( "Comment" ), TEXT( "A \"greeting\"" ) );
+	StringTable->SetMetaData( TEXT( "Hello_World" ), TEXT( "Primary" ), TEXT( "Hello" ) );
+	StringTable->SetMetaData( TEXT( "Hello_World" ), TEXT( "Status" ), TEXT( "Modified: Was 'Hi'" ) );
+	StringTable->SetSourceString( TEXT( "No_Meta" ), TEXT( "Caf\u00e9" ) );
+	FStringTableRegistry::Get().UnregisterStringTable( TableID );
+	FStringTableRegistry::Get().RegisterStringTable( TableID, StringTable );
+
+	// What the exporter has always written: every cell escaped, quotes doubled, then quoted
+	auto Escape = []( const FString& Text )
+	{
+		return TEXT( "\"" ) + Text.ReplaceCharWithEscapedChar().Replace( TEXT( "\"" ), TEXT( "\"\"" ) ) + TEXT( "\"" );
+	};
+	FString Expected = TEXT( "Key,SourceString,Comment,Primary,Status\r\n" );
+	StringTable->EnumerateSourceStrings( [&]( const FString& Key, const FString& SourceString )
+	{
+		Expected += Escape( Key ) + TEXT( "," ) + Escape( SourceString );
+		for ( const TCHAR* MetaData : { TEXT( "Comment" ), TEXT( "Primary" ), TEXT( "Status" ) } )
+		{
+			Expected += TEXT( "," ) + Escape( StringTable->GetMetaData( Key, MetaData ) );
+		}
+		Expected += TEXT( "\r\n" );
+		return true;
+	} );
+
+	const FString Filename = FPaths::Combine( FPaths::AutomationTransientDir(), TEXT( "BYGExportStringsTest.csv" ) );
+	const FString OtherFilename = FPaths::Combine( FPaths::AutomationTransientDir(), TEXT( "BYGExportStringsTest2.csv" ) );
+	TestTrue( "exported", UBYGLocalizationStatics::ExportStrings( TableID, Filename ) );
+	TestFalse( "missing table", UBYGLocalizationStatics::ExportStrings( TEXT( "BYGMissingTable" ), OtherFilename ) );
+
+	TArray<uint8> Bytes;
+	FFileHelper::LoadFileToArray( Bytes, *Filename );
+	const FTCHARToUTF8 ExpectedBytes( *Expected );
+	TestTrue( "same bytes", Bytes.Num() == ExpectedBytes.Length() && FMemory::Memcmp( Bytes.GetData(), ExpectedBytes.Get(), Bytes.Num() ) == 0 );
+
+	// Exporting several at once writes the same files
+	TArray<TPair<FName, FString>> TablesAndFilenames;
+	TablesAndFilenames.Emplace( TableID, Filename );
+	TablesAndFilenames.Emplace( TableID, OtherFilename );
+	TestTrue( "exported both", UBYGLocalizationStatics::ExportStrings( TablesAndFilenames ) );
+	TArray<uint8> OtherBytes;
+	FFileHelper::LoadFileToArray( OtherBytes, *OtherFilename );
+	TestTrue( "same parallel bytes", OtherBytes == Bytes );
+
+	FStringTableRegistry::Get().UnregisterStringTable( TableID );
+	IFileManager::Get().Delete( *Filename );
+	IFileManager::Get().Delete( *OtherFilename );
+
+	return true;
+}
+
+
+namespace BYGLocalizationTest
+{
+	// Points the settings at a directory of its own under Content for as long as it's in scope, and puts everything
+	// back afterwards, reloading whatever the project had loaded before
+	struct FScopedLocalizationDirectory
+	{
+		explicit FScopedLocalizationDirectory( const FString& InName )
+			: Name( InName )
+			, Directory( FPaths::Combine( FPaths::ProjectContentDir(), InName ) )
+		{
+			UBYGLocalizationSettings* Settings = UBYGLocalizationSettings::Get();
+			OldPrimaryDirectory = Settings->PrimaryLocalizationDirectory;
+			OldAdditionalDirectories = Settings->AdditionalLocalizationDirectories;
+			OldPrimaryLanguageCode = Settings->PrimaryLanguageCode;
+			OldLanguageCodes = Settings->LanguageCodesInUse;
+			OldCategories = Settings->LocalizationCategories;
+			bOldUseCompiled = Settings->bUseCompiledLocalizations;
+			OldWarmLocaleCacheSize = Settings->WarmLocaleCacheSize;
+			OldWarmLocaleCacheMaxMemoryMB = Settings->WarmLocaleCacheMaxMemoryMB;
+			OldLanguageCode = FBYGLocalizationModule::Get().GetCurrentLanguageCode();
+
+			Settings->PrimaryLocalizationDirectory.Path = TEXT( "/Game/" ) + Name;
+			Settings->AdditionalLocalizationDirectories.Empty();
+			Settings->PrimaryLanguageCode = TEXT( "en" );
+			Settings->LocalizationCategories = { TEXT( "Game" ) };
+			Settings->bUseCompiledLocalizations = false;
+		}
+
+		~FScopedLocalizationDirectory()
+		{
+			UBYGLocalizationSettings* Settings = UBYGLocalizationSettings::Get();
+			Settings->PrimaryLocalizationDirectory = OldPrimaryDirectory;
+			Settings->AdditionalLocalizationDirectories = OldAdditionalDirectories;
+			Settings->PrimaryLanguageCode = OldPrimaryLanguageCode;
+			Settings->LanguageCodesInUse = OldLanguageCodes;
+			Settings->LocalizationCategories = OldCategories;
+			Settings->bUseCompiledLocalizations = bOldUseCompiled;
+			Settings->WarmLocaleCacheSize = OldWarmLocaleCacheSize;
+			Settings->WarmLocaleCacheMaxMemoryMB = OldWarmLocaleCacheMaxMemoryMB;
+			IFileManager::Get().DeleteDirectory( *Directory, false, true );
+
+			FBYGLocalizationModule& Module = FBYGLocalizationModule::Get();
+			Module.GetLocalization()->InvalidateLocalizationCatalog();
+			Module.SetCurrentLanguageCode( OldLanguageCode );
+			Module.ReloadLocalizations();
+		}
+
+		// Writes loc_<Category>_<Code>.csv with NumKeys keys, and returns its path relative to the content directory
+		FString WriteFile( const FString& Category, const FString& Code, int32 NumKeys ) const
+		{
+			FString CSV = TEXT( "Key,SourceString,Comment,Primary,Status\r\n" );
+			for ( int32 i = 0; i < NumKeys; ++i )
+			{
+				CSV += FString::Printf( TEXT( "Key_%d,\"%s text for key %d, which is about this long.\",,,\r\n" ), i, *Code, i );
+			}
+			const FString RelativePath = FPaths::Combine( Name, FString::Printf( TEXT( "loc_%s_%s.csv" ), *Category, *Code ) );
+			FFileHelper::SaveStringToFile( CSV, *FPaths::Combine( FPaths::ProjectContentDir(), RelativePath ), FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM );
+			return RelativePath;
+		}
+
+		const FString Name;
+		const FString Directory;
+		// Only the settings tests change are put back
+		FDirectoryPath OldPrimaryDirectory;
+		TArray<FBYGPath> OldAdditionalDirectories;
+		FString OldPrimaryLanguageCode;
+		TArray<FString> OldLanguageCodes;
+		TArray<FString> OldCategories;
+		bool bOldUseCompiled = false;
+		int32 OldWarmLocaleCacheSize = 0;
+		int32 OldWarmLocaleCacheMaxMemoryMB = 0;
+		FString OldLanguageCode;
+	};
+}
+
+IMPLEMENT_CUSTOM_SIMPLE_AUTOMATION_TEST( FBYGWarmLocaleCacheTest, FFunctionalTestBase, "BYG.Localization.WarmLocaleCache", TestFlags )
+bool FBYGWarmLocaleCacheTest::RunTest( const FString& Parameters )
+{
+	// Big enough that every language is a couple of MB, so the memory limit can be set in whole MB
+	const int32 NumKeys = 20000;
+	const TArray<FString> Codes = { "en", "fr", "de", "es" };
+
+	BYGLocalizationTest::FScopedLocalizationDirectory Scope( TEXT( "BYGWarmLocaleCacheTest" ) );
+	for ( const FString& Code : Codes )
+	{
+		Scope.WriteFile( TEXT( "Game" ), Code, NumKeys );
+	}
+
+	UBYGLocalizationSettings* Settings = UBYGLocalizationSettings::Get();
+	Settings->LanguageCodesInUse = Codes;
+	Settings->WarmLocaleCacheSize = 2;
+	Settings->WarmLocaleCacheMaxMemoryMB = 0;
+
+	FBYGLocalizationModule& Module = FBYGLocalizationModule::Get();
+	Module.GetLocalization()->InvalidateLocalizationCatalog();
+	Module.SetCurrentLanguageCode( "en" );
+	Module.ReloadLocalizations();
+	auto GetCodes = [&Module]() { return FString::Join( Module.GetWarmLocaleCodes(), TEXT( "," ) ); };
+	TestEqual( "reloaded language is kept", GetCodes(), FString( "en" ) );
+	TestEqual( "reloaded text", FText::FromStringTable( TEXT( "Game" ), TEXT( "Key_1" ) ).ToString(), FString( "en text for key 1, which is about this long." ) );
+
+	// Most recently used first
+	TestTrue( "set fr", Module.SetLanguage( "fr" ) );
+	TestTrue( "set de", Module.SetLanguage( "de" ) );
+	TestEqual( "in order of use", GetCodes(), FString( "de,fr,en" ) );
+	const int32 NumHits = Module.GetWarmLocaleStats().NumHits;
+	TestTrue( "set fr again", Module.SetLanguage( "fr" ) );
+	TestEqual( "reused", Module.GetWarmLocaleStats().NumHits, NumHits + 1 );
+	TestEqual( "moved to the front", GetCodes(), FString( "fr,de,en" ) );
+	TestEqual( "reused text", FText::FromStringTable( TEXT( "Game" ), TEXT( "Key_1" ) ).ToString(), FString( "fr text for key 1, which is about this long." ) );
+
+	// Two kept besides the current language, the least recently used goes
+	const int32 NumEvictions = Module.GetWarmLocaleStats().NumEvictions;
+	TestTrue( "set es", Module.SetLanguage( "es" ) );
+	TestEqual( "evicted by count", GetCodes(), FString( "es,fr,de" ) );
+	TestEqual( "eviction counted", Module.GetWarmLocaleStats().NumEvictions, NumEvictions + 1 );
+
+	// Room for two languages but not three
+	const FBYGWarmLocaleStats Stats = Module.GetWarmLocaleStats();
+	const int64 BytesPerLocale = Stats.NumLocales > 0 ? Stats.MemoryBytes / Stats.NumLocales : 0;
+	const int64 MB = 1024 * 1024;
+	TestTrue( "languages are big enough to measure in MB", BytesPerLocale >= 2 * MB );
+	Settings->WarmLocaleCacheSize = 10;
+	Settings->WarmLocaleCacheMaxMemoryMB = (int32)( BytesPerLocale * 5 / 2 / MB );
+	TestTrue( "set fr under a memory limit", Module.SetLanguage( "fr" ) );
+	TestEqual( "evicted by memory", GetCodes(), FString( "fr,es" ) );
+	TestTrue( "under the limit", Module.GetWarmLocaleStats().MemoryBytes <= (int64)Settings->WarmLocaleCacheMaxMemoryMB * MB );
+
+	// The current language is never evicted, however little room there is
+	Settings->WarmLocaleCacheMaxMemoryMB = 1;
+	TestTrue( "set es under a tiny limit", Module.SetLanguage( "es" ) );
+	TestEqual( "only the current language is left", GetCodes(), FString( "es" ) );
+
+	return true;
+}
+
+
+IMPLEMENT_CUSTOM_SIMPLE_AUTOMATION_TEST( FBYGStatusScannerTest, FFunctionalTestBase, "BYG.Localization.StatusScanner", TestFlags )
+bool FBYGStatusScannerTest::RunTest( const FString& Parameters )
+{
+	const UBYGLocalizationSettings* Settings = UBYGLocalizationSettings::Get();
+
+	const FBYGStatusScanner Scanner;
+	auto Classify = [&Scanner]( const FString& Status )
+	{
+		const FTCHARToUTF8 UTF8( *Status, Status.Len() );
+		return (int32)Scanner.Classify( FUtf8StringView( (const UTF8CHAR*)UTF8.Get(), UTF8.Length() ) );
+	};
+
+	// Matched by prefix, ignoring case, the same as GetLocalizationDataFromFile
+	TestEqual( "empty", Classify( "" ), (int32)EBYGLocEntryStatus::None );
+	TestEqual( "new", Classify( Settings->NewStatus ), (int32)EBYGLocEntryStatus::New );
+	TestEqual( "modified", Classify( Settings->ModifiedStatusLeft + "Old text'" ), (int32)EBYGLocEntryStatus::Modified );
+	TestEqual( "deprecated", Classify( Settings->DeprecatedStatus ), (int32)EBYGLocEntryStatus::Deprecated );
+	TestEqual( "other case", Classify( Settings->NewStatus.ToUpper() ), (int32)EBYGLocEntryStatus::New );
+	TestEqual( "text after", Classify( Settings->DeprecatedStatus + " since 1.2" ), (int32)EBYGLocEntryStatus::Deprecated );
+	TestEqual( "text before", Classify( "Not " + Settings->NewStatus ), (int32)EBYGLocEntryStatus::None );
+	TestEqual( "cut short", Classify( Settings->NewStatus.LeftChop( 1 ) ), (int32)EBYGLocEntryStatus::None );
+	TestEqual( "non-ascii", Classify( TEXT( "\u00c9tat" ) ), (int32)EBYGLocEntryStatus::None );
+
+	// Every row the same length, so files can be rewritten without changing size
+	const FString Header = "Key,SourceString,Comment,Primary,Status\r\n";
+	const FString NewRow = "FirstKey,,,," + Settings->NewStatus + "\r\n";
+	const FString PlainRow = "FirstKey,,,," + FString::ChrN( Settings->NewStatus.Len(), TEXT( 'x' ) ) + "\r\n";
+
+	const FString Filename = FPaths::CreateTempFilename( FPlatformProcess::UserTempDir(), TEXT( "BYGLocalizationTest" ), TEXT( ".csv" ) );
+	UBYGLocalization* Loc = new UBYGLocalization();
+	BYGLocStats Stats;
+
+	TestTrue( "write file", FFileHelper::SaveStringToFile( Header + NewRow, *Filename ) );
+	TestTrue( "stats", Loc->GetLocalizationStats( Filename, Stats ) );
+	TestEqual( "new counted", Stats.FindRef( EBYGLocEntryStatus::New ), 1 );
+
+	// A different size is noticed straight away
+	TestTrue( "write longer file", FFileHelper::SaveStringToFile( Header + NewRow + NewRow, *Filename ) );
+	TestTrue( "stats after resize", Loc->GetLocalizationStats( Filename, Stats ) );
+	TestEqual( "new counted again", Stats.FindRef( EBYGLocEntryStatus::New ), 2 );
+
+	// The same size and modification time look unchanged until the cache is cleared
+	const FDateTime TimeStamp = IFileManager::Get().GetTimeStamp( *Filename );
+	TestTrue( "rewrite file", FFileHelper::SaveStringToFile( Header + NewRow + PlainRow, *Filename ) );
+	IFileManager::Get().SetTimeStamp( *Filename, TimeStamp );
+	TestTrue( "stats from cache", Loc->GetLocalizationStats( Filename, Stats ) );
+	TestEqual( "cached", Stats.FindRef( EBYGLocEntryStatus::New ), 2 );
+
+	FBYGLocalizationModule::Get().ReloadLocalizations();
+	TestTrue( "stats after reload", Loc->GetLocalizationStats( Filename, Stats ) );
+	TestEqual( "reload clears the cache", Stats.FindRef( EBYGLocEntryStatus::New ), 1 );
+	TestEqual( "plain row", Stats.FindRef( EBYGLocEntryStatus::None ), 1 );
+
+	delete Loc;
+	IFileManager::Get().Delete( *Filename );
+
+	return true;
+}
+
+
+IMPLEMENT_CUSTOM_SIMPLE_AUTOMATION_TEST( FBYGLocaleCatalogTest, FFunctionalTestBase, "BYG.Localization.LocaleCatalog", TestFlags )
+bool FBYGLocaleCatalogTest::RunTest( const FString& Parameters )
+{
+	const BYGLocalizationTest::FScopedLocalizationDirectory Directory( TEXT( "BYGLocaleCatalogTest" ) );
+	const FString GameEnPath = Directory.WriteFile( TEXT( "Game" ), TEXT( "en" ), 1 );
+	const FString GameFrPath = Directory.WriteFile( TEXT( "Game" ), TEXT( "fr" ), 1 );
+	const FString UIFrPath = Directory.WriteFile( TEXT( "UI" ), TEXT( "fr" ), 1 );
+
+	UBYGLocalization* Loc = new UBYGLocalization();
+
+	// Lookup
+	FBYGLocaleInfo Info;
+	TestTrue( "find fr Game", Loc->FindLocalization( TEXT( "fr" ), TEXT( "Game" ), Info ) );
+	TestEqual( "locale code", Info.LocaleCode, FString( TEXT( "fr" ) ) );
+	TestEqual( "category", Info.Category, FString( TEXT( "Game" ) ) );
+	TestEqual( "file path", Info.FilePath, GameFrPath );
+	TestFalse( "no de Game", Loc->FindLocalization( TEXT( "de" ), TEXT( "Game" ), Info ) );
+	TestFalse( "no en UI", Loc->FindLocalization( TEXT( "en" ), TEXT( "UI" ), Info ) );
+	TestEqual( "all files", Loc->GetAvailableLocalizations().Num(), 3 );
+	TestEqual( "fr files", Loc->GetAvailableLocalizations( FString( TEXT( "fr" ) ) ).Num(), 2 );
+	TestEqual( "fr UI files", Loc->GetAvailableLocalizations( FString( TEXT( "fr" ) ), FString( TEXT( "UI" ) ) ).Num(), 1 );
+
+	// Files written after the scan aren't found until they're added, lookups don't walk the directory again
+	const FString GameDePath = Directory.WriteFile( TEXT( "Game" ), TEXT( "de" ), 1 );
+	TestFalse( "de not scanned", Loc->FindLocalization( TEXT( "de" ), TEXT( "Game" ), Info ) );
+	Loc->AddLocalizationFile( FPaths::Combine( FPaths::ProjectContentDir(), GameDePath ) );
+	TestTrue( "de added", Loc->FindLocalization( TEXT( "de" ), TEXT( "Game" ), Info ) );
+	TestEqual( "added file path", Info.FilePath, GameDePath );
+
+	// Adding the same file again, files outside the localization directories and files not named like localization
+	// files are all ignored
+	Loc->AddLocalizationFile( FPaths::Combine( FPaths::ProjectContentDir(), GameDePath ) );
+	TestEqual( "added once", Loc->GetAvailableLocalizations( FString( TEXT( "de" ) ) ).Num(), 1 );
+
+	const FString OutsideFilename = FPaths::Combine( FPlatformProcess::UserTempDir(), TEXT( "loc_Game_es.csv" ) );
+	FFileHelper::SaveStringToFile( TEXT( "Key,SourceString\r\n" ), *OutsideFilename );
+	Loc->AddLocalizationFile( OutsideFilename );
+	TestFalse( "outside ignored", Loc->FindLocalization( TEXT( "es" ), TEXT( "Game" ), Info ) );
+	IFileManager::Get().Delete( *OutsideFilename );
+
+	const FString NotesFilename = FPaths::Combine( Directory.Directory, TEXT( "notes_Game_it.csv" ) );
+	FFileHelper::SaveStringToFile( TEXT( "Key,SourceString\r\n" ), *NotesFilename );
+	Loc->AddLocalizationFile( NotesFilename );
+	TestFalse( "wrong prefix ignored", Loc->FindLocalization( TEXT( "it" ), TEXT( "Game" ), Info ) );
+
+	// Deleted files are remembered until the catalog is invalidated
+	IFileManager::Get().Delete( *FPaths::Combine( FPaths::ProjectContentDir(), UIFrPath ) );
+	TestTrue( "deleted still cached", Loc->FindLocalization( TEXT( "fr" ), TEXT( "UI" ), Info ) );
+	Loc->InvalidateLocalizationCatalog();
+	TestFalse( "deleted gone", Loc->FindLocalization( TEXT( "fr" ), TEXT( "UI" ), Info ) );
+	TestTrue( "en still found", Loc->FindLocalization( TEXT( "en" ), TEXT( "Game" ), Info ) );
+	TestEqual( "en file path", Info.FilePath, GameEnPath );
+	TestTrue( "de found by scan", Loc->FindLocalization( TEXT( "de" ), TEXT( "Game" ), Info ) );
+	TestEqual( "all files after rescan", Loc->GetAvailableLocalizations().Num(), 3 );
+
+	// Settings that decide which files match need an invalidate too
+	UBYGLocalizationSettings* Settings = UBYGLocalizationSettings::Get();
+	const FString OldPrefix = Settings->FilenamePrefix;
+	Settings->FilenamePrefix = TEXT( "notes_" );
+	Loc->InvalidateLocalizationCatalog();
+	TestTrue( "new prefix found", Loc->FindLocalization( TEXT( "it" ), TEXT( "Game" ), Info ) );
+	TestFalse( "old prefix gone", Loc->FindLocalization( TEXT( "en" ), TEXT( "Game" ), Info ) );
+	Settings->FilenamePrefix = OldPrefix;
+
+	delete Loc;
+
+	return true;
+}
+
+#endif